@@ -16,14 +16,22 @@
 //#include <opencv2/core.hpp>
 //#include <opencv2/imgcodecs.hpp>
 
+#include <oscp-gpp/async_client.h>
 #include <oscp-gpp/geoposeprotocol.h>
 #include <oscp-gpp/geoposeprotocol_json.h>
 #include <oscp-gpp/base64.h>
+#include <oscp-gpp/compression.h>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fstream>
@@ -60,18 +68,76 @@ namespace ImageUtils {
     }
 }
 
+// Receives the NDJSON stream of a session on its own connection and thread, until the session is closed
+class SessionStream {
+public:
+    SessionStream(const std::string& host, int port, const std::string& sessionId)
+        : client_(host, port), thread_([this, sessionId]() { run(sessionId); }) {}
+
+    ~SessionStream() {
+        thread_.join();
+    }
+
+    // Waits for the next line, returns false on timeout or when the stream ended
+    bool next(json& line, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!available_.wait_for(lock, timeout, [this] { return !lines_.empty() || ended_; }) || lines_.empty()) {
+            return false;
+        }
+        line = json::parse(lines_.front());
+        lines_.pop_front();
+        return true;
+    }
+
+private:
+    void run(const std::string& sessionId) {
+        client_.set_read_timeout(3600); // the stream is quiet between frames
+        std::string pending;
+        auto res = client_.Get("/geopose/sessions/" + sessionId + "/stream", httplib::Headers(), [&](const char* data, size_t size) {
+            pending.append(data, size);
+            size_t lineEnd;
+            while ((lineEnd = pending.find('\n')) != std::string::npos) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    lines_.push_back(pending.substr(0, lineEnd));
+                }
+                available_.notify_one();
+                pending.erase(0, lineEnd + 1);
+            }
+            return true;
+        });
+        if (!res) {
+            std::cout << "Session stream error: " << httplib::to_string(res.error()) << std::endl;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ended_ = true;
+        }
+        available_.notify_all();
+    }
+
+    httplib::Client client_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::string> lines_;
+    bool ended_ = false;
+    std::thread thread_; // last, it starts using the members above right away
+};
+
 int main(int argc, char* argv[]) {
     try {
         std::cout << "Starting GPP Client..." << std::endl;
 
-        if (argc != 6) {
-            throw std::invalid_argument("Usage: oscp-gpp-client <VPS_URL> <VPS_PORT> <IMAGE_PATH> <CAMERA_PARAMS_PATH> <GEOLOCATION_PARAMS_PATH>");
+        if (argc != 6 && argc != 8) {
+            throw std::invalid_argument("Usage: oscp-gpp-client <VPS_URL> <VPS_PORT> <IMAGE_PATH> <CAMERA_PARAMS_PATH> <GEOLOCATION_PARAMS_PATH> [batch|session|async|benchmark <COUNT>]");
         }
         const int argIdxVpsUrl = 1;
         const int argIdxVpsPort = 2;
         const int argIdxImagePath = 3;
         const int argIdxCameraParamsPath = 4;
         const int argIdxGeolocationParamsPath = 5;
+        const int argIdxMode = 6;
+        const int argIdxCount = 7;
 
         std::string myVpsUrl = argv[argIdxVpsUrl];
         std::string myVpsPort = argv[argIdxVpsPort];
@@ -92,8 +158,18 @@ int main(int argc, char* argv[]) {
             throw std::invalid_argument("Could not open file " + myGeolocationParamsPath);
         }
         nlohmann::json myGeolocationParamsJson = json::parse(myGeolocationParamsFile);
+        // batch: the frame is sent COUNT times in one request to /geopose/batch
+        // session: the frame is sent COUNT times as frames of a session
+        // async: the frame is sent COUNT times with POST /geopose without waiting for the responses, from the thread of a render loop
+        // benchmark: COUNT frames are sent one by one with POST /geopose, with a sensors token, then as frames of a session,
+        // comparing the time per frame
+        const std::string myMode = (argc > argIdxMode) ? argv[argIdxMode] : "single";
+        const int myCount = (argc > argIdxCount) ? std::stoi(argv[argIdxCount]) : 1;
+        if (myMode != "single" && myMode != "batch" && myMode != "session" && myMode != "async" && myMode != "benchmark") {
+            throw std::invalid_argument("Unknown mode " + myMode);
+        }
 
-        oscp::CameraModel myCameraModel = oscp::cameraModelFromString(myCameraParamsJson["camera_model"]);
+        oscp::CameraModel myCameraModel = oscp::cameraModelFromString(myCameraParamsJson["camera_model"].get<std::string>());
         // NOTE: camera params: fx, fy, cx, cy, k1, k2, p1, p2
         // Colmap and therefore also GPP ignores the 5th OpenCV coefficient
         const std::vector<float> myCameraModelParams = myCameraParamsJson["camera_params"];
@@ -101,7 +177,8 @@ int main(int argc, char* argv[]) {
         int imgHeight = myCameraParamsJson["camera_height"];
         std::string myCameraSensorId = myCameraParamsJson["camera_id"];
 
-        uint64_t myTimestamp =  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        // Milliseconds since the Unix epoch, the server compares it with its own clock to drop requests that are too old
+        uint64_t myTimestamp =  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
         unsigned int myRequestCounter = 0;
 
         /*
@@ -151,16 +228,26 @@ int main(int argc, char* argv[]) {
         cameraReading.size[1] = imgHeight;
         cameraReading.sensorId = cameraSensor.id;
         cameraReading.timestamp = myTimestamp;
+        cameraReading.privacy = oscp::Privacy(); // explicit privacy per reading for servers that do not support request-level privacy
         oscp::CameraParameters cameraParameters;
         cameraParameters.model = myCameraModel;
-        cameraParameters.modelParams = myCameraModelParams;
+        cameraParameters.modelParams.assign(myCameraModelParams.begin(), myCameraModelParams.end());
         cameraReading.params = cameraParameters;
         geoPoseRequest.sensorReadings.cameraReadings.push_back(cameraReading);
 
+        // Every reading must reference a declared sensor
+        oscp::Sensor geolocationSensor;
+        geolocationSensor.id = "geolocation_01";
+        geolocationSensor.type = oscp::SensorType::GEOLOCATION;
+        geoPoseRequest.sensors.push_back(geolocationSensor);
+
         oscp::GeolocationReading geolocationReading;
+        geolocationReading.sensorId = geolocationSensor.id;
+        geolocationReading.timestamp = myTimestamp;
         geolocationReading.latitude = myGeolocationParamsJson["lat"];
         geolocationReading.longitude = myGeolocationParamsJson["lon"];
         geolocationReading.altitude = myGeolocationParamsJson["h"];
+        geolocationReading.privacy = oscp::Privacy();
         geoPoseRequest.sensorReadings.geolocationReadings.push_back(geolocationReading);
 
         nlohmann::json requestDataJson = geoPoseRequest; // automatic conversion
@@ -173,11 +260,279 @@ int main(int argc, char* argv[]) {
 
         httplib::Client client(myVpsUrl, std::stoi(myVpsPort));
 
+        // A pose that arrives later than this is useless for the client, the server drops the request instead of localizing it
+        const std::string myTimeoutMs = "2000";
         const httplib::Headers headers = {
             {"Content-Type", "application/json"},
-            {"Accept", "application/vnd.oscp+json;version=2.0;"}
+            {"Accept", "application/vnd.oscp+json;version=2.0;"},
+            {"X-OSCP-Timeout-Ms", myTimeoutMs}
+        };
+
+        // Bodies are compressed when the heuristic expects a gain, e.g. IMU-heavy requests and batches but not a single JPEG.
+        // zstd is preferred, it is faster and cpp-httplib servers built without zlib reject gzip bodies.
+        oscp::ContentCoding myRequestCoding = oscp::ContentCoding::IDENTITY;
+        for (oscp::ContentCoding coding : {oscp::ContentCoding::GZIP, oscp::ContentCoding::ZSTD}) {
+            if (oscp::isContentCodingSupported(coding)) {
+                myRequestCoding = coding;
+            }
+        }
+        // Returns the body to send, compressed with its Content-Encoding added to the headers if worthwhile
+        auto encodeBody = [&](const std::string& body, httplib::Headers& bodyHeaders) {
+            const oscp::ContentCoding coding = oscp::chooseContentCoding(body, "application/json", myRequestCoding);
+            if (coding == oscp::ContentCoding::IDENTITY) {
+                return body;
+            }
+            bodyHeaders.emplace("Content-Encoding", std::string(oscp::toString(coding)));
+            return oscp::compressBody(body, coding);
+        };
+        // A server that cannot decompress the body answers 415, the client then sends all further bodies as they are
+        auto postBody = [&](const std::string& path, const std::string& body) {
+            httplib::Headers bodyHeaders = headers;
+            const std::string encodedBody = encodeBody(body, bodyHeaders);
+            auto res = client.Post(path, bodyHeaders, encodedBody, "application/json");
+            if (res && res->status == 415 && bodyHeaders.count("Content-Encoding") > 0) {
+                std::cout << "The server does not accept " << bodyHeaders.find("Content-Encoding")->second
+                          << " request bodies, sending them uncompressed" << std::endl;
+                myRequestCoding = oscp::ContentCoding::IDENTITY;
+                res = client.Post(path, headers, body, "application/json");
+            }
+            return res;
+        };
+
+        if (myMode == "batch") {
+            // Copies of the request with their own ids, as a multi-camera rig or a reprocessing job would send them
+            nlohmann::json batchJson = nlohmann::json::array();
+            for (int i = 0; i < myCount; i++) {
+                oscp::GeoPoseRequest batchRequest = geoPoseRequest;
+                batchRequest.id = uuids::to_string(gen());
+                batchRequest.sensorReadings.cameraReadings[0].sequenceNumber = myRequestCounter + i;
+                batchJson.push_back(batchRequest);
+            }
+
+            // The responses are streamed as one JSON object per line, in the order they complete
+            std::string pending;
+            int received = 0;
+            httplib::Request batchRequest;
+            batchRequest.method = "POST";
+            batchRequest.path = "/geopose/batch";
+            batchRequest.headers = headers;
+            batchRequest.body = encodeBody(batchJson.dump(), batchRequest.headers);
+            batchRequest.content_receiver = [&](const char* data, size_t size, uint64_t, uint64_t) {
+                pending.append(data, size);
+                size_t lineEnd;
+                while ((lineEnd = pending.find('\n')) != std::string::npos) {
+                    json lineJson = json::parse(pending.substr(0, lineEnd));
+                    pending.erase(0, lineEnd + 1);
+                    received++;
+                    if (lineJson.contains("error")) {
+                        std::cout << "Batch request " << lineJson["index"] << " failed: " << lineJson["error"] << std::endl;
+                    } else {
+                        oscp::GeoPoseResponse geoPoseResponse = lineJson.get<oscp::GeoPoseResponse>();
+                        std::cout << "Batch response " << geoPoseResponse.id << ": " << std::setprecision(10)
+                                  << geoPoseResponse.geopose.position.lat << ", " << geoPoseResponse.geopose.position.lon << std::endl;
+                    }
+                }
+                return true;
+            };
+            if (auto res = client.send(batchRequest)) {
+                if (res->status == 200) {
+                    std::cout << "Received " << received << " of " << myCount << " batch responses" << std::endl;
+                } else {
+                    std::cout << "HTTP status: " << httplib::detail::status_message(res->status) << std::endl;
+                    std::cout << pending << std::endl;
+                }
+            } else {
+                auto err = res.error();
+                std::cout << "HTTP error: " << httplib::to_string(err) << std::endl;
+            }
+            return 0;
+        }
+
+        if (myMode == "async") {
+            // All frames are in flight at once, the loop polls for their poses between the frames it would render
+            oscp::AsyncClientPolicy asyncPolicy;
+            asyncPolicy.timeoutMs = std::stoi(myTimeoutMs);
+            oscp::AsyncClient asyncClient(myVpsUrl, std::stoi(myVpsPort), asyncPolicy);
+            int received = 0;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (int i = 0; i < myCount; i++) {
+                oscp::GeoPoseRequest frameRequest = geoPoseRequest;
+                frameRequest.id = uuids::to_string(gen());
+                frameRequest.sensorReadings.cameraReadings[0].sequenceNumber = myRequestCounter + i;
+                asyncClient.localize(frameRequest, [&received, i](oscp::LocalizeResult&& result) {
+                    if (!result.response) {
+                        std::cout << "Frame " << i << " failed: " << toString(result.status) << " " << result.httpStatus << " " << result.error << std::endl;
+                        return;
+                    }
+                    received++;
+                    std::cout << "Async response " << result.response->id << ": " << std::setprecision(10)
+                              << result.response->geopose.position.lat << ", " << result.response->geopose.position.lon << std::endl;
+                });
+            }
+            int renderedFrames = 0;
+            while (asyncClient.pending() > 0) {
+                asyncClient.poll(16); // about 60 frames per second
+                renderedFrames++;
+            }
+            const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Received " << received << " of " << myCount << " async responses in " << elapsedMs << " ms, over "
+                      << renderedFrames << " render loop iterations and " << asyncClient.stats().connections << " connections" << std::endl;
+            return 0;
+        }
+
+        // The parts of the request that stay the same are sent once when the session is opened
+        oscp::GeoPoseSession session;
+        session.sensors = geoPoseRequest.sensors;
+        session.privacy = oscp::Privacy();
+        oscp::SessionCamera sessionCamera;
+        sessionCamera.sensorId = cameraSensor.id;
+        sessionCamera.params = cameraParameters;
+        session.cameras.push_back(sessionCamera);
+        const std::string sessionDataString = nlohmann::json(session).dump();
+
+        // A frame carries only the readings, inheriting sensors, privacy and camera params from the session
+        nlohmann::json frameJson = requestDataJson;
+        frameJson.erase("sensors");
+        for (nlohmann::json& reading : frameJson["sensorReadings"]["cameraReadings"]) {
+            reading.erase("params");
+            reading.erase("privacy");
+        }
+        for (nlohmann::json& reading : frameJson["sensorReadings"]["geolocationReadings"]) {
+            reading.erase("privacy");
+        }
+
+        auto openSession = [&]() {
+            auto res = postBody("/geopose/sessions", sessionDataString);
+            if (!res) {
+                throw std::runtime_error("HTTP error: " + httplib::to_string(res.error()));
+            }
+            if (res->status != 201) {
+                throw std::runtime_error("Could not open a session: " + res->body);
+            }
+            return json::parse(res->body).at("sessionId").get<std::string>();
+        };
+
+        // Sends the frames one by one, waiting for the response of each before sending the next
+        auto sendFrames = [&](const std::string& sessionId, SessionStream& stream, int count, bool print) {
+            const std::string framePath = "/geopose/sessions/" + sessionId + "/frames";
+            int received = 0;
+            for (int i = 0; i < count; i++) {
+                frameJson["id"] = uuids::to_string(gen());
+                frameJson["sensorReadings"]["cameraReadings"][0]["sequenceNumber"] = myRequestCounter + i;
+                auto res = postBody(framePath, frameJson.dump());
+                if (!res || res->status != 202) {
+                    std::cout << "Frame " << i << " was not accepted: " << (res ? res->body : httplib::to_string(res.error())) << std::endl;
+                    continue;
+                }
+                json lineJson;
+                if (!stream.next(lineJson, std::chrono::seconds(10))) {
+                    std::cout << "No response to frame " << i << std::endl;
+                    break;
+                }
+                received++;
+                if (!print) {
+                    continue;
+                }
+                if (lineJson.contains("error")) {
+                    std::cout << "Frame " << lineJson["id"] << " failed: " << lineJson["error"] << std::endl;
+                } else {
+                    oscp::GeoPoseResponse geoPoseResponse = lineJson.get<oscp::GeoPoseResponse>();
+                    std::cout << "Session response " << geoPoseResponse.id << ": " << std::setprecision(10)
+                              << geoPoseResponse.geopose.position.lat << ", " << geoPoseResponse.geopose.position.lon << std::endl;
+                }
+            }
+            return received;
         };
-        if (auto res = client.Post("/geopose", headers, requestDataString, "application/json")) {
+
+        auto closeSession = [&](const std::string& sessionId) {
+            client.Delete("/geopose/sessions/" + sessionId);
+        };
+
+        if (myMode == "session") {
+            client.set_keep_alive(true);
+            const std::string sessionId = openSession();
+            std::cout << "Session: " << sessionId << std::endl;
+            SessionStream stream(myVpsUrl, std::stoi(myVpsPort), sessionId);
+            const int received = sendFrames(sessionId, stream, myCount, true);
+            std::cout << "Received " << received << " of " << myCount << " session responses" << std::endl;
+            closeSession(sessionId);
+            return 0;
+        }
+
+        if (myMode == "benchmark") {
+            // Both paths reuse one connection, so the difference is the per-frame request handling
+            client.set_keep_alive(true);
+            using Clock = std::chrono::steady_clock;
+            auto report = [&](const std::string& path, Clock::duration elapsed, int frames, size_t bytesPerFrame) {
+                const double usPerFrame = std::chrono::duration<double, std::micro>(elapsed).count() / std::max(frames, 1);
+                std::cout << std::left << std::setw(10) << path << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(12) << usPerFrame << " us/frame"
+                          << std::setw(12) << 1e6 / usPerFrame << " frames/s"
+                          << std::setw(12) << bytesPerFrame << " bytes/frame" << std::endl;
+            };
+
+            // Sends the request COUNT times with new ids, returns the number of successful responses
+            std::string sensorsToken;
+            auto postFrames = [&](nlohmann::json& postJson, size_t& bytesPerFrame) {
+                int frames = 0;
+                for (int i = 0; i < myCount; i++) {
+                    postJson["id"] = uuids::to_string(gen());
+                    postJson["sensorReadings"]["cameraReadings"][0]["sequenceNumber"] = myRequestCounter + i;
+                    const std::string body = postJson.dump();
+                    bytesPerFrame = body.size();
+                    auto res = postBody("/geopose", body);
+                    if (res && res->status == 200) {
+                        frames++;
+                        if (res->has_header("X-OSCP-Sensors-Token")) {
+                            sensorsToken = res->get_header_value("X-OSCP-Sensors-Token");
+                        }
+                    }
+                }
+                return frames;
+            };
+
+            nlohmann::json postJson = requestDataJson;
+            size_t postBytes = 0;
+            const Clock::time_point postStart = Clock::now();
+            const int postCount = postFrames(postJson, postBytes);
+            const Clock::duration postElapsed = Clock::now() - postStart;
+
+            // The same requests with the sensors and camera params replaced by the token the server acknowledged them with
+            nlohmann::json tokenJson = requestDataJson;
+            tokenJson.erase("sensors");
+            tokenJson["sensorsToken"] = sensorsToken;
+            for (nlohmann::json& reading : tokenJson["sensorReadings"]["cameraReadings"]) {
+                reading.erase("params");
+            }
+            size_t tokenBytes = 0;
+            int tokenCount = 0;
+            Clock::duration tokenElapsed{};
+            if (!sensorsToken.empty()) {
+                const Clock::time_point tokenStart = Clock::now();
+                tokenCount = postFrames(tokenJson, tokenBytes);
+                tokenElapsed = Clock::now() - tokenStart;
+            }
+
+            const std::string sessionId = openSession();
+            int sessionFrames = 0;
+            Clock::duration sessionElapsed;
+            {
+                SessionStream stream(myVpsUrl, std::stoi(myVpsPort), sessionId);
+                const Clock::time_point sessionStart = Clock::now();
+                sessionFrames = sendFrames(sessionId, stream, myCount, false);
+                sessionElapsed = Clock::now() - sessionStart;
+                closeSession(sessionId);
+            }
+
+            std::cout << "Frames: " << postCount << " with POST /geopose, " << tokenCount << " with a sensors token, "
+                      << sessionFrames << " in a session" << std::endl;
+            report("POST", postElapsed, postCount, postBytes);
+            report("token", tokenElapsed, tokenCount, tokenBytes);
+            report("session", sessionElapsed, sessionFrames, frameJson.dump().size());
+            return 0;
+        }
+
+        if (auto res = postBody("/geopose", requestDataString)) {
             if (res->status == 200) {
                 std::string responseDataString = res->body;
                 json responseDataJson = json::parse(responseDataString);
@@ -188,6 +543,11 @@ int main(int argc, char* argv[]) {
                 oscp::GeoPoseResponse geoPoseResponse = responseDataJson.get<oscp::GeoPoseResponse>();
                 oscp::GeoPose geoPose = geoPoseResponse.geopose;
 
+                if (res->has_header("X-OSCP-Sensors-Token")) {
+                    // Further requests could send this instead of their sensors and camera params
+                    std::cout << "Sensors token: " << res->get_header_value("X-OSCP-Sensors-Token") << std::endl;
+                }
+
                 std::cout << "Successful VPS localization!" << std::endl << std::setprecision(10)
                                     << "  " << geoPose.quaternion.x
                                     << ", " << geoPose.quaternion.y
@@ -11,42 +11,307 @@
 // #define CPPHTTPLIB_OPENSSL_SUPPORT 1 // TODO: enable SSL here
 #include <httplib.h>
 
+#include <oscp-gpp/admission_control.h>
+#include <oscp-gpp/camera_cache.h>
+#include <oscp-gpp/compression.h>
+#include <oscp-gpp/config_reloader.h>
+#include <oscp-gpp/content_negotiation.h>
 #include <oscp-gpp/geoposeprotocol.h>
 #include <oscp-gpp/geoposeprotocol_json.h>
+#include <oscp-gpp/geopose_json.h>
+#include <oscp-gpp/map_shard_index.h>
+#include <oscp-gpp/pose_tracker.h>
+#include <oscp-gpp/request_coalescer.h>
+#include <oscp-gpp/request_trace.h>
+#include <oscp-gpp/response_cache.h>
+#include <oscp-gpp/sensor_registry.h>
+#include <oscp-gpp/session_registry.h>
+#include <oscp-gpp/worker_pool.h>
+#include <oscp-gpp/worker_processes.h>
 
-bool verify_version_header(const httplib::Headers& headers) {
-    if (headers.find("Accept") == headers.end()) {
-        throw std::invalid_argument("There is no Accept header in the request");
-    }
-    for (auto itr = headers.begin(); itr != headers.end(); itr++){
-        if ((itr->first).compare("Accept") == 0) {
-            std::string acceptHeader = itr -> second;
-            std::cout << "Accept header: " << acceptHeader << std::endl;
-            if (acceptHeader.find("application/vnd.oscp+json") == std::string::npos) {
-                throw std::invalid_argument("The Accept header is expected to contain application/vnd.oscp+json");
-            }
-            if (acceptHeader.find("version=") == std::string::npos) {
-                throw std::invalid_argument("The Accept header is expected to contain version=");
-            }
-            int versionMajor = 0;
-            int versionMinor = 0;
-            size_t vStrBegin = acceptHeader.find("version=") + std::string("version=").length();
-            size_t vStrEnd = acceptHeader.find(";", vStrBegin);
-            std::string vStr = acceptHeader.substr(vStrBegin, vStrEnd);
-            if (vStr.find(".") == std::string::npos) {
-                versionMajor = std::stoi(vStr); // there is no minor
-            }
-            std::string vMajorStr = vStr.substr(0, vStr.find("."));
-            std::string vMinorStr = vStr.substr(vStr.find(".") + 1, vStr.find(";"));
-            versionMajor = std::stoi(vMajorStr);
-            versionMinor = std::stoi(vMinorStr);
-            std::cout << "Version: " << versionMajor << " " << versionMinor << std::endl;
-            if (versionMajor != 2 && versionMinor != 0) {
-                throw std::invalid_argument("This server supports only GPP version=2.0");
-            }
+#include <condition_variable>
+#include <deque>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+// Writes a GeoPoseResponse in one of the representations the server speaks
+using ResponseWriter = std::string (*)(const oscp::GeoPoseResponse&);
+using Negotiator = oscp::ContentNegotiator<ResponseWriter>;
+
+std::string write_json_response(const oscp::GeoPoseResponse& response) {
+    return nlohmann::json(response).dump();
+}
+
+// The value of a header as a view into the request, empty if there is no such header
+std::string_view header_value(const httplib::Headers& headers, const char* key) {
+    auto itr = headers.find(key);
+    return itr == headers.end() ? std::string_view() : std::string_view(itr->second);
+}
+
+// The codings the server decompresses, sent with 415 so a client knows what to retry with, e.g. "zstd, gzip"
+std::string supported_content_codings() {
+    std::string codings;
+    for (oscp::ContentCoding coding : {oscp::ContentCoding::ZSTD, oscp::ContentCoding::GZIP}) {
+        if (oscp::isContentCodingSupported(coding)) {
+            codings += (codings.empty() ? "" : ", ") + std::string(oscp::toString(coding));
+        }
+    }
+    return codings.empty() ? "identity" : codings;
+}
+
+// Reads the body of a request as it arrives and decompresses it on the fly if it has a Content-Encoding, so a compressed body
+// is never held in full and a decompression bomb stops at maxBodyBytes. Without any exception on the way, answers 415
+// (with the supported codings in Accept-Encoding), 413 or 400 and returns false if the body cannot be read.
+bool read_body(const httplib::Request& req, const httplib::ContentReader& content_reader, size_t maxBodyBytes,
+    httplib::Response& res, std::string& body)
+{
+    const oscp::ContentCoding coding = oscp::parseContentCoding(header_value(req.headers, "Content-Encoding"));
+    if (coding == oscp::ContentCoding::IDENTITY) {
+        content_reader([&body](const char* data, size_t size) {
+            body.append(data, size);
+            return true;
+        });
+        return true;
+    }
+
+    oscp::DecompressionStatus status = oscp::DecompressionStatus::UNSUPPORTED_CODING;
+    if (oscp::isContentCodingSupported(coding)) {
+        oscp::Decompressor decompressor(coding, maxBodyBytes);
+        status = oscp::DecompressionStatus::OK;
+        content_reader([&](const char* data, size_t size) {
+            status = decompressor.write(data, size, body);
+            return status == oscp::DecompressionStatus::OK; // stops reading at the first error
+        });
+        if (status == oscp::DecompressionStatus::OK) {
+            status = decompressor.finish();
         }
     }
-    return true;
+    if (status == oscp::DecompressionStatus::OK) {
+        return true;
+    }
+
+    nlohmann::json errorJson;
+    switch (status) {
+    case oscp::DecompressionStatus::TOO_LARGE:
+        errorJson = {{"error", "The decompressed body exceeds " + std::to_string(maxBodyBytes) + " bytes"}};
+        res.status = 413; // payload too large
+        break;
+    case oscp::DecompressionStatus::UNSUPPORTED_CODING:
+        errorJson = {{"error", "The Content-Encoding of the request is not supported"}};
+        res.set_header("Accept-Encoding", supported_content_codings());
+        res.status = 415; // unsupported media type
+        break;
+    default:
+        errorJson = {{"error", "The body is not valid " + std::string(oscp::toString(coding)) + " data"}};
+        res.status = 400; // bad request
+        break;
+    }
+    errorJson["code"] = oscp::toString(status);
+    res.set_content(errorJson.dump(), "application/json");
+    return false;
+}
+
+// Traces a request if the client asks for the timing of its stages (X-OSCP-Debug: timing) or the server keeps traces
+// for export (a TraceLog with maxTraces > 0), returns nullptr otherwise. The trace goes to the log when the last holder
+// releases it, e.g. the last worker of a batch.
+std::shared_ptr<oscp::RequestTrace> start_trace(const httplib::Request& req, oscp::TraceLog& traceLog, bool logTraces, const char* label) {
+    if (!logTraces && header_value(req.headers, "X-OSCP-Debug").find("timing") == std::string_view::npos) {
+        return nullptr;
+    }
+    return std::shared_ptr<oscp::RequestTrace>(new oscp::RequestTrace(label), [&traceLog](oscp::RequestTrace* trace) {
+        traceLog.add(*trace);
+        delete trace;
+    });
+}
+
+// Times a handler as the "request" span of its trace and answers with the Server-Timing header if the client asked for it,
+// when the handler returns or, for handlers that hand the request to workers, before that with respond()
+class HandlerTrace {
+public:
+    HandlerTrace(std::shared_ptr<oscp::RequestTrace> trace, const httplib::Request& req, httplib::Response& res)
+        : trace_(std::move(trace)), res_(res)
+    {
+        if (trace_) {
+            span_ = trace_->begin("request");
+            serverTiming_ = header_value(req.headers, "X-OSCP-Debug").find("timing") != std::string_view::npos;
+        }
+    }
+
+    ~HandlerTrace() {
+        respond();
+    }
+
+    HandlerTrace(const HandlerTrace&) = delete;
+    HandlerTrace& operator=(const HandlerTrace&) = delete;
+
+    // Ends the "request" span and sets the Server-Timing header, the spans added later are only exported
+    void respond() {
+        if (!trace_ || responded_) {
+            return;
+        }
+        responded_ = true;
+        trace_->end(span_);
+        if (serverTiming_) {
+            res_.set_header("Server-Timing", trace_->serverTiming());
+        }
+    }
+
+    oscp::RequestTrace* get() const {
+        return trace_.get();
+    }
+
+    const std::shared_ptr<oscp::RequestTrace>& shared() const {
+        return trace_;
+    }
+
+private:
+    std::shared_ptr<oscp::RequestTrace> trace_;
+    httplib::Response& res_;
+    size_t span_ = 0;
+    bool serverTiming_ = false;
+    bool responded_ = false;
+};
+
+// Selects the representation of the response from the Accept header, after checking that the body is in a
+// representation the server reads (Content-Type). Without any exception on the way, answers 415 or 406 with
+// the supported media types and returns an empty selection if either fails.
+Negotiator::Selection negotiate(const Negotiator& negotiator, const httplib::Request& req, httplib::Response& res) {
+    Negotiator::Selection selection;
+    int status = 0;
+    if (!negotiator.selectRequest(header_value(req.headers, "Content-Type"))) {
+        status = 415; // unsupported media type
+    } else if (!(selection = negotiator.selectResponse(header_value(req.headers, "Accept")))) {
+        status = 406; // not acceptable
+    } else {
+        return selection;
+    }
+    nlohmann::json supportedJson = nlohmann::json::array();
+    for (const oscp::Representation& representation : negotiator.representations()) {
+        supportedJson.push_back(representation.contentType);
+    }
+    const char* message = status == 415 ? "The Content-Type of the request is not supported" : "None of the media types of the Accept header is supported";
+    nlohmann::json errorJson = {{"error", message}, {"supported", supportedJson}};
+    res.set_content(errorJson.dump(), "application/json");
+    res.status = status;
+    return selection;
+}
+
+// Answers an invalid request without any exception on the way: {"error", "code", "path"},
+// with 412 if the sensorsToken is unknown (the client resends its sensors) and 400 otherwise
+void set_parse_error(httplib::Response& res, const oscp::ParseError& error) {
+    nlohmann::json errorJson = {{"error", error.message}, {"code", oscp::toString(error.code)}, {"path", error.path}};
+    res.set_content(errorJson.dump(), "application/json");
+    res.status = error.code == oscp::ParseErrorCode::UNKNOWN_SENSORS_TOKEN ? 412 : 400;
+}
+
+// Thrown if no map shard covers the geolocation of a request, answered with 404
+class NoMapCoverageError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Thrown if a request is dropped before one of its stages, answered with 503 if the server is overloaded and 504 otherwise
+class RequestDroppedError : public std::runtime_error {
+public:
+    RequestDroppedError(oscp::DropReason reason, const char* stage)
+        : std::runtime_error("Request dropped before " + std::string(stage) + ": " + std::string(oscp::toString(reason))),
+          reason_(reason), stage_(stage)
+    {
+    }
+
+    oscp::DropReason reason() const noexcept {
+        return reason_;
+    }
+
+    const char* stage() const noexcept {
+        return stage_;
+    }
+
+    int status() const noexcept {
+        return reason_ == oscp::DropReason::OVERLOADED ? 503 : 504; // service unavailable, gateway timeout
+    }
+
+private:
+    oscp::DropReason reason_;
+    const char* stage_;
+};
+
+// Answers a dropped request with {"error", "code", "stage"}, and asks the client to back off if the server is overloaded
+void set_drop_error(httplib::Response& res, const RequestDroppedError& error) {
+    nlohmann::json errorJson = {{"error", error.what()}, {"code", oscp::toString(error.reason())}, {"stage", error.stage()}};
+    res.set_content(errorJson.dump(), "application/json");
+    res.status = error.status();
+    if (error.reason() == oscp::DropReason::OVERLOADED) {
+        res.set_header("Retry-After", "1");
+    }
+}
+
+// The deadline of a request from its X-OSCP-Timeout-Ms header, in milliseconds from the arrival of the request.
+// Returns the error to answer with set_parse_error() if the header is malformed.
+std::optional<oscp::ParseError> request_budget(const httplib::Request& req, oscp::RequestBudget::Clock::time_point arrival,
+    oscp::RequestBudget& budget) {
+    const std::string_view timeout = header_value(req.headers, "X-OSCP-Timeout-Ms");
+    if (!timeout.empty()) {
+        std::time_t timeoutMs = 0;
+        if (!oscp::parseTimeoutMs(timeout, timeoutMs)) {
+            return oscp::ParseError(oscp::ParseErrorCode::INVALID_VALUE, "", "X-OSCP-Timeout-Ms must be a number of milliseconds");
+        }
+        budget.setTimeout(timeoutMs, arrival);
+    }
+    return std::nullopt;
+}
+
+// The part of the config that may change while the server runs. Each version is parsed and validated once, and requests
+// read it as plain fields of the snapshot they started with. The rest of the config sizes caches, pools and sockets at startup.
+struct ServerConfig {
+    explicit ServerConfig(oscp::MapShardIndex index) : shardIndex(std::move(index)) {}
+
+    oscp::GeoPose geopose; // the answer without shards
+    oscp::MapShardIndex shardIndex;
+    std::vector<oscp::GeoPose> shardGeoPoses; // the answer of each shard of shardIndex
+    oscp::GeoPoseAccuracy accuracy; // reported with every full localization, the fast path inflates it
+    bool fastPathEnabled = false;
+    bool responseCacheEnabled = false;
+    size_t batchMaxRequests = 64;
+    size_t maxDecompressedBytes = size_t(64) << 20;
+    std::time_t maxRequestAgeMs = 0;
+};
+
+// Throws if the config is invalid, e.g. a shard without bounds or no geopose to answer with
+std::shared_ptr<const ServerConfig> parse_server_config(const nlohmann::json& config) {
+    // Optional map shards: requests are routed to the shard covering their geolocation.
+    // In this demo every shard answers with a fixed pose, by default the one of the whole config.
+    std::vector<oscp::MapShard> shards;
+    std::vector<oscp::GeoPose> shardGeoPoses;
+    for (const nlohmann::json& shardJson : config.value("shards", nlohmann::json::array())) {
+        oscp::MapShard shard;
+        shard.id = shardJson.at("id");
+        const nlohmann::json& boundsJson = shardJson.at("bounds");
+        shard.bounds.minLat = boundsJson.at("minLat");
+        shard.bounds.minLon = boundsJson.at("minLon");
+        shard.bounds.maxLat = boundsJson.at("maxLat");
+        shard.bounds.maxLon = boundsJson.at("maxLon");
+        shards.push_back(shard);
+        shardGeoPoses.push_back((shardJson.contains("geopose") ? shardJson : config).at("geopose").get<oscp::GeoPose>());
+    }
+    auto serverConfig = std::make_shared<ServerConfig>(oscp::MapShardIndex(std::move(shards),
+        config.value("shardCellSizeDegrees", oscp::MapShardIndex::defaultCellSizeDegrees)));
+    serverConfig->shardGeoPoses = std::move(shardGeoPoses);
+    if (serverConfig->shardIndex.empty()) {
+        serverConfig->geopose = config.at("geopose").get<oscp::GeoPose>();
+    }
+
+    const nlohmann::json accuracyJson = config.value("accuracy", nlohmann::json::object());
+    serverConfig->accuracy.position = accuracyJson.value("position", serverConfig->accuracy.position);
+    serverConfig->accuracy.orientation = accuracyJson.value("orientation", serverConfig->accuracy.orientation);
+    serverConfig->fastPathEnabled = config.value("fastPath", nlohmann::json::object()).value("enabled", false);
+    serverConfig->responseCacheEnabled = config.value("responseCache", nlohmann::json::object()).value("enabled", false);
+    serverConfig->batchMaxRequests = config.value("batch", nlohmann::json::object()).value("maxRequests", serverConfig->batchMaxRequests);
+    serverConfig->maxDecompressedBytes = config.value("compression", nlohmann::json::object()).value("maxDecompressedBytes", serverConfig->maxDecompressedBytes);
+    serverConfig->maxRequestAgeMs = config.value("admission", nlohmann::json::object()).value("maxRequestAgeMs", serverConfig->maxRequestAgeMs);
+    return serverConfig;
 }
 
 int main(int argc, char* argv[])
@@ -59,65 +324,785 @@ int main(int argc, char* argv[])
         }
 
         std::string myConfigPath = argv[1];
+        const std::filesystem::file_time_type myConfigVersion = oscp::ConfigReloader::version(myConfigPath); // before reading, a change meanwhile is reloaded
         std::ifstream myConfigFile(myConfigPath);
         if (!myConfigFile.is_open()) {
             throw std::invalid_argument("Could not open file " + myConfigPath);
         }
-        nlohmann::json myConfig = json::parse(myConfigFile);
+        const nlohmann::json myConfig = json::parse(myConfigFile);
+        oscp::AtomicSnapshot<ServerConfig> myServerConfig(parse_server_config(myConfig));
+        const std::shared_ptr<const ServerConfig> myStartupConfig = myServerConfig.load();
+        std::cout << "Map shards: " << myStartupConfig->shardIndex.shards().size() << std::endl;
+
+        // Optional worker processes that accept on the same port (SO_REUSEPORT), each with its own heap and threads.
+        // They are forked here, so the config and the map index above are loaded once and shared copy-on-write,
+        // while everything below (caches, sessions, admission control, thread pools) is per worker.
+        const nlohmann::json myWorkersConfig = myConfig.value("workers", nlohmann::json::object());
+        oscp::SupervisorPolicy mySupervisorPolicy;
+        mySupervisorPolicy.workers = myWorkersConfig.value("count", mySupervisorPolicy.workers);
+        mySupervisorPolicy.restartDelayMs = myWorkersConfig.value("restartDelayMs", mySupervisorPolicy.restartDelayMs);
+        mySupervisorPolicy.maxRestartDelayMs = myWorkersConfig.value("maxRestartDelayMs", mySupervisorPolicy.maxRestartDelayMs);
+        oscp::CpuPinning myCpuPinning = oscp::CpuPinning::NONE;
+        const std::string myCpuPinningName = myWorkersConfig.value("pinning", std::string(oscp::toString(myCpuPinning)));
+        if (!oscp::tryParseCpuPinning(myCpuPinningName, myCpuPinning)) {
+            throw std::invalid_argument("Unknown workers.pinning " + myCpuPinningName);
+        }
+        const bool myReusePort = mySupervisorPolicy.workers > 1;
+        if (myReusePort) {
+            const std::vector<std::vector<int>> myCpuSets = oscp::workerCpuSets(mySupervisorPolicy.workers, myCpuPinning);
+            oscp::WorkerSupervisor mySupervisor(mySupervisorPolicy);
+            std::cout << "Worker processes: " << mySupervisorPolicy.workers << ", pinned to " << oscp::toString(myCpuPinning) << std::endl;
+            const std::optional<size_t> myWorkerIndex = mySupervisor.run();
+            if (!myWorkerIndex) {
+                const oscp::SupervisorStats stats = mySupervisor.stats();
+                std::cout << "Supervisor stopped after " << stats.started << " worker starts, " << stats.crashed << " crashes" << std::endl;
+                return 0;
+            }
+            if (!oscp::pinToCpus(myCpuSets[*myWorkerIndex])) {
+                std::cout << "Worker " << *myWorkerIndex << " could not be pinned" << std::endl;
+            }
+            std::cout << "Worker " << *myWorkerIndex << " started" << std::endl;
+        }
+
+        // Sessions need all their requests on the worker that opened them, which SO_REUSEPORT does not guarantee,
+        // so with several workers there are no sessions, and no fast path, which only answers their frames
+        const bool mySessionsEnabled = !myReusePort;
+        if (!mySessionsEnabled) {
+            std::cout << "Sessions and the fast path are disabled with workers.count above 1" << std::endl;
+        }
+
+        // Optional fast path: answer the frames of a session from its last pose, propagated with their gyroscope readings
+        const nlohmann::json myFastPathConfig = myConfig.value("fastPath", nlohmann::json::object());
+        oscp::PoseTrackerPolicy myFastPathPolicy;
+        myFastPathPolicy.maxPriorAgeMs = myFastPathConfig.value("maxPriorAgeMs", myFastPathPolicy.maxPriorAgeMs);
+        myFastPathPolicy.positionAccuracyGrowth = myFastPathConfig.value("positionAccuracyGrowth", myFastPathPolicy.positionAccuracyGrowth);
+        myFastPathPolicy.orientationAccuracyGrowth = myFastPathConfig.value("orientationAccuracyGrowth", myFastPathPolicy.orientationAccuracyGrowth);
+        myFastPathPolicy.maxPositionAccuracy = myFastPathConfig.value("maxPositionAccuracy", myFastPathPolicy.maxPositionAccuracy);
+        myFastPathPolicy.maxOrientationAccuracy = myFastPathConfig.value("maxOrientationAccuracy", myFastPathPolicy.maxOrientationAccuracy);
+        myFastPathPolicy.sessionTimeoutMs = myFastPathConfig.value("sessionTimeoutMs", myFastPathPolicy.sessionTimeoutMs);
+        oscp::PoseTracker myPoseTracker(myFastPathPolicy);
+        std::cout << "Fast path: " << (mySessionsEnabled && myStartupConfig->fastPathEnabled ? "enabled" : "disabled") << std::endl;
+
+        // Intrinsics and undistortion tables of the cameras of recent sessions
+        const nlohmann::json myCameraCacheConfig = myConfig.value("cameraCache", nlohmann::json::object());
+        oscp::CameraCachePolicy myCameraCachePolicy;
+        myCameraCachePolicy.maxBytes = myCameraCacheConfig.value("maxBytes", myCameraCachePolicy.maxBytes);
+        myCameraCachePolicy.ttlMs = myCameraCacheConfig.value("ttlMs", myCameraCachePolicy.ttlMs);
+        myCameraCachePolicy.buildUndistortionMaps = myCameraCacheConfig.value("buildUndistortionMaps", myCameraCachePolicy.buildUndistortionMaps);
+        oscp::CameraCache myCameraCache(myCameraCachePolicy);
+
+        // Optional cache of the responses to repeated camera frames
+        const nlohmann::json myResponseCacheConfig = myConfig.value("responseCache", nlohmann::json::object());
+        oscp::ResponseCachePolicy myResponseCachePolicy;
+        myResponseCachePolicy.maxEntries = myResponseCacheConfig.value("maxEntries", myResponseCachePolicy.maxEntries);
+        myResponseCachePolicy.ttlMs = myResponseCacheConfig.value("ttlMs", myResponseCachePolicy.ttlMs);
+        myResponseCachePolicy.shardCount = myResponseCacheConfig.value("shardCount", myResponseCachePolicy.shardCount);
+        myResponseCachePolicy.geolocationBucketDegrees = myResponseCacheConfig.value("geolocationBucketDegrees", myResponseCachePolicy.geolocationBucketDegrees);
+        oscp::ResponseCache myResponseCache(myResponseCachePolicy);
+        std::cout << "Response cache: " << (myStartupConfig->responseCacheEnabled ? "enabled" : "disabled") << std::endl;
+
+        // Deduplication of retried requests by their id
+        const nlohmann::json myDeduplicationConfig = myConfig.value("deduplication", nlohmann::json::object());
+        oscp::RequestCoalescerPolicy myRequestCoalescerPolicy;
+        myRequestCoalescerPolicy.completedTtlMs = myDeduplicationConfig.value("completedTtlMs", myRequestCoalescerPolicy.completedTtlMs);
+        myRequestCoalescerPolicy.maxCompleted = myDeduplicationConfig.value("maxCompleted", myRequestCoalescerPolicy.maxCompleted);
+        oscp::RequestCoalescer myRequestCoalescer(myRequestCoalescerPolicy);
+
+        // Sensor sets that clients reference by token instead of resending them with every request
+        const nlohmann::json mySensorRegistryConfig = myConfig.value("sensorRegistry", nlohmann::json::object());
+        oscp::SensorRegistryPolicy mySensorRegistryPolicy;
+        mySensorRegistryPolicy.maxEntries = mySensorRegistryConfig.value("maxEntries", mySensorRegistryPolicy.maxEntries);
+        oscp::SensorRegistry mySensorRegistry(mySensorRegistryPolicy);
+
+        // Bounded concurrency of the VPS backend with shedding of standing queues, the age limit of requests is in ServerConfig
+        const nlohmann::json myAdmissionConfig = myConfig.value("admission", nlohmann::json::object());
+        oscp::AdmissionPolicy myAdmissionPolicy;
+        myAdmissionPolicy.maxConcurrent = myAdmissionConfig.value("maxConcurrent", myAdmissionPolicy.maxConcurrent);
+        myAdmissionPolicy.targetDelayMs = myAdmissionConfig.value("targetDelayMs", myAdmissionPolicy.targetDelayMs);
+        myAdmissionPolicy.intervalMs = myAdmissionConfig.value("intervalMs", myAdmissionPolicy.intervalMs);
+        oscp::AdmissionController myAdmission(myAdmissionPolicy);
+        std::cout << "Admission control: " << (myAdmissionPolicy.maxConcurrent > 0 ? std::to_string(myAdmissionPolicy.maxConcurrent) + " concurrent localizations" : "unlimited") << std::endl;
+
+        // The whole pipeline for one request: map shard, fast path, response cache, then the VPS backend.
+        // sessionId is the ID the server issued to a session (empty outside sessions), only it keys the fast path,
+        // while clientKey may come from a client header.
+        auto localize = [&](const ServerConfig& config, const oscp::GeoPoseRequest& gppRequest, const std::string& clientKey,
+            const std::string& sessionId, const oscp::RequestBudget& budget, oscp::RequestTrace* trace) -> oscp::GeoPoseResponse {
+            // Every answer, even from the fast path or the cache, requires map coverage at the geolocation
+            oscp::GeoPose myGeoPose = config.geopose;
+            if (!config.shardIndex.empty()) {
+                oscp::TraceSpan span(trace, "shard");
+                if (gppRequest.sensorReadings.geolocationReadings.empty()) {
+                    throw std::invalid_argument("A geolocation reading is required to select the map");
+                }
+                const oscp::GeolocationReading& geolocation = gppRequest.sensorReadings.geolocationReadings[0];
+                size_t shardIndex = 0;
+                if (config.shardIndex.find(geolocation.latitude, geolocation.longitude, &shardIndex, 1) == 0) {
+                    // Answer right away without involving any VPS backend
+                    throw NoMapCoverageError("No map coverage at the given geolocation");
+                }
+                // TODO: the VPS backend of config.shardIndex.shards()[shardIndex] would localize below
+                myGeoPose = config.shardGeoPoses[shardIndex];
+            }
+
+            if (mySessionsEnabled && config.fastPathEnabled) {
+                oscp::TraceSpan span(trace, "fast_path");
+                oscp::GeoPoseResponse gppResponse;
+                if (myPoseTracker.tryPropagate(sessionId, gppRequest, gppResponse)) {
+                    std::cout << "Answered by the fast path" << std::endl;
+                    return gppResponse;
+                }
+            }
+
+            // Repeated frames are answered from the cache, hashing the base64 text without decoding it
+            uint64_t responseCacheKey = 0;
+            const bool cacheable = config.responseCacheEnabled && myResponseCache.key(gppRequest, responseCacheKey);
+            if (cacheable) {
+                oscp::TraceSpan span(trace, "response_cache");
+                oscp::GeoPoseResponse gppResponse;
+                if (myResponseCache.find(responseCacheKey, gppResponse)) {
+                    gppResponse.id = gppRequest.id;
+                    gppResponse.timestamp = gppRequest.timestamp;
+                    if (mySessionsEnabled && config.fastPathEnabled) {
+                        myPoseTracker.accept(sessionId, gppResponse);
+                    }
+                    std::cout << "Answered from the response cache" << std::endl;
+                    return gppResponse;
+                }
+            }
+
+            // Only the backend is admission controlled, the stages before answer without it
+            oscp::AdmissionController::Slot slot;
+            {
+                oscp::TraceSpan span(trace, "queue");
+                slot = myAdmission.acquire(budget);
+            }
+            if (!slot) {
+                throw RequestDroppedError(slot.reason(), "backend");
+            }
+
+            // Consecutive frames of a session reuse the intrinsics (and undistortion tables) of their camera, prepared only
+            // for admitted requests. A camera without usable intrinsics is left to the backend, it does not fail the request.
+            std::vector<std::shared_ptr<const oscp::PreparedCamera>> cameras;
+            {
+                oscp::TraceSpan span(trace, "cameras");
+                for (const oscp::CameraReading& cameraReading : gppRequest.sensorReadings.cameraReadings) {
+                    if (cameraReading.params.model == oscp::CameraModel::UNKNOWN) {
+                        continue;
+                    }
+                    try {
+                        cameras.push_back(myCameraCache.get(clientKey, cameraReading));
+                    } catch (std::invalid_argument& e) {
+                        std::cout << "Camera " << cameraReading.sensorId << " not prepared: " << e.what() << std::endl;
+                    }
+                }
+            }
+
+            oscp::TraceSpan backendSpan(trace, "backend");
+            // TODO:
+            // ...
+            // here comes the call to VPS implementation, with the prepared cameras
+            // ...
+            // right now we just fill in the example values provided in the config file (of the selected shard)
+
+            oscp::GeoPoseResponse gppResponse;
+            gppResponse.id = gppRequest.id;
+            gppResponse.timestamp = gppRequest.timestamp;
+            gppResponse.accuracy = config.accuracy;
+            gppResponse.geopose = myGeoPose;
+            if (mySessionsEnabled && config.fastPathEnabled) {
+                myPoseTracker.accept(sessionId, gppResponse);
+            }
+            if (cacheable) {
+                myResponseCache.insert(responseCacheKey, gppResponse);
+            }
+            return gppResponse;
+        };
+
+        // Retries of a request (same client and request id) share one localization, only the one that runs it has its stages traced
+        // and its budget applied. Drops are not replayed, a retry after a drop localizes again.
+        // Requests without a client key are not deduplicated, anonymous clients would otherwise share one namespace of ids.
+        auto localizeOnce = [&](const ServerConfig& config, const oscp::GeoPoseRequest& gppRequest, const std::string& clientKey,
+            const std::string& sessionId, const oscp::RequestBudget& budget, oscp::RequestTrace* trace) -> oscp::GeoPoseResponse {
+            oscp::TraceSpan span(trace, "localize");
+            const std::string requestKey = gppRequest.id.empty() || clientKey.empty() ? std::string() : clientKey + "/" + std::string(gppRequest.id);
+            return myRequestCoalescer.run(requestKey, [&]() {
+                return localize(config, gppRequest, clientKey, sessionId, budget, trace);
+            });
+        };
 
+        // Drops a request whose deadline or age limit has passed before the given stage
+        auto checkBudget = [&](const oscp::RequestBudget& budget, const char* stage) {
+            if (std::optional<oscp::DropReason> reason = myAdmission.check(budget)) {
+                throw RequestDroppedError(*reason, stage);
+            }
+        };
+
+        // Batch requests and session frames are spread over this pool, independent of the HTTP worker threads
+        const nlohmann::json myBatchConfig = myConfig.value("batch", nlohmann::json::object());
+        oscp::WorkerPool myBatchWorkers(myBatchConfig.value("workers", 0));
+        std::cout << "Batch workers: " << myBatchWorkers.size() << std::endl;
+        // Frames are refused with 503 while this many tasks wait for a worker, batches are bounded by batch.maxRequests instead
+        const size_t myMaxQueuedFrames = myBatchConfig.value("maxQueuedFrames", size_t(1024));
+
+        // Long-lived sessions of continuously localizing clients
+        const nlohmann::json mySessionsConfig = myConfig.value("sessions", nlohmann::json::object());
+        oscp::SessionRegistryPolicy mySessionPolicy;
+        mySessionPolicy.idleTimeoutMs = mySessionsConfig.value("idleTimeoutMs", mySessionPolicy.idleTimeoutMs);
+        mySessionPolicy.maxSessions = mySessionsConfig.value("maxSessions", mySessionPolicy.maxSessions);
+        mySessionPolicy.maxQueuedMessages = mySessionsConfig.value("maxQueuedMessages", mySessionPolicy.maxQueuedMessages);
+        mySessionPolicy.maxFramesInFlight = mySessionsConfig.value("maxFramesInFlight", mySessionPolicy.maxFramesInFlight);
+        oscp::SessionRegistry mySessions(mySessionPolicy);
+
+        // Request bodies may be sent with Content-Encoding gzip or zstd, decompressed up to ServerConfig::maxDecompressedBytes
+        std::cout << "Request content codings: " << supported_content_codings() << std::endl;
+
+        // The most recent request traces for GET /geopose/trace, 0 traces only the requests that ask for a Server-Timing header
+        const nlohmann::json myTracingConfig = myConfig.value("tracing", nlohmann::json::object());
+        const size_t myMaxTraces = myTracingConfig.value("maxTraces", size_t(0));
+        oscp::TraceLog myTraceLog(myMaxTraces);
+        std::cout << "Trace log: " << myMaxTraces << " traces" << std::endl;
+
+        // The protocol versions and encodings the server speaks, in the order of preference.
+        // A new version or a binary encoding is one more line here and does not slow down the negotiation of the others.
+        Negotiator myContentNegotiator;
+        myContentNegotiator.add("application/vnd.oscp+json", {2, 0}, oscp::WireEncoding::JSON, write_json_response);
+
+        // Publishes a new ServerConfig when the file changes or on SIGHUP, an invalid one is rejected and the current one kept.
+        // Requests in flight finish with the version they started with, none is dropped.
+        const nlohmann::json myReloadConfig = myConfig.value("reload", nlohmann::json::object());
+        oscp::ConfigReloaderPolicy myReloaderPolicy;
+        myReloaderPolicy.pollIntervalMs = myReloadConfig.value("pollIntervalMs", myReloaderPolicy.pollIntervalMs);
+        oscp::ConfigReloader myConfigReloader(myConfigPath, myConfigVersion, [&](const std::string& contents) {
+            try {
+                myServerConfig.publish(parse_server_config(nlohmann::json::parse(contents)));
+                std::cout << "Config reloaded from " << myConfigPath << std::endl;
+                return true;
+            } catch (std::exception& e) {
+                std::cout << "Config not reloaded, keeping the current one: " << e.what() << std::endl;
+                return false;
+            }
+        }, myReloaderPolicy);
 
         httplib::Server server;
 
-        server.Get("/geopose", [](const httplib::Request& req, httplib::Response& res) {
-            res.set_content("{\"status\": \"running\"}", "application/json");\
+        server.Get("/geopose", [&](const httplib::Request& req, httplib::Response& res) {
+            const std::shared_ptr<const ServerConfig> config = myServerConfig.load();
+            nlohmann::json statusJson = {{"status", "running"}};
+            const oscp::ConfigReloaderStats configStats = myConfigReloader.stats();
+            statusJson["config"] = {
+                {"reloads", configStats.reloads},
+                {"failures", configStats.failures},
+                {"shards", config->shardIndex.shards().size()}
+            };
+            if (mySessionsEnabled && config->fastPathEnabled) {
+                const oscp::PoseTrackerStats stats = myPoseTracker.stats();
+                statusJson["fastPath"] = {
+                    {"hits", stats.hits},
+                    {"missesNoPrior", stats.missesNoPrior},
+                    {"missesStalePrior", stats.missesStalePrior},
+                    {"missesInaccurate", stats.missesInaccurate},
+                    {"hitRate", stats.hitRate()}
+                };
+            }
+            if (config->responseCacheEnabled) {
+                const oscp::ResponseCacheStats responseCacheStats = myResponseCache.stats();
+                statusJson["responseCache"] = {
+                    {"hits", responseCacheStats.hits},
+                    {"misses", responseCacheStats.misses},
+                    {"evictions", responseCacheStats.evictions},
+                    {"entries", responseCacheStats.entries}
+                };
+            }
+            const oscp::RequestCoalescerStats deduplicationStats = myRequestCoalescer.stats();
+            statusJson["deduplication"] = {
+                {"executed", deduplicationStats.executed},
+                {"coalesced", deduplicationStats.coalesced},
+                {"replayed", deduplicationStats.replayed},
+                {"failed", deduplicationStats.failed},
+                {"inFlight", deduplicationStats.inFlight},
+                {"completed", deduplicationStats.completed}
+            };
+            const oscp::CameraCacheStats cameraCacheStats = myCameraCache.stats();
+            statusJson["cameraCache"] = {
+                {"hits", cameraCacheStats.hits},
+                {"misses", cameraCacheStats.misses},
+                {"evictions", cameraCacheStats.evictions},
+                {"entries", cameraCacheStats.entries},
+                {"bytes", cameraCacheStats.bytes}
+            };
+            const oscp::SensorRegistryStats sensorRegistryStats = mySensorRegistry.stats();
+            statusJson["sensorRegistry"] = {
+                {"added", sensorRegistryStats.added},
+                {"hits", sensorRegistryStats.hits},
+                {"misses", sensorRegistryStats.misses},
+                {"evictions", sensorRegistryStats.evictions},
+                {"collisions", sensorRegistryStats.collisions},
+                {"entries", sensorRegistryStats.entries}
+            };
+            const oscp::AdmissionStats admissionStats = myAdmission.stats();
+            statusJson["admission"] = {
+                {"admitted", admissionStats.admitted},
+                {"deadlineExceeded", admissionStats.deadlineExceeded},
+                {"tooOld", admissionStats.tooOld},
+                {"overloaded", admissionStats.overloaded},
+                {"running", admissionStats.running},
+                {"queued", admissionStats.queued}
+            };
+            const oscp::SessionRegistryStats sessionStats = mySessions.stats();
+            statusJson["sessions"] = {
+                {"created", sessionStats.created},
+                {"closed", sessionStats.closed},
+                {"expired", sessionStats.expired},
+                {"active", sessionStats.active}
+            };
+            res.set_content(statusJson.dump(), "application/json");
+        });
+
+        // The recent request traces as Chrome trace events, to be opened in chrome://tracing or ui.perfetto.dev
+        server.Get("/geopose/trace", [&](const httplib::Request&, httplib::Response& res) {
+            res.set_content(myTraceLog.chromeTraceJson(), "application/json");
         });
 
-        server.Post("/geopose", [&](const httplib::Request& req, httplib::Response& res) {
+        server.Post("/geopose", [&](const httplib::Request& req, httplib::Response& res, const httplib::ContentReader& content_reader) {
+            const HandlerTrace trace(start_trace(req, myTraceLog, myMaxTraces > 0, "POST /geopose"), req, res);
+            const oscp::RequestBudget::Clock::time_point arrival = oscp::RequestBudget::Clock::now();
+            const std::shared_ptr<const ServerConfig> config = myServerConfig.load();
             try {
-                verify_version_header(req.headers);
+                oscp::RequestBudget budget;
+                if (std::optional<oscp::ParseError> error = request_budget(req, arrival, budget)) {
+                    set_parse_error(res, *error);
+                    return;
+                }
+                Negotiator::Selection negotiated;
+                {
+                    oscp::TraceSpan span(trace.get(), "negotiate");
+                    negotiated = negotiate(myContentNegotiator, req, res);
+                }
+                if (!negotiated) {
+                    return;
+                }
 
-                nlohmann::json requestDataJson = json::parse(req.body);
-                oscp::GeoPoseRequest gppRequest = requestDataJson.get<oscp::GeoPoseRequest>();
+                checkBudget(budget, "body");
+                std::string body;
+                {
+                    oscp::TraceSpan span(trace.get(), "body");
+                    if (!read_body(req, content_reader, config->maxDecompressedBytes, res, body)) {
+                        return;
+                    }
+                }
+
+                // Invalid requests are routine, they are rejected without throwing
+                oscp::TraceSpan parseSpan(trace.get(), "parse");
+                oscp::ParseResult<nlohmann::json> requestDataJson = oscp::tryParseJson(body);
+                if (!requestDataJson) {
+                    set_parse_error(res, requestDataJson.error());
+                    return;
+                }
+                // All strings and containers of the parsed request are allocated from a per-request arena,
+                // which is released in one shot when this handler returns. The image dominates the body size.
+                std::pmr::monotonic_buffer_resource requestArena(body.size());
+                oscp::ParseResult<oscp::GeoPoseRequest> parsed = oscp::tryParseGeoPoseRequest(*requestDataJson, &requestArena);
+                if (!parsed) {
+                    set_parse_error(res, parsed.error());
+                    return;
+                }
+                parseSpan.end();
+                oscp::GeoPoseRequest& gppRequest = *parsed;
+                {
+                    oscp::TraceSpan span(trace.get(), "sensors");
+                    if (gppRequest.sensorsToken.empty()) {
+                        // Acknowledge the sensor set, so the next requests of the client can send its token instead
+                        const std::string sensorsToken = mySensorRegistry.add(oscp::sessionOf(gppRequest));
+                        if (!sensorsToken.empty()) {
+                            res.set_header("X-OSCP-Sensors-Token", sensorsToken);
+                        }
+                    } else if (std::optional<oscp::ParseError> error = mySensorRegistry.tryResolve(gppRequest)) {
+                        set_parse_error(res, *error);
+                        return;
+                    }
+                }
 
                 // DEBUG
-                nlohmann::json requestDataJsonNoImage = requestDataJson;
-                requestDataJsonNoImage["sensorReadings"]["cameraReadings"][0]["imageBytes"] = "<IMAGE_BASE64>";
-                std::cout << "REQUEST JSON:" << std::endl << requestDataJsonNoImage << std::endl;
-
-                // TODO:
-                // ...
-                // here comes the call to VPS implementation
-                // ...
-                // right now we just fill in the example values provided in the config file
-                oscp::GeoPose myGeoPose;
-                myGeoPose.quaternion.x = myConfig["geopose"]["quaternion"]["x"];
-                myGeoPose.quaternion.y = myConfig["geopose"]["quaternion"]["y"];
-                myGeoPose.quaternion.z = myConfig["geopose"]["quaternion"]["z"];
-                myGeoPose.quaternion.w = myConfig["geopose"]["quaternion"]["w"];
-                myGeoPose.position.lat = myConfig["geopose"]["position"]["lat"];
-                myGeoPose.position.lon = myConfig["geopose"]["position"]["lon"];
-                myGeoPose.position.h = myConfig["geopose"]["position"]["h"];
+                {
+                    oscp::TraceSpan span(trace.get(), "log");
+                    nlohmann::json requestDataJsonNoImage = *requestDataJson;
+                    requestDataJsonNoImage["sensorReadings"]["cameraReadings"][0]["imageBytes"] = "<IMAGE_BASE64>";
+                    std::cout << "REQUEST JSON:" << std::endl << requestDataJsonNoImage << std::endl;
+                }
 
-                oscp::GeoPoseResponse gppResponse;
-                gppResponse.id = gppRequest.id;
-                gppResponse.timestamp = gppRequest.timestamp;
-                gppResponse.geopose = myGeoPose;
+                // Retries are recognized by an ID the client chooses, the fast path is left to sessions with a server-issued ID
+                const std::string clientKey = req.get_header_value("X-OSCP-Client-Id");
+                budget.setMaxAge(gppRequest.timestamp, config->maxRequestAgeMs);
+                checkBudget(budget, "localize");
+                oscp::GeoPoseResponse gppResponse = localizeOnce(*config, gppRequest, clientKey, std::string(), budget, trace.get());
 
-                nlohmann::json responseDataJson = gppResponse; // automatic conversion
-                std::string responseDataString = responseDataJson.dump();
+                checkBudget(budget, "serialize");
+                oscp::TraceSpan serializeSpan(trace.get(), "serialize");
+                const std::string responseDataString = (*negotiated.handler)(gppResponse);
+                serializeSpan.end();
 
                 // DEBUG
-                std::cout << "RESPONSE JSON" << std::endl << responseDataJson << std::endl;
+                std::cout << "RESPONSE JSON" << std::endl << responseDataString << std::endl;
 
-                res.set_content(responseDataString, "application/json");
+                res.set_content(responseDataString, negotiated.representation->contentType);
+            } catch (RequestDroppedError& e) {
+                set_drop_error(res, e);
+            } catch (NoMapCoverageError& e) {
+                nlohmann::json errorJson = {{"error", e.what()}};
+                res.set_content(errorJson.dump(), "application/json");
+                res.status = 404; // not found
             } catch (std::exception& e) {
                 std::string errorMessage = std::string(e.what());
                 std::cout << "Exception occurred: " << errorMessage << std::endl;
-                res.set_content("{\"error\":\"" + errorMessage + "\"}", "application/json");
+                nlohmann::json errorJson = {{"error", errorMessage}};
+                res.set_content(errorJson.dump(), "application/json");
                 res.status = 400; // bad request
             }
         });
 
+        // Localizes an array of GeoPoseRequests in parallel and streams one line of JSON per request as soon as
+        // it is done (NDJSON), in completion order: the GeoPoseResponse, or {"index", "id", "status", "error"}.
+        server.Post("/geopose/batch", [&](const httplib::Request& req, httplib::Response& res, const httplib::ContentReader& content_reader) {
+            struct BatchState {
+                std::pmr::monotonic_buffer_resource arena;
+                std::vector<oscp::GeoPoseRequest> requests;
+                std::mutex mutex;
+                std::condition_variable ready;
+                std::deque<std::string> lines;
+                size_t pending = 0;
+
+                explicit BatchState(size_t initialSize) : arena(initialSize) {}
+            };
+
+            auto errorLine = [](size_t index, const std::string& id, int status, const std::string& message) {
+                nlohmann::json errorJson = {{"index", index}, {"id", id}, {"status", status}, {"error", message}};
+                return errorJson.dump() + "\n";
+            };
+            // Same as set_parse_error(), with the path relative to the request in the batch
+            auto parseErrorLine = [](size_t index, const nlohmann::json& requestJson, const oscp::ParseError& error) {
+                const std::string id = requestJson.is_object() && requestJson.contains("id") && requestJson["id"].is_string()
+                    ? requestJson["id"].get<std::string>() : std::string();
+                const int status = error.code == oscp::ParseErrorCode::UNKNOWN_SENSORS_TOKEN ? 412 : 400;
+                nlohmann::json errorJson = {{"index", index}, {"id", id}, {"status", status}, {"error", error.message},
+                    {"code", oscp::toString(error.code)}, {"path", error.path}};
+                return errorJson.dump() + "\n";
+            };
+
+            HandlerTrace trace(start_trace(req, myTraceLog, myMaxTraces > 0, "POST /geopose/batch"), req, res);
+            const oscp::RequestBudget::Clock::time_point arrival = oscp::RequestBudget::Clock::now();
+            const std::shared_ptr<const ServerConfig> config = myServerConfig.load(); // for all requests of the batch
+            try {
+                oscp::RequestBudget budget; // for the whole batch
+                if (std::optional<oscp::ParseError> error = request_budget(req, arrival, budget)) {
+                    set_parse_error(res, *error);
+                    return;
+                }
+                if (!negotiate(myContentNegotiator, req, res)) { // once for all requests of the batch
+                    return;
+                }
+
+                checkBudget(budget, "body");
+                std::string body;
+                {
+                    oscp::TraceSpan span(trace.get(), "body");
+                    if (!read_body(req, content_reader, config->maxDecompressedBytes, res, body)) {
+                        return;
+                    }
+                }
+                oscp::TraceSpan parseSpan(trace.get(), "parse");
+                oscp::ParseResult<nlohmann::json> parsedBatch = oscp::tryParseJson(body);
+                if (!parsedBatch) {
+                    set_parse_error(res, parsedBatch.error());
+                    return;
+                }
+                const nlohmann::json& batchJson = *parsedBatch;
+                if (!batchJson.is_array()) {
+                    set_parse_error(res, oscp::ParseError(oscp::ParseErrorCode::WRONG_TYPE, "", "The batch must be a JSON array of GeoPoseRequests"));
+                    return;
+                }
+                if (batchJson.size() > config->batchMaxRequests) {
+                    set_parse_error(res, oscp::ParseError(oscp::ParseErrorCode::INVALID_VALUE, "",
+                        "The batch must not contain more than " + std::to_string(config->batchMaxRequests) + " requests"));
+                    return;
+                }
+                std::cout << "BATCH of " << batchJson.size() << " requests" << std::endl;
+
+                // Parsed in order on this thread, the arena is not thread-safe
+                auto state = std::make_shared<BatchState>(body.size());
+                state->requests.reserve(batchJson.size());
+                std::vector<size_t> indices;
+                for (size_t i = 0; i < batchJson.size(); i++) {
+                    oscp::ParseResult<oscp::GeoPoseRequest> parsed = oscp::tryParseGeoPoseRequest(batchJson[i], &state->arena);
+                    if (!parsed) {
+                        state->lines.push_back(parseErrorLine(i, batchJson[i], parsed.error()));
+                        continue;
+                    }
+                    if (std::optional<oscp::ParseError> error = mySensorRegistry.tryResolve(*parsed)) {
+                        state->lines.push_back(parseErrorLine(i, batchJson[i], *error));
+                        continue;
+                    }
+                    state->requests.push_back(std::move(*parsed));
+                    indices.push_back(i);
+                }
+                state->pending = state->requests.size();
+                parseSpan.end();
+                // The Server-Timing header covers the stages up to here, the localizations on the workers are only exported
+                trace.respond();
+
+                const std::string clientKey = req.get_header_value("X-OSCP-Client-Id");
+                for (size_t r = 0; r < state->requests.size(); r++) {
+                    myBatchWorkers.submit([&, state, r, index = indices[r], clientKey, errorLine, budget, config, batchTrace = trace.shared()]() {
+                        const oscp::GeoPoseRequest& gppRequest = state->requests[r];
+                        std::string line;
+                        try {
+                            // Requests may wait for a worker, and each has its own timestamp
+                            oscp::RequestBudget requestBudget = budget;
+                            requestBudget.setMaxAge(gppRequest.timestamp, config->maxRequestAgeMs);
+                            checkBudget(requestBudget, "localize");
+                            nlohmann::json responseDataJson = localizeOnce(*config, gppRequest, clientKey, std::string(), requestBudget, batchTrace.get());
+                            line = responseDataJson.dump() + "\n";
+                        } catch (RequestDroppedError& e) {
+                            line = errorLine(index, std::string(gppRequest.id), e.status(), e.what());
+                        } catch (NoMapCoverageError& e) {
+                            line = errorLine(index, std::string(gppRequest.id), 404, e.what());
+                        } catch (std::exception& e) {
+                            line = errorLine(index, std::string(gppRequest.id), 400, e.what());
+                        }
+                        {
+                            std::lock_guard<std::mutex> lock(state->mutex);
+                            state->lines.push_back(std::move(line));
+                            state->pending--;
+                        }
+                        state->ready.notify_one();
+                    });
+                }
+
+                // Called by httplib until done() or a failed write, each call sends the next finished line
+                res.set_chunked_content_provider("application/x-ndjson", [state](size_t, httplib::DataSink& sink) {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->ready.wait(lock, [&state] { return !state->lines.empty() || state->pending == 0; });
+                    if (state->lines.empty()) {
+                        sink.done();
+                        return true;
+                    }
+                    const std::string line = std::move(state->lines.front());
+                    state->lines.pop_front();
+                    lock.unlock();
+                    return sink.write(line.data(), line.size());
+                });
+            } catch (RequestDroppedError& e) {
+                set_drop_error(res, e);
+            } catch (std::exception& e) {
+                std::string errorMessage = std::string(e.what());
+                std::cout << "Exception occurred: " << errorMessage << std::endl;
+                nlohmann::json errorJson = {{"error", errorMessage}};
+                res.set_content(errorJson.dump(), "application/json");
+                res.status = 400; // bad request
+            }
+        });
+
+        // Session mode for clients that localize continuously. The client opens a session with its sensors and
+        // camera params once, then posts frames with only readings and images. The Accept header is validated once
+        // per session, and the GeoPoseResponses are pushed as NDJSON on the stream of the session as soon as they are ready.
+        if (mySessionsEnabled) {
+            server.Post("/geopose/sessions", [&](const httplib::Request& req, httplib::Response& res, const httplib::ContentReader& content_reader) {
+                const HandlerTrace trace(start_trace(req, myTraceLog, myMaxTraces > 0, "POST /geopose/sessions"), req, res);
+                const std::shared_ptr<const ServerConfig> config = myServerConfig.load();
+                try {
+                    if (!negotiate(myContentNegotiator, req, res)) { // once for all frames of the session
+                        return;
+                    }
+
+                    std::string body;
+                    {
+                        oscp::TraceSpan span(trace.get(), "body");
+                        if (!read_body(req, content_reader, config->maxDecompressedBytes, res, body)) {
+                            return;
+                        }
+                    }
+                    oscp::TraceSpan parseSpan(trace.get(), "parse");
+                    oscp::ParseResult<nlohmann::json> sessionJson = oscp::tryParseJson(body);
+                    if (!sessionJson) {
+                        set_parse_error(res, sessionJson.error());
+                        return;
+                    }
+                    oscp::ParseResult<oscp::GeoPoseSession> definition = oscp::tryParseGeoPoseSession(*sessionJson);
+                    if (!definition) {
+                        set_parse_error(res, definition.error());
+                        return;
+                    }
+                    parseSpan.end();
+                    std::shared_ptr<oscp::LocalizationSession> session = mySessions.create(std::move(*definition));
+                    if (!session) {
+                        nlohmann::json errorJson = {{"error", "Too many open sessions"}};
+                        res.set_content(errorJson.dump(), "application/json");
+                        res.status = 503; // service unavailable
+                        return;
+                    }
+                    std::cout << "SESSION " << session->id() << " opened" << std::endl;
+                    nlohmann::json createdJson = {{"type", "geopose-session"}, {"sessionId", session->id()}};
+                    res.set_content(createdJson.dump(), "application/json");
+                    res.status = 201; // created
+                } catch (std::exception& e) {
+                    std::string errorMessage = std::string(e.what());
+                    std::cout << "Exception occurred: " << errorMessage << std::endl;
+                    nlohmann::json errorJson = {{"error", errorMessage}};
+                    res.set_content(errorJson.dump(), "application/json");
+                    res.status = 400; // bad request
+                }
+            });
+
+            // A frame is a GeoPoseRequest without sensors, camera readings may leave out their params.
+            // It is answered with 202 right after parsing, the result follows on the stream:
+            // the GeoPoseResponse, or {"id", "status", "error"}.
+            server.Post(R"(/geopose/sessions/([0-9a-f]+)/frames)", [&](const httplib::Request& req, httplib::Response& res, const httplib::ContentReader& content_reader) {
+                struct FrameState {
+                    std::pmr::monotonic_buffer_resource arena;
+                    std::optional<oscp::GeoPoseRequest> request;
+
+                    explicit FrameState(size_t initialSize) : arena(initialSize) {}
+                };
+
+                auto errorLine = [](const std::string& id, int status, const std::string& message) {
+                    nlohmann::json errorJson = {{"id", id}, {"status", status}, {"error", message}};
+                    return errorJson.dump() + "\n";
+                };
+
+                HandlerTrace trace(start_trace(req, myTraceLog, myMaxTraces > 0, "POST /geopose/sessions/frames"), req, res);
+                const oscp::RequestBudget::Clock::time_point arrival = oscp::RequestBudget::Clock::now();
+                const std::shared_ptr<const ServerConfig> config = myServerConfig.load();
+                try {
+                    oscp::RequestBudget budget;
+                    if (std::optional<oscp::ParseError> error = request_budget(req, arrival, budget)) {
+                        set_parse_error(res, *error);
+                        return;
+                    }
+                    std::shared_ptr<oscp::LocalizationSession> session = mySessions.find(req.matches[1]);
+                    if (!session) {
+                        nlohmann::json errorJson = {{"error", "No such session"}};
+                        res.set_content(errorJson.dump(), "application/json");
+                        res.status = 404; // not found
+                        return;
+                    }
+
+                    checkBudget(budget, "body");
+                    std::string body;
+                    {
+                        oscp::TraceSpan span(trace.get(), "body");
+                        if (!read_body(req, content_reader, config->maxDecompressedBytes, res, body)) {
+                            return;
+                        }
+                    }
+                    oscp::TraceSpan parseSpan(trace.get(), "parse");
+                    oscp::ParseResult<nlohmann::json> frameJson = oscp::tryParseJson(body);
+                    if (!frameJson) {
+                        set_parse_error(res, frameJson.error());
+                        return;
+                    }
+                    auto state = std::make_shared<FrameState>(body.size());
+                    oscp::ParseResult<oscp::GeoPoseRequest> parsed = oscp::tryParseGeoPoseFrame(*frameJson, session->definition(), &state->arena);
+                    if (!parsed) {
+                        set_parse_error(res, parsed.error());
+                        return;
+                    }
+                    state->request.emplace(std::move(*parsed));
+                    parseSpan.end();
+                    budget.setMaxAge(state->request->timestamp, config->maxRequestAgeMs);
+                    checkBudget(budget, "localize");
+
+                    // Neither one client nor all of them together can queue unbounded work
+                    if (!session->beginFrame()) {
+                        nlohmann::json errorJson = {{"error", "Too many frames of the session in flight"}};
+                        res.set_content(errorJson.dump(), "application/json");
+                        res.status = 429; // too many requests
+                        res.set_header("Retry-After", "1");
+                        return;
+                    }
+                    res.status = 202; // accepted
+                    // The Server-Timing header of the 202 covers the parsing, the localization on the worker is only exported
+                    trace.respond();
+
+                    const bool queued = myBatchWorkers.trySubmit([&, state, session, errorLine, budget, config, frameTrace = trace.shared()]() {
+                        const oscp::GeoPoseRequest& gppRequest = *state->request;
+                        std::string line;
+                        try {
+                            checkBudget(budget, "localize"); // again after waiting for a worker
+                            nlohmann::json responseDataJson = localizeOnce(*config, gppRequest, session->id(), session->id(), budget, frameTrace.get());
+                            line = responseDataJson.dump() + "\n";
+                        } catch (RequestDroppedError& e) {
+                            line = errorLine(std::string(gppRequest.id), e.status(), e.what());
+                        } catch (NoMapCoverageError& e) {
+                            line = errorLine(std::string(gppRequest.id), 404, e.what());
+                        } catch (std::exception& e) {
+                            line = errorLine(std::string(gppRequest.id), 400, e.what());
+                        }
+                        session->push(std::move(line));
+                        session->endFrame();
+                    }, myMaxQueuedFrames);
+                    if (!queued) {
+                        session->endFrame();
+                        nlohmann::json errorJson = {{"error", "Too many frames waiting for a worker"}};
+                        res.set_content(errorJson.dump(), "application/json");
+                        res.status = 503; // service unavailable
+                        res.set_header("Retry-After", "1");
+                    }
+                } catch (RequestDroppedError& e) {
+                    set_drop_error(res, e);
+                } catch (std::exception& e) {
+                    std::string errorMessage = std::string(e.what());
+                    std::cout << "Exception occurred: " << errorMessage << std::endl;
+                    nlohmann::json errorJson = {{"error", errorMessage}};
+                    res.set_content(errorJson.dump(), "application/json");
+                    res.status = 400; // bad request
+                }
+            });
+
+            // Pushes the results of the frames of a session until the session is closed or expires.
+            // Every open stream occupies one HTTP worker thread.
+            server.Get(R"(/geopose/sessions/([0-9a-f]+)/stream)", [&](const httplib::Request& req, httplib::Response& res) {
+                std::shared_ptr<oscp::LocalizationSession> session = mySessions.find(req.matches[1]);
+                if (!session) {
+                    nlohmann::json errorJson = {{"error", "No such session"}};
+                    res.set_content(errorJson.dump(), "application/json");
+                    res.status = 404; // not found
+                    return;
+                }
+                res.set_chunked_content_provider("application/x-ndjson", [session](size_t, httplib::DataSink& sink) {
+                    std::string line;
+                    // Wake up regularly to notice a client that went away
+                    while (!session->pop(line, std::chrono::milliseconds(1000))) {
+                        if (session->closed()) {
+                            sink.done();
+                            return true;
+                        }
+                        if (!sink.is_writable()) {
+                            return false;
+                        }
+                    }
+                    return sink.write(line.data(), line.size());
+                });
+            });
+
+            server.Delete(R"(/geopose/sessions/([0-9a-f]+))", [&](const httplib::Request& req, httplib::Response& res) {
+                if (mySessions.close(req.matches[1])) {
+                    std::cout << "SESSION " << std::string(req.matches[1]) << " closed" << std::endl;
+                    res.status = 204; // no content
+                } else {
+                    nlohmann::json errorJson = {{"error", "No such session"}};
+                    res.set_content(errorJson.dump(), "application/json");
+                    res.status = 404; // not found
+                }
+            });
+        }
+
+        if (myReusePort) {
+            server.set_socket_options([](socket_t sock) {
+                const int yes = 1;
+                setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof(yes));
+                oscp::enableReusePort(static_cast<int>(sock));
+            });
+        }
         server.listen("0.0.0.0", 8080);
 
     } catch (std::exception& e) {
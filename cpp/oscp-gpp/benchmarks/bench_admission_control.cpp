@@ -0,0 +1,49 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/admission_control.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// What every localization that reaches the backend pays: one acquire and release, with the given number of slots
+// (0 is unlimited) shared by the benchmark threads
+void BM_AdmissionController_Acquire(benchmark::State& state) {
+    static oscp::AdmissionController* controller = nullptr;
+    if (state.thread_index() == 0) {
+        oscp::AdmissionPolicy policy;
+        policy.maxConcurrent = static_cast<size_t>(state.range(0));
+        controller = new oscp::AdmissionController(policy);
+    }
+    oscp::RequestBudget budget;
+    budget.setTimeout(1000, oscp::RequestBudget::Clock::now());
+    for (auto _ : state) {
+        oscp::AdmissionController::Slot slot = controller->acquire(budget);
+        benchmark::DoNotOptimize(slot);
+    }
+    if (state.thread_index() == 0) {
+        state.counters["overloaded"] = static_cast<double>(controller->stats().overloaded);
+        delete controller;
+    }
+}
+BENCHMARK(BM_AdmissionController_Acquire)->Arg(0)->Arg(2)->ThreadRange(1, 8)->UseRealTime();
+
+// The check before each stage
+void BM_AdmissionController_Check(benchmark::State& state) {
+    oscp::AdmissionController controller;
+    oscp::RequestBudget budget;
+    budget.setTimeout(1000, oscp::RequestBudget::Clock::now());
+    budget.setMaxAge(0, 1000);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(controller.check(budget));
+    }
+}
+BENCHMARK(BM_AdmissionController_Check);
+
+} // namespace
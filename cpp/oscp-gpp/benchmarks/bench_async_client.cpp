@@ -0,0 +1,269 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "benchmark_data.h"
+
+#include <oscp-gpp/async_client.h>
+#include <oscp-gpp/geoposeprotocol_json.h>
+
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Simulated localization time of the server, long enough that a client waiting for one response at a time idles
+constexpr std::chrono::milliseconds processingTime(5);
+
+bool sendAll(int socket, const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t sent = send(socket, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+// Reads one HTTP message with a Content-Length into message, returns the offset of its body or 0 on failure
+size_t recvMessage(int socket, std::string& message) {
+    message.clear();
+    char buffer[16 * 1024];
+    size_t bodyOffset = 0;
+    size_t contentLength = 0;
+    while (bodyOffset == 0 || message.size() < bodyOffset + contentLength) {
+        const ssize_t received = recv(socket, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return 0;
+        }
+        message.append(buffer, static_cast<size_t>(received));
+        if (bodyOffset == 0) {
+            const size_t headerEnd = message.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) {
+                continue;
+            }
+            bodyOffset = headerEnd + 4;
+            const size_t lengthPos = message.find("Content-Length: ");
+            contentLength = lengthPos < headerEnd ? std::strtoul(message.c_str() + lengthPos + 16, nullptr, 10) : 0;
+        }
+    }
+    return bodyOffset;
+}
+
+// A server on a loopback port with a thread per kept-alive connection, answering every request with a GeoPoseResponse
+// after processingTime
+class LoopbackServer {
+public:
+    LoopbackServer() {
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (listener_ < 0 || bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener_, 1024) != 0) {
+            throw std::runtime_error("Could not listen on the loopback interface");
+        }
+        socklen_t length = sizeof(address);
+        getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+        const std::string body = nlohmann::json(oscp::benchmarks::makeGeoPoseResponse()).dump();
+        response_ = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+        acceptor_ = std::thread([this]() { accept(); });
+    }
+
+    ~LoopbackServer() {
+        shutdown(listener_, SHUT_RDWR);
+        acceptor_.join();
+        close(listener_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int connection : connections_) {
+            shutdown(connection, SHUT_RDWR);
+        }
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+        for (int connection : connections_) {
+            close(connection);
+        }
+    }
+
+    int port() const {
+        return port_;
+    }
+
+private:
+    void accept() {
+        for (;;) {
+            const int connection = ::accept(listener_, nullptr, nullptr);
+            if (connection < 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            connections_.push_back(connection);
+            threads_.emplace_back([this, connection]() { serve(connection); });
+        }
+    }
+
+    void serve(int connection) const {
+        std::string message;
+        while (recvMessage(connection, message) > 0) {
+            std::this_thread::sleep_for(processingTime);
+            if (!sendAll(connection, response_.data(), response_.size())) {
+                return;
+            }
+        }
+    }
+
+    int listener_ = -1;
+    int port_ = 0;
+    std::string response_;
+    std::mutex mutex_;
+    std::vector<int> connections_;
+    std::vector<std::thread> threads_;
+    std::thread acceptor_;
+};
+
+// A blocking client connection like the one of the demo client, kept alive between requests
+class BlockingConnection {
+public:
+    explicit BlockingConnection(int port) {
+        socket_ = socket(AF_INET, SOCK_STREAM, 0);
+        const int yes = 1;
+        setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        if (socket_ < 0 || connect(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            throw std::runtime_error("Could not connect to the loopback server");
+        }
+    }
+
+    ~BlockingConnection() {
+        close(socket_);
+    }
+
+    BlockingConnection(const BlockingConnection&) = delete;
+    BlockingConnection& operator=(const BlockingConnection&) = delete;
+
+    // POST /geopose and parse the response, the same work as AsyncClient::localize()
+    bool localize(const oscp::GeoPoseRequest& request) {
+        const std::string body = nlohmann::json(request).dump();
+        const std::string head = "POST /geopose HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\nContent-Length: "
+            + std::to_string(body.size()) + "\r\n\r\n";
+        const size_t bodyOffset = sendAll(socket_, head.data(), head.size()) && sendAll(socket_, body.data(), body.size())
+            ? recvMessage(socket_, message_) : 0;
+        if (bodyOffset == 0) {
+            return false;
+        }
+        oscp::ParseResult<nlohmann::json> json = oscp::tryParseJson(std::string_view(message_).substr(bodyOffset));
+        return json && json->get<oscp::GeoPoseResponse>().id.size() > 0;
+    }
+
+private:
+    int socket_ = -1;
+    std::string message_;
+};
+
+const oscp::GeoPoseRequest& benchmarkRequest() {
+    static const oscp::GeoPoseRequest request = oscp::benchmarks::makeGeoPoseRequest(1, 0, 16 * 1024);
+    return request;
+}
+
+void reportCounters(benchmark::State& state, size_t succeeded, size_t threads) {
+    state.SetItemsProcessed(static_cast<int64_t>(succeeded));
+    state.counters["failed"] = static_cast<double>(state.iterations() * state.range(0) - static_cast<int64_t>(succeeded));
+    state.counters["client_threads"] = static_cast<double>(threads);
+}
+
+// N requests in flight from the calling thread, with the callback interface
+void BM_AsyncClient_Callbacks(benchmark::State& state) {
+    const size_t inFlight = static_cast<size_t>(state.range(0));
+    LoopbackServer server;
+    oscp::AsyncClient client("127.0.0.1", server.port());
+    size_t succeeded = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < inFlight; i++) {
+            client.localize(benchmarkRequest(), [&succeeded](oscp::LocalizeResult&& result) {
+                succeeded += result.response ? 1 : 0;
+            });
+        }
+        client.run();
+    }
+    reportCounters(state, succeeded, 1);
+}
+BENCHMARK(BM_AsyncClient_Callbacks)->ArgName("in_flight")->RangeMultiplier(4)->Range(1, 256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+#ifdef OSCP_GPP_HAS_COROUTINES
+
+oscp::DetachedTask localizeOnce(oscp::AsyncClient& client, size_t& succeeded) {
+    const oscp::LocalizeResult result = co_await client.localize(benchmarkRequest());
+    succeeded += result.response ? 1 : 0;
+}
+
+// The same with a coroutine per request
+void BM_AsyncClient_Coroutines(benchmark::State& state) {
+    const size_t inFlight = static_cast<size_t>(state.range(0));
+    LoopbackServer server;
+    oscp::AsyncClient client("127.0.0.1", server.port());
+    size_t succeeded = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < inFlight; i++) {
+            localizeOnce(client, succeeded);
+        }
+        client.run();
+    }
+    reportCounters(state, succeeded, 1);
+}
+BENCHMARK(BM_AsyncClient_Coroutines)->ArgName("in_flight")->RangeMultiplier(4)->Range(1, 256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+#endif // OSCP_GPP_HAS_COROUTINES
+
+// N requests in flight the way of the synchronous client: a thread per request, blocking on its own kept-alive connection
+void BM_ThreadPerRequest(benchmark::State& state) {
+    const size_t inFlight = static_cast<size_t>(state.range(0));
+    LoopbackServer server;
+    std::vector<std::unique_ptr<BlockingConnection>> connections;
+    for (size_t i = 0; i < inFlight; i++) {
+        connections.push_back(std::make_unique<BlockingConnection>(server.port()));
+    }
+    std::vector<char> results(inFlight);
+    size_t succeeded = 0;
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        threads.reserve(inFlight);
+        for (size_t i = 0; i < inFlight; i++) {
+            threads.emplace_back([&connections, &results, i]() { results[i] = connections[i]->localize(benchmarkRequest()); });
+        }
+        for (size_t i = 0; i < inFlight; i++) {
+            threads[i].join();
+            succeeded += results[i];
+        }
+    }
+    reportCounters(state, succeeded, inFlight);
+}
+BENCHMARK(BM_ThreadPerRequest)->ArgName("in_flight")->RangeMultiplier(4)->Range(1, 256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+#endif // __linux__
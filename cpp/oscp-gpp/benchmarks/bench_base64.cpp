@@ -0,0 +1,54 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "benchmark_data.h"
+
+#include <oscp-gpp/base64.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Image sizes from a small thumbnail up to a large JPEG frame
+void imageSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(16 * 1024)->Arg(64 * 1024)->Arg(256 * 1024)->Arg(1024 * 1024)->Arg(4 * 1024 * 1024);
+}
+
+void BM_Base64Encode(benchmark::State& state) {
+    const std::vector<BYTE> image = oscp::benchmarks::makeRandomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string encoded = oscp::base64_encode(image.data(), static_cast<unsigned int>(image.size()));
+        benchmark::DoNotOptimize(encoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Base64Encode)->Apply(imageSizes);
+
+void BM_Base64Decode(benchmark::State& state) {
+    const std::vector<BYTE> image = oscp::benchmarks::makeRandomBytes(static_cast<size_t>(state.range(0)));
+    const std::string encoded = oscp::base64_encode(image.data(), static_cast<unsigned int>(image.size()));
+    for (auto _ : state) {
+        std::vector<BYTE> decoded = oscp::base64_decode(encoded);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Base64Decode)->Apply(imageSizes);
+
+void BM_Base64DecodeFast(benchmark::State& state) {
+    const std::vector<BYTE> image = oscp::benchmarks::makeRandomBytes(static_cast<size_t>(state.range(0)));
+    const std::string encoded = oscp::base64_encode(image.data(), static_cast<unsigned int>(image.size()));
+    for (auto _ : state) {
+        std::vector<BYTE> decoded = oscp::base64_decode_fast(encoded);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Base64DecodeFast)->Apply(imageSizes);
+
+} // namespace
@@ -0,0 +1,121 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/camera_models.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using oscp::CameraModel;
+using oscp::CameraModelTraits;
+
+const size_t kNumPoints = 4096;
+
+// A 640x480 camera with mild distortion: f = 500, principal point in the center, small coefficients
+template<CameraModel M, typename T>
+std::vector<T> makeParams() {
+    std::vector<T> params;
+    if constexpr (CameraModelTraits<M>::singleFocalLength) {
+        params = {T(500), T(320), T(240)};
+    } else {
+        params = {T(500), T(500), T(320), T(240)};
+    }
+    const T coefficients[] = {T(-0.05), T(0.01), T(0.001), T(-0.001), T(0.0005), T(0.0002), T(0.0001), T(0.0001)};
+    for (size_t i = 0; params.size() < CameraModelTraits<M>::paramCount; i++) {
+        params.push_back(coefficients[i]);
+    }
+    if constexpr (M == CameraModel::FOV) {
+        params.back() = T(0.9); // omega
+    }
+    return params;
+}
+
+// Points in front of the camera that project into the image
+template<typename T>
+void makePoints(std::vector<T>& X, std::vector<T>& Y, std::vector<T>& Z) {
+    std::mt19937 rnd(42);
+    std::uniform_real_distribution<T> lateral(T(-0.6), T(0.6));
+    std::uniform_real_distribution<T> depth(T(1), T(20));
+    X.resize(kNumPoints);
+    Y.resize(kNumPoints);
+    Z.resize(kNumPoints);
+    for (size_t i = 0; i < kNumPoints; i++) {
+        Z[i] = depth(rnd);
+        X[i] = lateral(rnd) * Z[i];
+        Y[i] = lateral(rnd) * Z[i] * T(0.75);
+    }
+}
+
+template<CameraModel M, typename T>
+void BM_ProjectPoints(benchmark::State& state) {
+    const std::vector<T> params = makeParams<M, T>();
+    std::vector<T> X, Y, Z;
+    makePoints(X, Y, Z);
+    std::vector<T> u(kNumPoints), v(kNumPoints);
+    for (auto _ : state) {
+        oscp::projectPoints<M>(params.data(), X.data(), Y.data(), Z.data(), u.data(), v.data(), kNumPoints);
+        benchmark::DoNotOptimize(u.data());
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kNumPoints));
+}
+
+template<CameraModel M, typename T>
+void BM_UnprojectPoints(benchmark::State& state) {
+    const std::vector<T> params = makeParams<M, T>();
+    std::vector<T> X, Y, Z;
+    makePoints(X, Y, Z);
+    std::vector<T> u(kNumPoints), v(kNumPoints), x(kNumPoints), y(kNumPoints);
+    oscp::projectPoints<M>(params.data(), X.data(), Y.data(), Z.data(), u.data(), v.data(), kNumPoints);
+    for (auto _ : state) {
+        oscp::unprojectPoints<M>(params.data(), u.data(), v.data(), x.data(), y.data(), kNumPoints);
+        benchmark::DoNotOptimize(x.data());
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kNumPoints));
+}
+
+template<CameraModel M>
+void BM_BuildUndistortionMap(benchmark::State& state) {
+    const std::vector<double> params = makeParams<M, double>();
+    const size_t width = 640;
+    const size_t height = 480;
+    std::vector<float> mapX(width * height), mapY(width * height);
+    for (auto _ : state) {
+        oscp::buildUndistortionMap<M>(params.data(), width, height, mapX.data(), mapY.data());
+        benchmark::DoNotOptimize(mapX.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(width * height));
+}
+
+#define OSCP_GPP_CAMERA_MODEL_BENCHMARKS(M) \
+    BENCHMARK_TEMPLATE(BM_ProjectPoints, CameraModel::M, float); \
+    BENCHMARK_TEMPLATE(BM_ProjectPoints, CameraModel::M, double); \
+    BENCHMARK_TEMPLATE(BM_UnprojectPoints, CameraModel::M, double); \
+    BENCHMARK_TEMPLATE(BM_BuildUndistortionMap, CameraModel::M)
+
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(SIMPLE_PINHOLE);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(PINHOLE);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(SIMPLE_RADIAL);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(RADIAL);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(OPENCV);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(OPENCV_FISHEYE);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(FULL_OPENCV);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(FOV);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(SIMPLE_RADIAL_FISHEYE);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(RADIAL_FISHEYE);
+OSCP_GPP_CAMERA_MODEL_BENCHMARKS(THIN_PRISM_FISHEYE);
+
+} // namespace
@@ -0,0 +1,260 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "benchmark_data.h"
+
+#include <oscp-gpp/base64.h>
+#include <oscp-gpp/compression.h>
+#include <oscp-gpp/geoposeprotocol_json.h>
+
+#include <benchmark/benchmark.h>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <thread>
+#endif
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// The kinds of request bodies the heuristic has to tell apart
+enum class Payload {
+    IMU, // 1000 samples per IMU sensor, no image
+    JPEG, // one 256 KiB image, which does not compress
+    BATCH // 16 requests with a 16 KiB image and 100 IMU samples each
+};
+
+const char* payloadNames[] = {"IMU", "JPEG", "BATCH"};
+
+std::string makeBody(Payload payload) {
+    switch (payload) {
+    case Payload::IMU:
+        return nlohmann::json(oscp::benchmarks::makeGeoPoseRequest(0, 1000)).dump();
+    case Payload::JPEG:
+        return nlohmann::json(oscp::benchmarks::makeGeoPoseRequest(1, 0, 256 * 1024)).dump();
+    case Payload::BATCH:
+    default: {
+        nlohmann::json batchJson = nlohmann::json::array();
+        for (unsigned int i = 0; i < 16; i++) {
+            oscp::GeoPoseRequest request = oscp::benchmarks::makeGeoPoseRequest(1, 100, 0);
+            const std::vector<BYTE> image = oscp::benchmarks::makeRandomBytes(16 * 1024, i);
+            request.sensorReadings.cameraReadings[0].imageBytes = oscp::base64_encode(image.data(), static_cast<unsigned int>(image.size()));
+            batchJson.push_back(request);
+        }
+        return batchJson.dump();
+    }
+    }
+}
+
+// Every coding this build supports with every payload: {coding, payload}
+void codingsAndPayloads(benchmark::internal::Benchmark* b) {
+    for (oscp::ContentCoding coding : {oscp::ContentCoding::GZIP, oscp::ContentCoding::ZSTD}) {
+        if (!oscp::isContentCodingSupported(coding)) {
+            continue;
+        }
+        for (int payload = 0; payload < 3; payload++) {
+            b->Args({static_cast<int64_t>(coding), payload});
+        }
+    }
+}
+
+void setLabel(benchmark::State& state, oscp::ContentCoding coding, Payload payload) {
+    state.SetLabel(std::string(oscp::toString(coding)) + "/" + payloadNames[static_cast<int>(payload)]);
+}
+
+// CPU cost per body and the bytes it saves
+void BM_Compress(benchmark::State& state) {
+    const oscp::ContentCoding coding = static_cast<oscp::ContentCoding>(state.range(0));
+    const Payload payload = static_cast<Payload>(state.range(1));
+    const std::string body = makeBody(payload);
+    size_t compressedSize = 0;
+    for (auto _ : state) {
+        const std::string compressed = oscp::compressBody(body, coding);
+        compressedSize = compressed.size();
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    setLabel(state, coding, payload);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(body.size()));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+    state.counters["saved_bytes"] = static_cast<double>(body.size()) - static_cast<double>(compressedSize);
+    state.counters["ratio"] = static_cast<double>(compressedSize) / static_cast<double>(body.size());
+}
+BENCHMARK(BM_Compress)->Apply(codingsAndPayloads);
+
+// What the server pays per compressed body, with the cap of the demo server
+void BM_Decompress(benchmark::State& state) {
+    const oscp::ContentCoding coding = static_cast<oscp::ContentCoding>(state.range(0));
+    const Payload payload = static_cast<Payload>(state.range(1));
+    const std::string body = makeBody(payload);
+    const std::string compressed = oscp::compressBody(body, coding);
+    for (auto _ : state) {
+        std::string decompressed;
+        oscp::DecompressionStatus status = oscp::decompressBody(compressed, coding, size_t(64) << 20, decompressed);
+        benchmark::DoNotOptimize(status);
+        benchmark::DoNotOptimize(decompressed.data());
+    }
+    setLabel(state, coding, payload);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(body.size()));
+    state.counters["wire_bytes"] = static_cast<double>(compressed.size());
+}
+BENCHMARK(BM_Decompress)->Apply(codingsAndPayloads);
+
+// The heuristic runs on every body, so it must cost a small fraction of compressing the body
+void BM_ChooseContentCoding(benchmark::State& state) {
+    const oscp::ContentCoding coding = static_cast<oscp::ContentCoding>(state.range(0));
+    const Payload payload = static_cast<Payload>(state.range(1));
+    const std::string body = makeBody(payload);
+    oscp::ContentCoding chosen = oscp::ContentCoding::IDENTITY;
+    for (auto _ : state) {
+        chosen = oscp::chooseContentCoding(body, "application/json", coding);
+        benchmark::DoNotOptimize(chosen);
+    }
+    state.SetLabel(std::string(oscp::toString(coding)) + "/" + payloadNames[static_cast<int>(payload)] + " -> " + std::string(oscp::toString(chosen)));
+}
+BENCHMARK(BM_ChooseContentCoding)->Apply(codingsAndPayloads);
+
+#ifndef _WIN32
+
+// Echoes a one-byte acknowledgement for every length-prefixed body it receives over a loopback TCP connection,
+// after decompressing it like the demo server does
+class LoopbackReceiver {
+public:
+    LoopbackReceiver() {
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        if (listener_ < 0 || bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(listener_, 1) != 0 || getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            throw std::runtime_error("Could not listen on the loopback interface");
+        }
+        thread_ = std::thread([this]() { run(); });
+
+        sender_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (sender_ < 0 || connect(sender_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            throw std::runtime_error("Could not connect on the loopback interface");
+        }
+        const int noDelay = 1;
+        setsockopt(sender_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+
+    ~LoopbackReceiver() {
+        close(sender_); // ends run()
+        thread_.join();
+        close(listener_);
+    }
+
+    // Sends a body and waits until the receiver has decompressed it
+    bool roundTrip(const std::string& body, oscp::ContentCoding coding) {
+        const uint64_t header[2] = {body.size(), static_cast<uint64_t>(coding)};
+        if (!sendAll(sender_, reinterpret_cast<const char*>(header), sizeof(header)) || !sendAll(sender_, body.data(), body.size())) {
+            return false;
+        }
+        char ack = 0;
+        return recvAll(sender_, &ack, 1) && ack == 1;
+    }
+
+private:
+    static bool sendAll(int socket, const char* data, size_t size) {
+        while (size > 0) {
+            const ssize_t sent = send(socket, data, size, 0);
+            if (sent <= 0) {
+                return false;
+            }
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    static bool recvAll(int socket, char* data, size_t size) {
+        while (size > 0) {
+            const ssize_t received = recv(socket, data, size, 0);
+            if (received <= 0) {
+                return false;
+            }
+            data += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    void run() {
+        const int connection = accept(listener_, nullptr, nullptr);
+        if (connection < 0) {
+            return;
+        }
+        std::string body;
+        std::string decompressed;
+        uint64_t header[2];
+        while (recvAll(connection, reinterpret_cast<char*>(header), sizeof(header))) {
+            body.resize(header[0]);
+            if (!recvAll(connection, &body[0], body.size())) {
+                break;
+            }
+            const oscp::ContentCoding coding = static_cast<oscp::ContentCoding>(header[1]);
+            char ack = 1;
+            decompressed.clear();
+            if (coding != oscp::ContentCoding::IDENTITY
+                && oscp::decompressBody(body, coding, size_t(64) << 20, decompressed) != oscp::DecompressionStatus::OK) {
+                ack = 0;
+            }
+            if (!sendAll(connection, &ack, 1)) {
+                break;
+            }
+        }
+        close(connection);
+    }
+
+    int listener_ = -1;
+    int sender_ = -1;
+    std::thread thread_;
+};
+
+// End-to-end time per body over loopback TCP, sent as it is or compressed on the way (compression and decompression
+// included). Loopback has no bandwidth limit to speak of, so this is the worst case for compression;
+// the bytes saved are what a real network gains, at roughly wire_bytes / bandwidth less transfer time.
+void BM_LoopbackRoundTrip(benchmark::State& state) {
+    const oscp::ContentCoding coding = static_cast<oscp::ContentCoding>(state.range(0));
+    const Payload payload = static_cast<Payload>(state.range(1));
+    const std::string body = makeBody(payload);
+    LoopbackReceiver receiver;
+    size_t wireBytes = body.size();
+    for (auto _ : state) {
+        if (coding == oscp::ContentCoding::IDENTITY) {
+            benchmark::DoNotOptimize(receiver.roundTrip(body, coding));
+        } else {
+            const std::string compressed = oscp::compressBody(body, coding);
+            wireBytes = compressed.size();
+            benchmark::DoNotOptimize(receiver.roundTrip(compressed, coding));
+        }
+    }
+    setLabel(state, coding, payload);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(body.size()));
+    state.counters["wire_bytes"] = static_cast<double>(wireBytes);
+}
+BENCHMARK(BM_LoopbackRoundTrip)
+    ->Args({static_cast<int64_t>(oscp::ContentCoding::IDENTITY), static_cast<int64_t>(Payload::IMU)})
+    ->Args({static_cast<int64_t>(oscp::ContentCoding::IDENTITY), static_cast<int64_t>(Payload::JPEG)})
+    ->Args({static_cast<int64_t>(oscp::ContentCoding::IDENTITY), static_cast<int64_t>(Payload::BATCH)})
+    ->Apply(codingsAndPayloads)
+    ->UseRealTime();
+
+#endif // _WIN32
+
+} // namespace
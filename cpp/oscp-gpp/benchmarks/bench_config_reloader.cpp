@@ -0,0 +1,60 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/config_reloader.h>
+#include <oscp-gpp/geopose.h>
+#include <oscp-gpp/geopose_json.h>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+
+namespace {
+
+const nlohmann::json serverConfigJson = {
+    {"geopose", {
+        {"position", {{"lat", 47.6205}, {"lon", -122.3493}, {"h", 184.0}}},
+        {"quaternion", {{"x", 0.0}, {"y", 0.0}, {"z", 0.0}, {"w", 1.0}}}
+    }},
+    {"accuracy", {{"position", 1.0}, {"orientation", 5.0}}},
+    {"fastPath", {{"enabled", true}}},
+    {"responseCache", {{"enabled", true}}}
+};
+
+// How the demo server used to read the fixed pose of every response: seven lookups in the JSON config
+void BM_ServerConfig_JsonLookups(benchmark::State& state) {
+    nlohmann::json config = serverConfigJson;
+    for (auto _ : state) {
+        oscp::GeoPose geopose;
+        geopose.quaternion.x = config["geopose"]["quaternion"]["x"];
+        geopose.quaternion.y = config["geopose"]["quaternion"]["y"];
+        geopose.quaternion.z = config["geopose"]["quaternion"]["z"];
+        geopose.quaternion.w = config["geopose"]["quaternion"]["w"];
+        geopose.position.lat = config["geopose"]["position"]["lat"];
+        geopose.position.lon = config["geopose"]["position"]["lon"];
+        geopose.position.h = config["geopose"]["position"]["h"];
+        benchmark::DoNotOptimize(geopose);
+    }
+}
+BENCHMARK(BM_ServerConfig_JsonLookups);
+
+// And now: the snapshot of the parsed config, taken once per request
+void BM_ServerConfig_Snapshot(benchmark::State& state) {
+    struct ServerConfig {
+        oscp::GeoPose geopose;
+    };
+    const oscp::AtomicSnapshot<ServerConfig> config(std::make_shared<ServerConfig>(ServerConfig{serverConfigJson.at("geopose").get<oscp::GeoPose>()}));
+    for (auto _ : state) {
+        const std::shared_ptr<const ServerConfig> snapshot = config.load();
+        oscp::GeoPose geopose = snapshot->geopose;
+        benchmark::DoNotOptimize(geopose);
+    }
+}
+BENCHMARK(BM_ServerConfig_Snapshot)->ThreadRange(1, 8);
+
+} // namespace
@@ -0,0 +1,59 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/content_negotiation.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+namespace {
+
+// A server that speaks the given number of versions 2.x of the JSON protocol, the newest first
+oscp::ContentNegotiator<int> makeNegotiator(int numVersions) {
+    oscp::ContentNegotiator<int> negotiator;
+    for (int v = numVersions - 1; v >= 0; v--) {
+        negotiator.add("application/vnd.oscp+json", {2, v}, oscp::WireEncoding::JSON, v);
+    }
+    return negotiator;
+}
+
+void versionCounts(benchmark::internal::Benchmark* b) {
+    b->Arg(1)->Arg(4)->Arg(16);
+}
+
+// The Accept header the demo clients send
+void BM_ContentNegotiation_Accept(benchmark::State& state) {
+    const oscp::ContentNegotiator<int> negotiator = makeNegotiator(static_cast<int>(state.range(0)));
+    const std::string_view accept = "application/vnd.oscp+json;version=2.0;";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(negotiator.selectResponse(accept));
+    }
+}
+BENCHMARK(BM_ContentNegotiation_Accept)->Apply(versionCounts);
+
+// A browser-like list of media ranges with q values, matched by the wildcard
+void BM_ContentNegotiation_AcceptList(benchmark::State& state) {
+    const oscp::ContentNegotiator<int> negotiator = makeNegotiator(static_cast<int>(state.range(0)));
+    const std::string_view accept = "text/html, application/xhtml+xml, application/xml;q=0.9, image/webp, */*;q=0.8";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(negotiator.selectResponse(accept));
+    }
+}
+BENCHMARK(BM_ContentNegotiation_AcceptList)->Apply(versionCounts);
+
+void BM_ContentNegotiation_ContentType(benchmark::State& state) {
+    const oscp::ContentNegotiator<int> negotiator = makeNegotiator(static_cast<int>(state.range(0)));
+    const std::string_view contentType = "application/json";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(negotiator.selectRequest(contentType));
+    }
+}
+BENCHMARK(BM_ContentNegotiation_ContentType)->Apply(versionCounts);
+
+} // namespace
@@ -0,0 +1,122 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+// NOTE: geopose_utils.h defines its functions in the header,
+// so it must be included by exactly one translation unit of this target.
+#include <oscp-gpp/geopose_utils.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Reference point in Seattle, same as the example data
+const double kLat = 47.61155;
+const double kLon = -122.337056;
+const double kH = 42.0;
+
+void BM_DegreesToRadians(benchmark::State& state) {
+    double degrees = kLat;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(degrees);
+        double radians = degrees_to_radians(degrees);
+        benchmark::DoNotOptimize(radians);
+    }
+}
+BENCHMARK(BM_DegreesToRadians);
+
+void BM_RadiansToDegrees(benchmark::State& state) {
+    double radians = 0.831;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(radians);
+        double degrees = radians_to_degrees(radians);
+        benchmark::DoNotOptimize(degrees);
+    }
+}
+BENCHMARK(BM_RadiansToDegrees);
+
+void BM_GeodeticToEcef(benchmark::State& state) {
+    double lat = kLat, lon = kLon, h = kH;
+    double x, y, z;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lat);
+        geodetic_to_ecef(lat, lon, h, &x, &y, &z);
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(y);
+        benchmark::DoNotOptimize(z);
+    }
+}
+BENCHMARK(BM_GeodeticToEcef);
+
+void BM_EcefToGeodetic(benchmark::State& state) {
+    double x, y, z;
+    geodetic_to_ecef(kLat, kLon, kH, &x, &y, &z);
+    double lat, lon, h;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        ecef_to_geodetic(x, y, z, &lat, &lon, &h);
+        benchmark::DoNotOptimize(lat);
+        benchmark::DoNotOptimize(lon);
+        benchmark::DoNotOptimize(h);
+    }
+}
+BENCHMARK(BM_EcefToGeodetic);
+
+void BM_EcefToEnu(benchmark::State& state) {
+    double x, y, z;
+    geodetic_to_ecef(kLat + 0.001, kLon + 0.001, kH + 1.0, &x, &y, &z);
+    double east, north, up;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        ecef_to_enu(x, y, z, kLat, kLon, kH, &east, &north, &up);
+        benchmark::DoNotOptimize(east);
+        benchmark::DoNotOptimize(north);
+        benchmark::DoNotOptimize(up);
+    }
+}
+BENCHMARK(BM_EcefToEnu);
+
+void BM_EnuToEcef(benchmark::State& state) {
+    double east = 10.0, north = 20.0, up = 1.5;
+    double x, y, z;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(east);
+        enu_to_ecef(east, north, up, kLat, kLon, kH, &x, &y, &z);
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(y);
+        benchmark::DoNotOptimize(z);
+    }
+}
+BENCHMARK(BM_EnuToEcef);
+
+void BM_GeodeticToEnu(benchmark::State& state) {
+    double lat = kLat + 0.001, lon = kLon + 0.001, h = kH + 1.0;
+    double east, north, up;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lat);
+        geodetic_to_enu(lat, lon, h, kLat, kLon, kH, &east, &north, &up);
+        benchmark::DoNotOptimize(east);
+        benchmark::DoNotOptimize(north);
+        benchmark::DoNotOptimize(up);
+    }
+}
+BENCHMARK(BM_GeodeticToEnu);
+
+void BM_EnuToGeodetic(benchmark::State& state) {
+    double east = 10.0, north = 20.0, up = 1.5;
+    double lat, lon, h;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(east);
+        enu_to_geodetic(east, north, up, kLat, kLon, kH, &lat, &lon, &h);
+        benchmark::DoNotOptimize(lat);
+        benchmark::DoNotOptimize(lon);
+        benchmark::DoNotOptimize(h);
+    }
+}
+BENCHMARK(BM_EnuToGeodetic);
+
+} // namespace
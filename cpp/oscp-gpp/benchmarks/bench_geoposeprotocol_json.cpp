@@ -0,0 +1,278 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "benchmark_data.h"
+
+#include <oscp-gpp/geoposeprotocol.h>
+#include <oscp-gpp/geoposeprotocol_json.h>
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <memory_resource>
+
+namespace {
+
+// {number of camera readings, number of samples per IMU sensor}
+void requestShapes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"cameras", "imu"});
+    for (int64_t cameras : {0, 1, 4}) {
+        for (int64_t imu : {0, 200, 2000}) {
+            b->Args({cameras, imu});
+        }
+    }
+}
+
+oscp::GeoPoseRequest makeRequest(const benchmark::State& state) {
+    return oscp::benchmarks::makeGeoPoseRequest(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+}
+
+void BM_GeoPoseRequest_ToJson(benchmark::State& state) {
+    const oscp::GeoPoseRequest request = makeRequest(state);
+    for (auto _ : state) {
+        json j = request;
+        benchmark::DoNotOptimize(j);
+    }
+}
+BENCHMARK(BM_GeoPoseRequest_ToJson)->Apply(requestShapes);
+
+void BM_GeoPoseRequest_Dump(benchmark::State& state) {
+    const json j = makeRequest(state);
+    for (auto _ : state) {
+        std::string str = j.dump();
+        benchmark::DoNotOptimize(str);
+    }
+}
+BENCHMARK(BM_GeoPoseRequest_Dump)->Apply(requestShapes);
+
+void BM_GeoPoseRequest_FromJson(benchmark::State& state) {
+    const json j = makeRequest(state);
+    for (auto _ : state) {
+        oscp::GeoPoseRequest request = j.get<oscp::GeoPoseRequest>();
+        benchmark::DoNotOptimize(request);
+    }
+}
+BENCHMARK(BM_GeoPoseRequest_FromJson)->Apply(requestShapes);
+
+// Same as above, but the whole request is allocated from a per-request monotonic arena
+void BM_GeoPoseRequest_FromJsonArena(benchmark::State& state) {
+    const json j = makeRequest(state);
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        oscp::GeoPoseRequest request = oscp::parseGeoPoseRequest(j, &arena);
+        benchmark::DoNotOptimize(request);
+    }
+}
+BENCHMARK(BM_GeoPoseRequest_FromJsonArena)->Apply(requestShapes);
+
+// Full server-side path: request body string -> json -> GeoPoseRequest
+void BM_GeoPoseRequest_Parse(benchmark::State& state) {
+    const std::string body = json(makeRequest(state)).dump();
+    for (auto _ : state) {
+        oscp::GeoPoseRequest request = json::parse(body).get<oscp::GeoPoseRequest>();
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+}
+BENCHMARK(BM_GeoPoseRequest_Parse)->Apply(requestShapes);
+
+// Same as above with the IMU samples sent as columnar blocks instead of per-sample readings
+void BM_GeoPoseRequest_ParseImuBlocks(benchmark::State& state) {
+    const std::string body = json(oscp::benchmarks::toImuReadingBlocks(makeRequest(state))).dump();
+    for (auto _ : state) {
+        oscp::GeoPoseRequest request = json::parse(body).get<oscp::GeoPoseRequest>();
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+}
+BENCHMARK(BM_GeoPoseRequest_ParseImuBlocks)->Apply(requestShapes);
+
+// Same as BM_GeoPoseRequest_Parse with the repeated per-reading privacy factored out into the request-level default
+void BM_GeoPoseRequest_ParseSharedPrivacy(benchmark::State& state) {
+    oscp::GeoPoseRequest sharedPrivacyRequest = makeRequest(state);
+    oscp::factorOutPrivacy(sharedPrivacyRequest);
+    const std::string body = json(sharedPrivacyRequest).dump();
+    for (auto _ : state) {
+        oscp::GeoPoseRequest request = json::parse(body).get<oscp::GeoPoseRequest>();
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+}
+BENCHMARK(BM_GeoPoseRequest_ParseSharedPrivacy)->Apply(requestShapes);
+
+// Same as BM_GeoPoseRequest_Parse for a frame of a session: sensors, privacy and camera params come from the GeoPoseSession
+void BM_GeoPoseFrame_Parse(benchmark::State& state) {
+    oscp::GeoPoseRequest frame = oscp::benchmarks::toImuReadingBlocks(makeRequest(state));
+    oscp::GeoPoseSession session;
+    session.sensors = frame.sensors;
+    session.privacy = oscp::benchmarks::makePrivacy();
+    for (oscp::CameraReading& reading : frame.sensorReadings.cameraReadings) {
+        oscp::SessionCamera& camera = session.cameras.emplace_back();
+        camera.sensorId = reading.sensorId;
+        camera.params = reading.params;
+        reading.params = oscp::CameraParameters();
+    }
+    // Every reading inherits the session privacy
+    auto inheritPrivacy = [](auto& readings) {
+        for (auto& reading : readings) {
+            reading.privacy.reset();
+        }
+    };
+    inheritPrivacy(frame.sensorReadings.cameraReadings);
+    inheritPrivacy(frame.sensorReadings.geolocationReadings);
+    inheritPrivacy(frame.sensorReadings.accelerometerBlocks);
+    inheritPrivacy(frame.sensorReadings.gyroscopeBlocks);
+    inheritPrivacy(frame.sensorReadings.magnetometerBlocks);
+    json frameJson = frame;
+    frameJson.erase("sensors");
+    const std::string body = frameJson.dump();
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(body.size());
+        oscp::GeoPoseRequest request = oscp::parseGeoPoseFrame(json::parse(body), session, &arena);
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+    state.counters["body_bytes"] = static_cast<double>(body.size());
+}
+BENCHMARK(BM_GeoPoseFrame_Parse)->Apply(requestShapes);
+
+// Many sensors and camera readings with tiny images, so the per-reading work (e.g. the enum conversions) dominates
+void BM_GeoPoseRequest_ParseManyCameras(benchmark::State& state) {
+    const std::string body = json(oscp::benchmarks::makeGeoPoseRequest(static_cast<size_t>(state.range(0)), 0, 16)).dump();
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena(body.size());
+        oscp::GeoPoseRequest request = oscp::parseGeoPoseRequest(json::parse(body), &arena);
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(BM_GeoPoseRequest_ParseManyCameras)->ArgName("cameras")->Arg(100)->Arg(500);
+
+void BM_GeoPoseRequest_ToJsonManyCameras(benchmark::State& state) {
+    const oscp::GeoPoseRequest request = oscp::benchmarks::makeGeoPoseRequest(static_cast<size_t>(state.range(0)), 0, 16);
+    for (auto _ : state) {
+        json j = request;
+        benchmark::DoNotOptimize(j);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+BENCHMARK(BM_GeoPoseRequest_ToJsonManyCameras)->ArgName("cameras")->Arg(100)->Arg(500);
+
+// Same as BM_GeoPoseRequest_FromJsonArena through tryParseGeoPoseRequest, which reports errors without exceptions
+void BM_GeoPoseRequest_TryParseArena(benchmark::State& state) {
+    const json j = makeRequest(state);
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        oscp::ParseResult<oscp::GeoPoseRequest> request = oscp::tryParseGeoPoseRequest(j, &arena);
+        benchmark::DoNotOptimize(request);
+    }
+}
+BENCHMARK(BM_GeoPoseRequest_TryParseArena)->Apply(requestShapes);
+
+// A small request (1 camera with a tiny image, 8 IMU samples per sensor) broken in one of several ways,
+// so that the cost of rejecting it is not hidden behind the cost of parsing a large body.
+// The defects sit late in the document, so most of it is read before they are found.
+const char* const invalidRequestKinds[] = {"malformed_json", "missing_field", "wrong_type", "unknown_enum", "undeclared_sensor"};
+
+std::string makeInvalidRequestBody(int64_t kind) {
+    json j = oscp::benchmarks::toImuReadingBlocks(oscp::benchmarks::makeGeoPoseRequest(1, 8, 64));
+    json& camera = j["sensorReadings"]["cameraReadings"][0];
+    switch (kind) {
+    case 0:
+        return j.dump().substr(0, j.dump().size() - 2);
+    case 1:
+        camera["imageOrientation"].erase("mirrored");
+        break;
+    case 2:
+        j["sensorReadings"]["magnetometerBlocks"][0]["z"].back() = "0.5";
+        break;
+    case 3:
+        camera["imageFormat"] = "PNG";
+        break;
+    default:
+        j["sensorReadings"]["magnetometerBlocks"][0]["sensorId"] = "undeclared";
+        break;
+    }
+    return j.dump();
+}
+
+void invalidRequestKindArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("kind");
+    for (int64_t kind = 0; kind < static_cast<int64_t>(std::size(invalidRequestKinds)); kind++) {
+        b->Arg(kind);
+    }
+}
+
+// Rejecting invalid requests the throwing way: json::parse and parseGeoPoseRequest, with the exception caught by the handler
+void BM_GeoPoseRequest_RejectThrowing(benchmark::State& state) {
+    const std::string body = makeInvalidRequestBody(state.range(0));
+    for (auto _ : state) {
+        try {
+            std::pmr::monotonic_buffer_resource arena(body.size());
+            oscp::GeoPoseRequest request = oscp::parseGeoPoseRequest(json::parse(body), &arena);
+            benchmark::DoNotOptimize(request);
+        } catch (std::exception& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+    state.SetLabel(invalidRequestKinds[state.range(0)]);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GeoPoseRequest_RejectThrowing)->Apply(invalidRequestKindArgs);
+
+// Rejecting the same requests like the server does: tryParseJson and tryParseGeoPoseRequest, without any exception
+void BM_GeoPoseRequest_RejectTryParse(benchmark::State& state) {
+    const std::string body = makeInvalidRequestBody(state.range(0));
+    for (auto _ : state) {
+        oscp::ParseResult<json> j = oscp::tryParseJson(body);
+        if (!j) {
+            benchmark::DoNotOptimize(j.error());
+            continue;
+        }
+        std::pmr::monotonic_buffer_resource arena(body.size());
+        oscp::ParseResult<oscp::GeoPoseRequest> request = oscp::tryParseGeoPoseRequest(*j, &arena);
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetLabel(invalidRequestKinds[state.range(0)]);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GeoPoseRequest_RejectTryParse)->Apply(invalidRequestKindArgs);
+
+// All names of an enum, converted back and forth
+void BM_CameraModel_StringRoundTrip(benchmark::State& state) {
+    const oscp::CameraModel models[] = {
+        oscp::CameraModel::SIMPLE_PINHOLE, oscp::CameraModel::PINHOLE, oscp::CameraModel::SIMPLE_RADIAL,
+        oscp::CameraModel::RADIAL, oscp::CameraModel::OPENCV, oscp::CameraModel::OPENCV_FISHEYE,
+        oscp::CameraModel::FULL_OPENCV, oscp::CameraModel::FOV, oscp::CameraModel::SIMPLE_RADIAL_FISHEYE,
+        oscp::CameraModel::RADIAL_FISHEYE, oscp::CameraModel::THIN_PRISM_FISHEYE
+    };
+    for (auto _ : state) {
+        for (oscp::CameraModel model : models) {
+            oscp::CameraModel parsed = oscp::cameraModelFromString(oscp::toString(model));
+            benchmark::DoNotOptimize(parsed);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(models)));
+}
+BENCHMARK(BM_CameraModel_StringRoundTrip);
+
+// GeoPoseResponse -> string -> GeoPoseResponse, as done by the server and the client
+void BM_GeoPoseResponse_RoundTrip(benchmark::State& state) {
+    const oscp::GeoPoseResponse response = oscp::benchmarks::makeGeoPoseResponse();
+    for (auto _ : state) {
+        const std::string str = json(response).dump();
+        oscp::GeoPoseResponse parsed = json::parse(str).get<oscp::GeoPoseResponse>();
+        benchmark::DoNotOptimize(parsed);
+    }
+}
+BENCHMARK(BM_GeoPoseResponse_RoundTrip);
+
+} // namespace
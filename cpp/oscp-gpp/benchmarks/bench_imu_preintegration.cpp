@@ -0,0 +1,58 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/imu_preintegration.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+
+// Samples every 5 ms (200 Hz), the accelerometer offset by 2 ms so it has to be interpolated
+oscp::ImuReadingBlock makeImuBlock(size_t count, std::time_t offset, float scale) {
+    std::mt19937 rnd(42);
+    std::normal_distribution<float> dist(0.0f, scale);
+    oscp::ImuReadingBlock block;
+    block.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        block.push_back(1700000000000 + offset + static_cast<std::time_t>(i) * 5, dist(rnd), dist(rnd), dist(rnd));
+    }
+    return block;
+}
+
+void BM_PreintegrateImu(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    const oscp::ImuReadingBlock gyroscope = makeImuBlock(count, 0, 0.5f);
+    const oscp::ImuReadingBlock accelerometer = makeImuBlock(count, 2, 9.81f);
+    const std::time_t begin = gyroscope.timestamps.front();
+    const std::time_t end = gyroscope.timestamps.back() + 5;
+    oscp::ImuBias bias;
+    bias.gyroscope[2] = 0.01;
+    for (auto _ : state) {
+        oscp::ImuPreintegration delta = oscp::preintegrateImu(oscp::ImuSamples(gyroscope), oscp::ImuSamples(accelerometer), begin, end, bias);
+        benchmark::DoNotOptimize(delta);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_PreintegrateImu)->Arg(20)->Arg(200)->Arg(2000);
+
+void BM_PreintegrateImu_GyroscopeOnly(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    const oscp::ImuReadingBlock gyroscope = makeImuBlock(count, 0, 0.5f);
+    const std::time_t begin = gyroscope.timestamps.front();
+    const std::time_t end = gyroscope.timestamps.back() + 5;
+    for (auto _ : state) {
+        oscp::ImuPreintegration delta = oscp::preintegrateImu(oscp::ImuSamples(gyroscope), oscp::ImuSamples(), begin, end);
+        benchmark::DoNotOptimize(delta);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_PreintegrateImu_GyroscopeOnly)->Arg(20)->Arg(200)->Arg(2000);
+
+} // namespace
@@ -0,0 +1,59 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/map_shard_index.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+
+// City-sized shards (about 0.2 x 0.3 degrees) scattered over the inhabited latitudes
+oscp::MapShardIndex makeIndex(size_t numShards) {
+    std::mt19937 rnd(42);
+    std::uniform_real_distribution<double> latDist(-55.0, 70.0);
+    std::uniform_real_distribution<double> lonDist(-179.0, 179.0);
+    std::vector<oscp::MapShard> shards(numShards);
+    for (size_t i = 0; i < numShards; i++) {
+        const double lat = latDist(rnd);
+        const double lon = lonDist(rnd);
+        shards[i].id = "shard_" + std::to_string(i);
+        shards[i].bounds = {lat, lon, lat + 0.2, lon + 0.3};
+    }
+    return oscp::MapShardIndex(shards);
+}
+
+void BM_MapShardIndex_FindCovered(benchmark::State& state) {
+    const oscp::MapShardIndex index = makeIndex(static_cast<size_t>(state.range(0)));
+    const oscp::GeoBoundingBox& bounds = index.shards().front().bounds;
+    double lat = bounds.minLat + 0.1;
+    double lon = bounds.minLon + 0.1;
+    size_t results[4];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lat);
+        size_t count = index.find(lat, lon, results, 4);
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(BM_MapShardIndex_FindCovered)->Arg(10)->Arg(1000)->Arg(100000);
+
+void BM_MapShardIndex_FindNoCoverage(benchmark::State& state) {
+    const oscp::MapShardIndex index = makeIndex(static_cast<size_t>(state.range(0)));
+    double lat = -80.0; // Antarctica, no shards there
+    double lon = 0.0;
+    size_t results[4];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lat);
+        size_t count = index.find(lat, lon, results, 4);
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(BM_MapShardIndex_FindNoCoverage)->Arg(10)->Arg(1000)->Arg(100000);
+
+} // namespace
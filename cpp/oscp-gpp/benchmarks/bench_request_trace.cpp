@@ -0,0 +1,69 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/request_trace.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// The spans the demo server records for a POST /geopose
+void traceRequest(oscp::RequestTrace* trace) {
+    oscp::TraceSpan request(trace, "request");
+    { oscp::TraceSpan span(trace, "negotiate"); }
+    { oscp::TraceSpan span(trace, "body"); }
+    { oscp::TraceSpan span(trace, "parse"); }
+    { oscp::TraceSpan span(trace, "sensors"); }
+    {
+        oscp::TraceSpan localize(trace, "localize");
+        { oscp::TraceSpan span(trace, "cameras"); }
+        { oscp::TraceSpan span(trace, "backend"); }
+    }
+    { oscp::TraceSpan span(trace, "serialize"); }
+}
+
+// What every traced request pays, i.e. with X-OSCP-Debug: timing or a trace log
+void BM_RequestTrace_Spans(benchmark::State& state) {
+    for (auto _ : state) {
+        oscp::RequestTrace trace("POST /geopose");
+        traceRequest(&trace);
+        benchmark::DoNotOptimize(trace.size());
+    }
+}
+BENCHMARK(BM_RequestTrace_Spans);
+
+// What every other request pays
+void BM_RequestTrace_Disabled(benchmark::State& state) {
+    oscp::RequestTrace* trace = nullptr;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trace);
+        traceRequest(trace);
+    }
+}
+BENCHMARK(BM_RequestTrace_Disabled);
+
+void BM_RequestTrace_ServerTiming(benchmark::State& state) {
+    oscp::RequestTrace trace("POST /geopose");
+    traceRequest(&trace);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trace.serverTiming());
+    }
+}
+BENCHMARK(BM_RequestTrace_ServerTiming);
+
+void BM_TraceLog_Add(benchmark::State& state) {
+    oscp::TraceLog log(1000);
+    oscp::RequestTrace trace("POST /geopose");
+    traceRequest(&trace);
+    for (auto _ : state) {
+        log.add(trace);
+    }
+}
+BENCHMARK(BM_TraceLog_Add);
+
+} // namespace
@@ -0,0 +1,67 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "benchmark_data.h"
+
+#include <oscp-gpp/base64.h>
+#include <oscp-gpp/hash.h>
+#include <oscp-gpp/response_cache.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Same range as the base64 benchmarks, so the cost of hashing compares directly to decoding
+void imageSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(16 * 1024)->Arg(64 * 1024)->Arg(256 * 1024)->Arg(1024 * 1024)->Arg(4 * 1024 * 1024);
+}
+
+void BM_Xxh64(benchmark::State& state) {
+    const std::vector<BYTE> image = oscp::benchmarks::makeRandomBytes(static_cast<size_t>(state.range(0)));
+    const std::string encoded = oscp::base64_encode(image.data(), static_cast<unsigned int>(image.size()));
+    for (auto _ : state) {
+        uint64_t hash = oscp::xxh64(encoded);
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Xxh64)->Apply(imageSizes);
+
+// Key of a request with one camera frame, i.e. the work done before every cache lookup
+void BM_ResponseCache_Key(benchmark::State& state) {
+    const oscp::GeoPoseRequest request = oscp::benchmarks::makeGeoPoseRequest(1, 0, static_cast<size_t>(state.range(0)));
+    const oscp::ResponseCache cache;
+    for (auto _ : state) {
+        uint64_t key = 0;
+        benchmark::DoNotOptimize(cache.key(request, key));
+        benchmark::DoNotOptimize(key);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ResponseCache_Key)->Apply(imageSizes);
+
+// Lookups from several threads with a warm cache, to see lock contention between shards
+void BM_ResponseCache_FindHit(benchmark::State& state) {
+    static oscp::ResponseCache cache;
+    const uint64_t numKeys = 1024;
+    if (state.thread_index() == 0) {
+        const oscp::GeoPoseResponse response = oscp::benchmarks::makeGeoPoseResponse();
+        for (uint64_t i = 0; i < numKeys; i++) {
+            cache.insert(oscp::xxh64(&i, sizeof(i)), response);
+        }
+    }
+    uint64_t i = static_cast<uint64_t>(state.thread_index());
+    oscp::GeoPoseResponse response;
+    for (auto _ : state) {
+        const uint64_t n = i++ % numKeys;
+        benchmark::DoNotOptimize(cache.find(oscp::xxh64(&n, sizeof(n)), response));
+    }
+}
+BENCHMARK(BM_ResponseCache_FindHit)->ThreadRange(1, 8);
+
+} // namespace
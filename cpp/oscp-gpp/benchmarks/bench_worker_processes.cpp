@@ -0,0 +1,278 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "benchmark_data.h"
+
+#include <oscp-gpp/geoposeprotocol_json.h>
+#include <oscp-gpp/worker_pool.h>
+#include <oscp-gpp/worker_processes.h>
+
+#include <benchmark/benchmark.h>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool sendAll(int socket, const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t sent = send(socket, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+// Reads one HTTP message with a Content-Length into message, returns the offset of its body or 0 on failure
+size_t recvMessage(int socket, std::string& message) {
+    message.clear();
+    char buffer[16 * 1024];
+    size_t bodyOffset = 0;
+    size_t contentLength = 0;
+    while (bodyOffset == 0 || message.size() < bodyOffset + contentLength) {
+        const ssize_t received = recv(socket, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return 0;
+        }
+        message.append(buffer, static_cast<size_t>(received));
+        if (bodyOffset == 0) {
+            const size_t headerEnd = message.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) {
+                continue;
+            }
+            bodyOffset = headerEnd + 4;
+            const size_t lengthPos = message.find("Content-Length: ");
+            contentLength = lengthPos < headerEnd ? std::strtoul(message.c_str() + lengthPos + 16, nullptr, 10) : 0;
+        }
+    }
+    return bodyOffset;
+}
+
+int listenOnLoopback(uint16_t port, bool reusePort, int backlog) {
+    const int listener = socket(AF_INET, SOCK_STREAM, 0);
+    const int yes = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    if (reusePort) {
+        oscp::enableReusePort(listener);
+    }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || (backlog > 0 && listen(listener, backlog) != 0)) {
+        throw std::runtime_error("Could not listen on the loopback interface");
+    }
+    return listener;
+}
+
+// One worker process like the demo server runs it: one thread accepts, a pool of threads answers one request per connection,
+// parsing the GeoPoseRequest and serializing a GeoPoseResponse
+[[noreturn]] void serveWorker(uint16_t port, size_t threads, int readyPipe) {
+    const int listener = listenOnLoopback(port, true, 1024);
+    const char ready = 1;
+    if (write(readyPipe, &ready, 1) != 1) {
+        _exit(1);
+    }
+    const std::string response = nlohmann::json(oscp::benchmarks::makeGeoPoseResponse()).dump();
+    oscp::WorkerPool pool(threads);
+    for (;;) {
+        const int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0) {
+            continue;
+        }
+        pool.submit([connection, &response]() {
+            std::string message;
+            const size_t bodyOffset = recvMessage(connection, message);
+            if (bodyOffset > 0) {
+                std::pmr::monotonic_buffer_resource arena(message.size() - bodyOffset);
+                oscp::ParseResult<nlohmann::json> requestJson = oscp::tryParseJson(std::string_view(message).substr(bodyOffset));
+                const bool ok = requestJson && oscp::tryParseGeoPoseRequest(*requestJson, &arena);
+                const std::string reply = std::string(ok ? "HTTP/1.1 200 OK" : "HTTP/1.1 400 Bad Request")
+                    + "\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " + std::to_string(response.size())
+                    + "\r\n\r\n" + response;
+                sendAll(connection, reply.data(), reply.size());
+            }
+            close(connection);
+        });
+    }
+}
+
+// A WorkerSupervisor in its own process with the given number of workers sharing a loopback port
+class WorkerProcesses {
+public:
+    WorkerProcesses(size_t workers, size_t threadsPerWorker) {
+        // Holds the port without listening, a socket that does not listen gets no connections
+        reservation_ = listenOnLoopback(0, true, 0);
+        sockaddr_in address = {};
+        socklen_t length = sizeof(address);
+        getsockname(reservation_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+
+        int readyPipe[2];
+        if (pipe(readyPipe) != 0) {
+            throw std::runtime_error("Could not create a pipe");
+        }
+        supervisor_ = fork();
+        if (supervisor_ == 0) {
+            close(readyPipe[0]);
+            oscp::SupervisorPolicy policy;
+            policy.workers = workers;
+            oscp::WorkerSupervisor supervisor(policy);
+            const std::optional<size_t> worker = supervisor.run();
+            if (worker) {
+                serveWorker(port_, threadsPerWorker, readyPipe[1]);
+            }
+            _exit(0);
+        }
+        close(readyPipe[1]);
+        for (size_t i = 0; i < workers; i++) {
+            char ready = 0;
+            if (read(readyPipe[0], &ready, 1) != 1) {
+                throw std::runtime_error("A worker process did not start");
+            }
+        }
+        close(readyPipe[0]);
+    }
+
+    ~WorkerProcesses() {
+        kill(supervisor_, SIGTERM);
+        waitpid(supervisor_, nullptr, 0);
+        close(reservation_);
+    }
+
+    uint16_t port() const {
+        return port_;
+    }
+
+private:
+    int reservation_ = -1;
+    uint16_t port_ = 0;
+    pid_t supervisor_ = -1;
+};
+
+// Client threads that send the same request over a new connection each, in rounds started by run()
+class LoadGenerator {
+public:
+    LoadGenerator(uint16_t port, size_t clients, std::string request) : port_(port), request_(std::move(request)) {
+        for (size_t i = 0; i < clients; i++) {
+            threads_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~LoadGenerator() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    // Sends the request the given number of times, returns the number of successful responses
+    size_t run(size_t requests) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        remaining_ = requests;
+        pending_ = requests;
+        succeeded_ = 0;
+        start_.notify_all();
+        done_.wait(lock, [this] { return pending_ == 0; });
+        return succeeded_;
+    }
+
+private:
+    bool roundTrip(std::string& message) const {
+        const int connection = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port_);
+        const bool ok = connection >= 0 && connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+            && sendAll(connection, request_.data(), request_.size()) && recvMessage(connection, message) > 0
+            && message.compare(0, 12, "HTTP/1.1 200") == 0;
+        close(connection);
+        return ok;
+    }
+
+    void work() {
+        std::string message;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            start_.wait(lock, [this] { return stopping_ || remaining_ > 0; });
+            if (stopping_) {
+                return;
+            }
+            remaining_--;
+            lock.unlock();
+            const bool ok = roundTrip(message);
+            lock.lock();
+            succeeded_ += ok ? 1 : 0;
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    const uint16_t port_;
+    const std::string request_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    size_t remaining_ = 0;
+    size_t pending_ = 0;
+    size_t succeeded_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+// Requests per second of 1 to N worker processes with SO_REUSEPORT on one loopback port, with the same total number of
+// server threads, so that the difference is one accept socket and one heap versus one per process. Each request opens
+// a connection, like clients that do not keep their connections alive, which is where one accept thread falls behind first.
+void BM_WorkerProcesses_Throughput(benchmark::State& state) {
+    const size_t workers = static_cast<size_t>(state.range(0));
+    const size_t hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const std::string body = nlohmann::json(oscp::benchmarks::makeGeoPoseRequest(1, 0, 16 * 1024)).dump();
+    const std::string request = "POST /geopose HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\nContent-Length: "
+        + std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    WorkerProcesses processes(workers, std::max<size_t>(hardwareThreads / workers, 1));
+    LoadGenerator load(processes.port(), 2 * hardwareThreads, request);
+    constexpr size_t requestsPerIteration = 64;
+    size_t succeeded = 0;
+    for (auto _ : state) {
+        succeeded += load.run(requestsPerIteration);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(succeeded));
+    state.counters["failed"] = static_cast<double>(state.iterations() * requestsPerIteration - succeeded);
+}
+BENCHMARK(BM_WorkerProcesses_Throughput)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+#endif // _WIN32
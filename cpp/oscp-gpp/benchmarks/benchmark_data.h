@@ -0,0 +1,160 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_BENCHMARK_DATA_H_
+#define _OSCP_BENCHMARK_DATA_H_
+
+#include <oscp-gpp/base64.h>
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oscp {
+namespace benchmarks {
+
+// Deterministic pseudo-random bytes, so that results are comparable between runs
+inline std::vector<BYTE> makeRandomBytes(size_t size, unsigned int seed = 42) {
+    std::mt19937 rnd(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<BYTE> bytes(size);
+    for (BYTE& b : bytes) {
+        b = static_cast<BYTE>(dist(rnd));
+    }
+    return bytes;
+}
+
+inline Privacy makePrivacy() {
+    Privacy privacy;
+    privacy.dataRetention = {"oscp:retention:none"};
+    privacy.dataAcceptableUse = {"oscp:use:localization"};
+    privacy.dataSanitizationApplied = {"oscp:sanitization:faces"};
+    privacy.dataSanitizationRequested = {"oscp:sanitization:license-plates"};
+    return privacy;
+}
+
+template<typename ReadingType>
+inline std::pmr::vector<ReadingType> makeImuReadings(std::string_view sensorId, size_t count, std::time_t timestamp) {
+    std::pmr::vector<ReadingType> readings(count);
+    for (size_t i = 0; i < count; i++) {
+        ReadingType& reading = readings[i];
+        reading.timestamp = timestamp + static_cast<std::time_t>(i) * 5; // 200 Hz
+        reading.sensorId = sensorId;
+        reading.privacy = makePrivacy();
+        reading.x = 0.01f * i;
+        reading.y = -0.02f * i;
+        reading.z = 9.81f;
+    }
+    return readings;
+}
+
+// Assembles a request similar to what the demo client sends,
+// with a configurable number of cameras and IMU samples per IMU sensor.
+inline GeoPoseRequest makeGeoPoseRequest(size_t numCameras, size_t numImuSamples, size_t imageSize = 64 * 1024) {
+    const std::time_t timestamp = 1700000000000;
+
+    GeoPoseRequest request;
+    request.id = "2b4d3c4e-7c52-4ae6-8f1a-6a2f3d5c9e10";
+    request.timestamp = timestamp;
+
+    const std::vector<BYTE> image = makeRandomBytes(imageSize);
+    const std::string imageBase64 = base64_encode(image.data(), static_cast<unsigned int>(image.size()));
+    for (size_t c = 0; c < numCameras; c++) {
+        Sensor cameraSensor;
+        cameraSensor.id = "camera_0" + std::to_string(c);
+        cameraSensor.type = SensorType::CAMERA;
+        cameraSensor.name = "benchmark_camera";
+        cameraSensor.model = "OPENCV";
+        cameraSensor.rigIdentifier = "rig";
+        request.sensors.push_back(cameraSensor);
+
+        CameraReading cameraReading;
+        cameraReading.timestamp = timestamp;
+        cameraReading.sensorId = cameraSensor.id;
+        cameraReading.privacy = makePrivacy();
+        cameraReading.sequenceNumber = c;
+        cameraReading.imageFormat = ImageFormat::JPG;
+        cameraReading.size[0] = 1920;
+        cameraReading.size[1] = 1080;
+        cameraReading.imageBytes = imageBase64;
+        cameraReading.params.model = CameraModel::OPENCV;
+        cameraReading.params.modelParams = {1499.027f, 1499.027f, 954.783f, 511.957f, 0.0f, 0.0f, 0.0f, 0.0f};
+        request.sensorReadings.cameraReadings.push_back(cameraReading);
+    }
+
+    Sensor geolocationSensor;
+    geolocationSensor.id = "geolocation_00";
+    geolocationSensor.type = SensorType::GEOLOCATION;
+    request.sensors.push_back(geolocationSensor);
+
+    GeolocationReading geolocationReading;
+    geolocationReading.timestamp = timestamp;
+    geolocationReading.sensorId = geolocationSensor.id;
+    geolocationReading.privacy = makePrivacy();
+    geolocationReading.latitude = 47.61155f;
+    geolocationReading.longitude = -122.337056f;
+    geolocationReading.altitude = 42.0f;
+    request.sensorReadings.geolocationReadings.push_back(geolocationReading);
+
+    if (numImuSamples > 0) {
+        Sensor accelerometerSensor;
+        accelerometerSensor.id = "accelerometer_00";
+        accelerometerSensor.type = SensorType::ACCELEROMETER;
+        request.sensors.push_back(accelerometerSensor);
+        Sensor gyroscopeSensor;
+        gyroscopeSensor.id = "gyroscope_00";
+        gyroscopeSensor.type = SensorType::GYROSCOPE;
+        request.sensors.push_back(gyroscopeSensor);
+        Sensor magnetometerSensor;
+        magnetometerSensor.id = "magnetometer_00";
+        magnetometerSensor.type = SensorType::MAGNETOMETER;
+        request.sensors.push_back(magnetometerSensor);
+
+        request.sensorReadings.accelerometerReadings = makeImuReadings<AccelerometerReading>(accelerometerSensor.id, numImuSamples, timestamp);
+        request.sensorReadings.gyroscopeReadings = makeImuReadings<GyroscopeReading>(gyroscopeSensor.id, numImuSamples, timestamp);
+        request.sensorReadings.magnetometerReadings = makeImuReadings<MagnetometerReading>(magnetometerSensor.id, numImuSamples, timestamp);
+    }
+
+    return request;
+}
+
+// Moves the per-sample IMU readings of a request into the columnar block form
+inline GeoPoseRequest toImuReadingBlocks(GeoPoseRequest request) {
+    SensorReadings& readings = request.sensorReadings;
+    appendImuReadingBlocks(readings.accelerometerReadings, readings.accelerometerBlocks);
+    appendImuReadingBlocks(readings.gyroscopeReadings, readings.gyroscopeBlocks);
+    appendImuReadingBlocks(readings.magnetometerReadings, readings.magnetometerBlocks);
+    readings.accelerometerReadings.clear();
+    readings.gyroscopeReadings.clear();
+    readings.magnetometerReadings.clear();
+    return request;
+}
+
+inline GeoPoseResponse makeGeoPoseResponse() {
+    GeoPoseResponse response;
+    response.id = "2b4d3c4e-7c52-4ae6-8f1a-6a2f3d5c9e10";
+    response.timestamp = 1700000000000;
+    response.accuracy.position = 0.5f;
+    response.accuracy.orientation = 2.0f;
+    response.geopose.position.lat = 47.6115384295607;
+    response.geopose.position.lon = -122.33708368127326;
+    response.geopose.position.h = 0.22144008012467678;
+    response.geopose.quaternion.x = 0.08266119195898472;
+    response.geopose.quaternion.y = 0.10515208816750739;
+    response.geopose.quaternion.z = 0.6147199120504097;
+    response.geopose.quaternion.w = -0.7773220667308173;
+    return response;
+}
+
+} // namespace benchmarks
+} // namespace oscp
+
+#endif // _OSCP_BENCHMARK_DATA_H_
@@ -0,0 +1,32 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/base64.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// Differential fuzzing of the scalar and the table-driven base64 decoder,
+// plus the round trip through base64_encode() of whatever was decoded
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const std::string encoded(reinterpret_cast<const char*>(data), size);
+
+    const std::vector<BYTE> scalar = oscp::base64_decode(encoded);
+    const std::vector<BYTE> fast = oscp::base64_decode_fast(encoded);
+    if (scalar != fast) {
+        std::abort();
+    }
+
+    const std::string reencoded = oscp::base64_encode(scalar.data(), static_cast<unsigned int>(scalar.size()));
+    if (oscp::base64_decode(reencoded) != scalar || oscp::base64_decode_fast(reencoded) != scalar) {
+        std::abort();
+    }
+    return 0;
+}
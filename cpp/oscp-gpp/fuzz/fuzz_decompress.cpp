@@ -0,0 +1,67 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/compression.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+// The limit is small so that the fuzzer finds bombs quickly
+constexpr size_t maxDecompressedBytes = 1 << 20;
+
+// Decompresses the input the way the server does with a request body. The first byte selects the coding (lowest bit:
+// gzip or zstd) and the size of the chunks the body arrives in, the rest is the body.
+// Besides crashes and sanitizer findings, the target aborts when the decompressed size exceeds the limit,
+// when chunked and whole-body decompression disagree, or when a decompressed body does not survive a round trip.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    const oscp::ContentCoding coding = (data[0] & 1) ? oscp::ContentCoding::ZSTD : oscp::ContentCoding::GZIP;
+    if (!oscp::isContentCodingSupported(coding)) {
+        return 0;
+    }
+    const size_t chunkSize = (data[0] >> 1) + 1;
+    const std::string_view body(reinterpret_cast<const char*>(data + 1), size - 1);
+
+    std::string whole;
+    const oscp::DecompressionStatus wholeStatus = oscp::decompressBody(body, coding, maxDecompressedBytes, whole);
+    if (whole.size() > maxDecompressedBytes + 1) {
+        std::abort();
+    }
+
+    oscp::Decompressor decompressor(coding, maxDecompressedBytes);
+    std::string chunked;
+    oscp::DecompressionStatus chunkedStatus = oscp::DecompressionStatus::OK;
+    for (size_t offset = 0; offset < body.size() && chunkedStatus == oscp::DecompressionStatus::OK; offset += chunkSize) {
+        chunkedStatus = decompressor.write(body.data() + offset, std::min(chunkSize, body.size() - offset), chunked);
+    }
+    if (chunkedStatus == oscp::DecompressionStatus::OK) {
+        chunkedStatus = decompressor.finish();
+    }
+    if (chunkedStatus != wholeStatus) {
+        std::abort();
+    }
+    if (wholeStatus != oscp::DecompressionStatus::OK) {
+        return 0;
+    }
+    if (chunked != whole || decompressor.decompressedBytes() != whole.size()) {
+        std::abort();
+    }
+
+    std::string roundTrip;
+    if (oscp::decompressBody(oscp::compressBody(whole, coding), coding, maxDecompressedBytes, roundTrip) != oscp::DecompressionStatus::OK
+        || roundTrip != whole) {
+        std::abort();
+    }
+    return 0;
+}
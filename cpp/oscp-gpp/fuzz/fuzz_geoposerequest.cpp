@@ -0,0 +1,50 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/geoposeprotocol_json.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+
+// Parses the input as a GeoPoseRequest the way the server does.
+// Besides crashes and sanitizer findings, the target aborts when the non-throwing and the throwing parser disagree,
+// or when a parsed request does not survive a round trip through to_json().
+// Exceptions other than std::runtime_error are not caught on purpose, the parser must not leak them.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const oscp::ParseResult<json> document = oscp::tryParseJson(std::string_view(reinterpret_cast<const char*>(data), size));
+    if (!document) {
+        return 0;
+    }
+
+    std::pmr::monotonic_buffer_resource arena;
+    const oscp::ParseResult<oscp::GeoPoseRequest> request = oscp::tryParseGeoPoseRequest(*document, &arena);
+
+    bool thrown = false;
+    try {
+        oscp::parseGeoPoseRequest(*document, &arena);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (thrown == request.has_value()) {
+        std::abort();
+    }
+    if (!request) {
+        return 0;
+    }
+
+    const json written = *request;
+    const oscp::ParseResult<oscp::GeoPoseRequest> reread = oscp::tryParseGeoPoseRequest(written, &arena);
+    if (!reread || json(*reread) != written) {
+        std::abort();
+    }
+    return 0;
+}
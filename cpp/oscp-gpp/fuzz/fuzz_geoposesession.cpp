@@ -0,0 +1,68 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/geoposeprotocol_json.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+// The sensors of the session that frames are read against, matching the frame seeds of corpus/geoposesession
+const oscp::GeoPoseSession& frameSession() {
+    static const oscp::GeoPoseSession session = json::parse(R"({
+        "type": "geopose-session",
+        "sensors": [
+            {"type": "camera", "id": "camera_01"},
+            {"type": "geolocation", "id": "geolocation_00"}
+        ],
+        "cameras": [
+            {"sensorId": "camera_01", "params": {"model": "OPENCV", "modelParams": [1499.027, 1499.027, 954.783, 511.957, 0.0, 0.0, 0.0, 0.0]}}
+        ]
+    })").get<oscp::GeoPoseSession>();
+    return session;
+}
+
+} // namespace
+
+// Parses the input both as a GeoPoseSession and as a frame of a session,
+// and aborts when the non-throwing and the throwing parser disagree on either
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const oscp::ParseResult<json> document = oscp::tryParseJson(std::string_view(reinterpret_cast<const char*>(data), size));
+    if (!document) {
+        return 0;
+    }
+
+    const oscp::ParseResult<oscp::GeoPoseSession> session = oscp::tryParseGeoPoseSession(*document);
+    bool thrown = false;
+    try {
+        document->get<oscp::GeoPoseSession>();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (thrown == session.has_value()) {
+        std::abort();
+    }
+
+    std::pmr::monotonic_buffer_resource arena;
+    const oscp::ParseResult<oscp::GeoPoseRequest> frame = oscp::tryParseGeoPoseFrame(*document, frameSession(), &arena);
+    thrown = false;
+    try {
+        oscp::parseGeoPoseFrame(*document, frameSession(), &arena);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (thrown == frame.has_value()) {
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+
+# Open AR Cloud GeoPoseProtocol C++ implementation
+# Created based on the protocol definition:
+# https://github.com/OpenArCloud/oscp-geopose-protocol
+
+# Licensed under the MIT License
+# SPDX-License-Identifier: MIT
+
+# Regenerates the seed corpus in fuzz/corpus/ from the example data in data/
+# and from the interfaces of protocolv1.md (one seed per reading type and protocol extension).
+# Usage: python3 make_seed_corpus.py [path/to/data]
+
+import base64
+import gzip
+import json
+import os
+import sys
+
+FUZZ_DIR = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR = sys.argv[1] if len(sys.argv) > 1 else os.path.join(FUZZ_DIR, "..", "..", "..", "data")
+CORPUS_DIR = os.path.join(FUZZ_DIR, "corpus")
+
+TIMESTAMP = 1700000000000
+
+
+def load_json(name):
+    with open(os.path.join(DATA_DIR, name)) as f:
+        return json.load(f)
+
+
+def write_seed(target, name, content):
+    directory = os.path.join(CORPUS_DIR, target)
+    os.makedirs(directory, exist_ok=True)
+    if isinstance(content, (dict, list)):
+        content = json.dumps(content, indent=2)
+    if isinstance(content, str):
+        content = content.encode("utf-8")
+    with open(os.path.join(directory, name), "wb") as f:
+        f.write(content)
+
+
+camera_params = load_json("seattle_camera_params.json")
+geolocation_params = load_json("seattle_geolocation_params.json")
+vps = load_json("seattle_vps.json")
+with open(os.path.join(DATA_DIR, "seattle.jpg"), "rb") as f:
+    jpeg = f.read()
+
+# The beginning of the JPEG keeps the seeds small, the fuzzer does not decode the image anyway
+jpeg_base64 = base64.b64encode(jpeg[:192]).decode("ascii")
+
+privacy = {
+    "dataRetention": ["oscp:retention:none"],
+    "dataAcceptableUse": ["oscp:use:localization"],
+    "dataSanitizationApplied": ["oscp:sanitization:faces"],
+    "dataSanitizationRequested": ["oscp:sanitization:license-plates"],
+}
+
+camera_id = camera_params["camera_id"]
+camera_sensor = {
+    "type": "camera",
+    "id": camera_id,
+    "name": "seattle_camera",
+    "model": camera_params["camera_model"],
+    "rigIdentifier": "rig",
+    "rigRotation": {"x": 0.0, "y": 0.0, "z": 0.0, "w": 1.0},
+    "rigTranslation": {"x": 0.0, "y": 0.0, "z": 0.0},
+}
+camera_param = {
+    "model": camera_params["camera_model"],
+    "modelParams": camera_params["camera_params"],
+}
+camera_reading = {
+    "timestamp": TIMESTAMP,
+    "sensorId": camera_id,
+    "privacy": privacy,
+    "sequenceNumber": 0,
+    "imageFormat": "JPG",
+    "size": [camera_params["camera_width"], camera_params["camera_height"]],
+    "imageBytes": jpeg_base64,
+    "imageOrientation": {"mirrored": False, "rotation": 0.0},
+    "params": camera_param,
+}
+geolocation_reading = {
+    "timestamp": TIMESTAMP,
+    "sensorId": "geolocation_00",
+    "privacy": privacy,
+    "latitude": geolocation_params["lat"],
+    "longitude": geolocation_params["lon"],
+    "altitude": geolocation_params["h"],
+    "accuracy": 5.0,
+    "altitudeAccuracy": 10.0,
+    "heading": 90.0,
+    "speed": 0.5,
+}
+
+
+def sensor(sensor_type, sensor_id):
+    return {"type": sensor_type, "id": sensor_id}
+
+
+def imu_readings(sensor_id, count):
+    return [{"timestamp": TIMESTAMP + 5 * i, "sensorId": sensor_id, "privacy": privacy,
+             "x": 0.01 * i, "y": -0.02 * i, "z": 9.81} for i in range(count)]
+
+
+def imu_block(sensor_id, count):
+    return {"sensorId": sensor_id, "privacy": privacy,
+            "timestamps": [TIMESTAMP + 5 * i for i in range(count)],
+            "x": [0.01 * i for i in range(count)],
+            "y": [-0.02 * i for i in range(count)],
+            "z": [9.81] * count}
+
+
+prior_pose = {
+    "type": "geopose",
+    "id": "prior_00",
+    "timestamp": TIMESTAMP - 1000,
+    "accuracy": vps["accuracy"],
+    "geopose": vps["geopose"],
+}
+
+
+def request(sensors, readings, **extra):
+    r = {
+        "type": "geopose",
+        "id": "2b4d3c4e-7c52-4ae6-8f1a-6a2f3d5c9e10",
+        "timestamp": TIMESTAMP,
+        "sensors": sensors,
+        "sensorReadings": readings,
+    }
+    r.update(extra)
+    return r
+
+
+# GeoPoseRequest
+
+write_seed("geoposerequest", "camera_geolocation.json", request(
+    [camera_sensor, sensor("geolocation", "geolocation_00")],
+    {"cameraReadings": [camera_reading], "geolocationReadings": [geolocation_reading]}))
+
+write_seed("geoposerequest", "all_reading_types.json", request(
+    [camera_sensor, sensor("geolocation", "geolocation_00"), sensor("wifi", "wifi_00"), sensor("bluetooth", "bluetooth_00"),
+     sensor("accelerometer", "accelerometer_00"), sensor("gyroscope", "gyroscope_00"), sensor("magnetometer", "magnetometer_00")],
+    {
+        "cameraReadings": [camera_reading],
+        "geolocationReadings": [geolocation_reading],
+        "wifiReadings": [{"timestamp": TIMESTAMP, "sensorId": "wifi_00", "privacy": privacy,
+                          "BSSID": "00:11:22:33:44:55", "frequency": 2412, "RSSI": -60, "SSID": "oscp",
+                          "scanTimeStart": TIMESTAMP - 100, "scanTimeEnd": TIMESTAMP}],
+        "bluetoothReadings": [{"timestamp": TIMESTAMP, "sensorId": "bluetooth_00", "privacy": privacy,
+                               "address": "66:77:88:99:AA:BB", "RSSI": -70, "name": "beacon"}],
+        "accelerometerReadings": imu_readings("accelerometer_00", 3),
+        "gyroscopeReadings": imu_readings("gyroscope_00", 3),
+        "magnetometerReadings": imu_readings("magnetometer_00", 3),
+    },
+    priorPoses=[prior_pose]))
+
+write_seed("geoposerequest", "imu_blocks.json", request(
+    [sensor("accelerometer", "accelerometer_00"), sensor("gyroscope", "gyroscope_00"), sensor("magnetometer", "magnetometer_00")],
+    {
+        "accelerometerBlocks": [imu_block("accelerometer_00", 4)],
+        "gyroscopeBlocks": [imu_block("gyroscope_00", 4)],
+        "magnetometerBlocks": [imu_block("magnetometer_00", 4)],
+    }))
+
+request_privacy_reading = dict(geolocation_reading)
+del request_privacy_reading["privacy"]
+write_seed("geoposerequest", "request_privacy.json", request(
+    [sensor("geolocation", "geolocation_00")],
+    {"geolocationReadings": [request_privacy_reading]},
+    privacy=privacy))
+
+token_request = request([], {"geolocationReadings": [geolocation_reading]}, sensorsToken="c2Vuc29ycy0wMA")
+del token_request["sensors"]
+write_seed("geoposerequest", "sensors_token.json", token_request)
+
+write_seed("geoposerequest", "minimal.json", request([], {}))
+
+# GeoPoseSession and its frames, the fuzz target reads frames against a fixed session with these sensor IDs
+
+session = {
+    "type": "geopose-session",
+    "privacy": privacy,
+    "sensors": [camera_sensor, sensor("geolocation", "geolocation_00")],
+    "cameras": [{"sensorId": camera_id, "params": camera_param}],
+}
+write_seed("geoposesession", "session.json", session)
+
+frame_camera_reading = dict(camera_reading)
+del frame_camera_reading["params"]
+del frame_camera_reading["privacy"]
+frame = request([], {"cameraReadings": [frame_camera_reading], "geolocationReadings": [geolocation_reading]})
+del frame["sensors"]
+write_seed("geoposesession", "frame.json", frame)
+
+# base64: the RFC 4648 test vectors, the padding and alphabet corner cases and a piece of a real image
+
+for i, vector in enumerate([b"", b"f", b"fo", b"foo", b"foob", b"fooba", b"foobar"]):
+    write_seed("base64", "rfc4648_%d" % i, base64.b64encode(vector))
+write_seed("base64", "unpadded", "Zm9vYg")
+write_seed("base64", "padding_in_the_middle", "Zm9v=YmFy")
+write_seed("base64", "invalid_character", "Zm9v\nYmFy")
+write_seed("base64", "url_safe_alphabet", base64.urlsafe_b64encode(jpeg[:48]))
+write_seed("base64", "jpeg", base64.b64encode(jpeg[:3072]))
+
+# decompress: gzip and zstd request bodies, the first byte selects the coding and the chunk size (see fuzz_decompress.cpp)
+
+GZIP_CHUNK_64 = bytes([63 << 1])
+ZSTD_CHUNK_64 = bytes([(63 << 1) | 1])
+
+
+def zstd_frame(window_log, blocks):
+    """A zstd frame (RFC 8878) of raw and RLE blocks, which are simple enough to write without a zstd module.
+    blocks are (block_type, size, content) with block_type 0 for raw and 1 for RLE."""
+    frame = bytes([0x28, 0xB5, 0x2F, 0xFD, 0x00, (window_log - 10) << 3])  # magic number, no content size, window
+    for i, (block_type, block_size, content) in enumerate(blocks):
+        last = 1 if i == len(blocks) - 1 else 0
+        frame += ((block_size << 3) | (block_type << 1) | last).to_bytes(3, "little") + content
+    return frame
+
+
+minimal_request = json.dumps(request([], {})).encode("utf-8")
+write_seed("decompress", "gzip_request", GZIP_CHUNK_64 + gzip.compress(minimal_request, mtime=0))
+write_seed("decompress", "gzip_two_members", GZIP_CHUNK_64 + gzip.compress(b"oscp", mtime=0) + gzip.compress(b"gpp", mtime=0))
+write_seed("decompress", "gzip_truncated", GZIP_CHUNK_64 + gzip.compress(minimal_request, mtime=0)[:-6])
+write_seed("decompress", "gzip_bomb", bytes([0]) + gzip.compress(bytes(2 << 20), mtime=0))
+write_seed("decompress", "zstd_request", ZSTD_CHUNK_64 + zstd_frame(17, [(0, len(minimal_request), minimal_request)]))
+write_seed("decompress", "zstd_bomb", bytes([1]) + zstd_frame(17, [(1, 128 << 10, b"\0")] * 16))
@@ -0,0 +1,51 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+// Stands in for libFuzzer where it is not available (e.g. GCC): runs the fuzz target once on every file
+// given on the command line or found in the given directories, so that a corpus or a crash reproducer
+// can be replayed without clang. There is no mutation, this is for regression runs only.
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+void runFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<char> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t executed = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::filesystem::path path(argv[i]);
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file()) {
+                    runFile(entry.path());
+                    executed++;
+                }
+            }
+        } else {
+            runFile(path);
+            executed++;
+        }
+    }
+    std::cout << "Executed " << executed << " inputs" << std::endl;
+    return 0;
+}
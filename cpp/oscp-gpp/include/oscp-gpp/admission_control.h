@@ -0,0 +1,178 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_ADMISSION_CONTROL_H_
+#define _OSCP_ADMISSION_CONTROL_H_
+
+#include <oscp-gpp/enum_strings.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+namespace oscp {
+
+// Why a request was dropped instead of localized
+enum class DropReason {
+    DEADLINE_EXCEEDED, // the deadline the client set has passed
+    TOO_OLD, // the timestamp of the request is older than the age limit of the server
+    OVERLOADED // shed by the admission controller because requests queue for too long
+};
+
+inline constexpr enum_strings_detail::EnumName<DropReason> dropReasonNames[] = {
+    {DropReason::DEADLINE_EXCEEDED, "DEADLINE_EXCEEDED"},
+    {DropReason::TOO_OLD, "TOO_OLD"},
+    {DropReason::OVERLOADED, "OVERLOADED"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(dropReasonNames), "dropReasonNames must list DropReason in declaration order");
+
+constexpr std::string_view toString(DropReason reason) noexcept {
+    return enum_strings_detail::nameOf(dropReasonNames, reason);
+}
+
+/**
+Parses a timeout in milliseconds, e.g. the value of the X-OSCP-Timeout-Ms request header: up to 9 digits, nothing else.
+Returns false for anything else.
+*/
+bool parseTimeoutMs(std::string_view text, std::time_t& timeoutMs);
+
+/**
+Until when the result of a request is still useful: the deadline the client set relative to the arrival of the request,
+and the age limit of the server relative to GeoPoseRequest::timestamp (milliseconds since the Unix epoch on the client).
+The age limit relies on roughly synchronized clocks, timestamps in the future count as age 0.
+Without either, the budget never expires.
+*/
+class RequestBudget {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void setTimeout(std::time_t timeoutMs, Clock::time_point arrival);
+
+    // Does nothing with a maxAgeMs of 0 or a request without timestamp
+    void setMaxAge(std::time_t requestTimestampMs, std::time_t maxAgeMs,
+        std::chrono::system_clock::time_point nowSystem = std::chrono::system_clock::now(), Clock::time_point now = Clock::now());
+
+    // The reason of the limit that has passed, the deadline of the client first
+    std::optional<DropReason> expired(Clock::time_point now = Clock::now()) const;
+
+    // The earlier of both limits, Clock::time_point::max() without any
+    Clock::time_point deadline() const;
+
+private:
+    Clock::time_point deadline_ = Clock::time_point::max();
+    Clock::time_point ageDeadline_ = Clock::time_point::max();
+};
+
+struct AdmissionPolicy {
+    size_t maxConcurrent = 0; // localizations running at once, the others wait in a queue; 0 is unlimited, without queue and shedding
+    std::time_t targetDelayMs = 50; // the queueing delay that is acceptable as a standing minimum
+    std::time_t intervalMs = 500; // how long the queueing delay must stay above the target before shedding starts
+};
+
+struct AdmissionStats {
+    uint64_t admitted = 0;
+    uint64_t deadlineExceeded = 0; // drops per DropReason
+    uint64_t tooOld = 0;
+    uint64_t overloaded = 0;
+    size_t running = 0;
+    size_t queued = 0;
+};
+
+/**
+Admission control in front of the VPS backend: at most maxConcurrent localizations run at once, the others wait
+in arrival order until a slot is free or their budget expires. When a request leaves the queue, a CoDel-style shedder looks at how long
+it waited: if the queueing delay stayed above targetDelayMs for a whole intervalMs, the backend cannot keep up, and requests
+are rejected with OVERLOADED at a rate that grows with the square root of the drops until the delay falls below the target.
+Short bursts pass, a standing queue is cut down early, before requests wait until their deadline.
+check() drops requests whose budget has passed before each stage. Every drop is counted by its reason. All methods are thread-safe.
+*/
+class AdmissionController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // A slot of the backend, released by its destructor. Empty if the request was dropped, see reason().
+    class Slot {
+    public:
+        Slot() = default;
+        Slot(Slot&& other) noexcept;
+        Slot& operator=(Slot&& other) noexcept;
+        ~Slot();
+
+        explicit operator bool() const noexcept {
+            return controller_ != nullptr;
+        }
+
+        DropReason reason() const noexcept {
+            return reason_;
+        }
+
+        // How long the request waited for the slot
+        Clock::duration queueDelay() const noexcept {
+            return queueDelay_;
+        }
+
+    private:
+        friend class AdmissionController;
+
+        AdmissionController* controller_ = nullptr;
+        DropReason reason_ = DropReason::OVERLOADED;
+        Clock::duration queueDelay_{};
+    };
+
+    explicit AdmissionController(const AdmissionPolicy& policy = AdmissionPolicy());
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    // Waits for a slot until the budget expires, and sheds the request if the queue stands
+    Slot acquire(const RequestBudget& budget);
+
+    // The reason if the budget has passed, counted as a drop
+    std::optional<DropReason> check(const RequestBudget& budget);
+
+    // Counts a drop that happened elsewhere
+    void countDrop(DropReason reason);
+
+    AdmissionStats stats() const;
+
+    const AdmissionPolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    bool shouldShed(Clock::duration queueDelay, Clock::time_point now); // requires mutex_
+    void wakeFront(); // requires mutex_
+    void release();
+
+    const AdmissionPolicy policy_;
+    mutable std::mutex mutex_;
+    std::list<std::condition_variable*> waiters_; // one per queued request, the front gets the next free slot
+    size_t running_ = 0;
+
+    // CoDel state
+    Clock::time_point firstAboveTarget_{}; // when the delay will have been above target for an interval, zero if below
+    Clock::time_point shedNext_{};
+    uint32_t shedCount_ = 0;
+    uint32_t lastShedCount_ = 0;
+    bool shedding_ = false;
+
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> deadlineExceeded_{0};
+    std::atomic<uint64_t> tooOld_{0};
+    std::atomic<uint64_t> overloaded_{0};
+};
+
+} // namespace oscp
+
+#endif // _OSCP_ADMISSION_CONTROL_H_
@@ -0,0 +1,240 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_ASYNC_CLIENT_H_
+#define _OSCP_ASYNC_CLIENT_H_
+
+#include <oscp-gpp/enum_strings.h>
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// The coroutine interface needs C++20 coroutines in the code that includes this header, the library itself is C++17.
+// Define OSCP_GPP_NO_COROUTINES to leave it out.
+#if !defined(OSCP_GPP_NO_COROUTINES) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define OSCP_GPP_HAS_COROUTINES 1
+#include <coroutine>
+#include <exception>
+#endif
+
+namespace oscp {
+
+// How an asynchronous request ended, OK if a complete HTTP response was received whatever its status code
+enum class TransferStatus {
+    OK,
+    CONNECT_FAILED,
+    CONNECTION_CLOSED, // by the server before the response was complete
+    TIMEOUT,
+    INVALID_RESPONSE, // not HTTP, a corrupt body encoding, or for localize() a body that is not a GeoPoseResponse
+    TOO_LARGE, // the response exceeds maxResponseBytes
+    CANCELLED // by cancel()
+};
+
+inline constexpr enum_strings_detail::EnumName<TransferStatus> transferStatusNames[] = {
+    {TransferStatus::OK, "OK"},
+    {TransferStatus::CONNECT_FAILED, "CONNECT_FAILED"},
+    {TransferStatus::CONNECTION_CLOSED, "CONNECTION_CLOSED"},
+    {TransferStatus::TIMEOUT, "TIMEOUT"},
+    {TransferStatus::INVALID_RESPONSE, "INVALID_RESPONSE"},
+    {TransferStatus::TOO_LARGE, "TOO_LARGE"},
+    {TransferStatus::CANCELLED, "CANCELLED"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(transferStatusNames), "transferStatusNames must list TransferStatus in declaration order");
+
+constexpr std::string_view toString(TransferStatus status) noexcept {
+    return enum_strings_detail::nameOf(transferStatusNames, status);
+}
+
+using HttpHeaders = std::vector<std::pair<std::string, std::string>>;
+
+struct HttpRequest {
+    std::string method = "POST";
+    std::string path;
+    HttpHeaders headers; // Host and Content-Length are added
+    std::string body;
+};
+
+struct HttpResponse {
+    TransferStatus status = TransferStatus::OK;
+    int httpStatus = 0; // 0 unless status is OK
+    HttpHeaders headers;
+    std::string body; // decompressed if it came with a Content-Encoding this build supports
+
+    // The value of the first header with the name, case-insensitive, empty if there is none
+    std::string_view header(std::string_view name) const;
+};
+
+struct LocalizeResult {
+    TransferStatus status = TransferStatus::OK;
+    int httpStatus = 0;
+    std::optional<GeoPoseResponse> response; // if the server answered 200 with a valid GeoPoseResponse
+    std::string sensorsToken; // X-OSCP-Sensors-Token, see SensorRegistry
+    std::string error; // otherwise: the body of the error response or why the transfer failed
+};
+
+struct AsyncClientPolicy {
+    size_t maxConnections = 256; // requests beyond this wait in FIFO order for a connection
+    std::time_t timeoutMs = 10000; // from send() to the complete response, localize() sends it as X-OSCP-Timeout-Ms
+    size_t maxResponseBytes = 64 * 1024 * 1024; // also the limit of a decompressed body
+};
+
+struct AsyncClientStats {
+    uint64_t requests = 0;
+    uint64_t connections = 0; // opened, a kept-alive connection is reused for further requests
+    uint64_t retries = 0;
+    uint64_t failures = 0; // completed with a status other than OK
+};
+
+/**
+An HTTP/1.1 client for one server that keeps many requests in flight from a single thread, e.g. the render loop of an
+AR app, which calls poll(0) once per frame and gets the poses of earlier frames in callbacks instead of blocking on them.
+Each request in flight has a kept-alive connection of its own (no pipelining), up to maxConnections, and the sockets are
+non-blocking and waited for with epoll, so a few hundred requests cost one thread and a few hundred sockets.
+Callbacks are only called from poll(), never from send(), and may send further requests. Not thread-safe: all calls from
+the thread that polls. A request that finds its kept-alive connection closed by the server before any byte of the response
+arrived is sent again once on a new connection; the server deduplicates GeoPoseRequests by id, see RequestCoalescer.
+The destructor drops pending requests without calling their callbacks, call cancel() first to complete them.
+The host is resolved once by the constructor, which throws std::runtime_error if it cannot be resolved.
+Linux only, the constructor throws std::runtime_error on other platforms.
+*/
+class AsyncClient {
+public:
+    using Callback = std::function<void(HttpResponse&& response)>;
+    using LocalizeCallback = std::function<void(LocalizeResult&& result)>;
+
+    AsyncClient(const std::string& host, int port, const AsyncClientPolicy& policy = AsyncClientPolicy());
+    ~AsyncClient();
+
+    AsyncClient(const AsyncClient&) = delete;
+    AsyncClient& operator=(const AsyncClient&) = delete;
+
+    void send(HttpRequest request, Callback callback);
+
+    // POST /geopose with the request as JSON, the response is parsed into a GeoPoseResponse
+    void localize(const GeoPoseRequest& request, LocalizeCallback callback);
+
+    /**
+    Waits up to timeoutMs for network events (0 does not wait, -1 until one of the requests completes), sends what can be
+    sent, times out what is late and calls the callbacks of the completed requests. Returns the number of callbacks called.
+    */
+    size_t poll(int timeoutMs);
+
+    // Polls until no request is pending
+    void run();
+
+    // Completes all pending requests with CANCELLED, calling their callbacks right away
+    void cancel();
+
+    // Requests sent and not completed yet
+    size_t pending() const;
+
+    AsyncClientStats stats() const;
+
+#ifdef OSCP_GPP_HAS_COROUTINES
+    template<typename Result>
+    class Awaiter;
+
+    // co_await client.send(request) suspends until the response arrives, the coroutine is resumed by poll()
+    Awaiter<HttpResponse> send(HttpRequest request);
+
+    // co_await client.localize(request)
+    Awaiter<LocalizeResult> localize(const GeoPoseRequest& request);
+#endif
+
+private:
+    const AsyncClientPolicy policy_;
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+#ifdef OSCP_GPP_HAS_COROUTINES
+
+template<typename Result>
+class AsyncClient::Awaiter {
+public:
+    explicit Awaiter(std::function<void(std::function<void(Result&&)>)> start) : start_(std::move(start)) {
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> coroutine) {
+        // The callback runs in a later poll(), and the awaiter is not touched after the coroutine was resumed
+        start_([this, coroutine](Result&& result) {
+            result_ = std::move(result);
+            coroutine.resume();
+        });
+    }
+
+    Result await_resume() {
+        return std::move(*result_);
+    }
+
+private:
+    std::function<void(std::function<void(Result&&)>)> start_;
+    std::optional<Result> result_;
+};
+
+inline AsyncClient::Awaiter<HttpResponse> AsyncClient::send(HttpRequest request) {
+    return Awaiter<HttpResponse>([this, request = std::move(request)](Callback callback) mutable {
+        send(std::move(request), std::move(callback));
+    });
+}
+
+inline AsyncClient::Awaiter<LocalizeResult> AsyncClient::localize(const GeoPoseRequest& request) {
+    return Awaiter<LocalizeResult>([this, &request](LocalizeCallback callback) {
+        localize(request, std::move(callback));
+    });
+}
+
+/**
+The return type of a coroutine that is started right away and not awaited by anybody, e.g. one per localized frame:
+    oscp::DetachedTask localizeFrame(oscp::AsyncClient& client, oscp::GeoPoseRequest request) {
+        oscp::LocalizeResult result = co_await client.localize(request);
+        ...
+    }
+The coroutine frame is freed when it returns. An exception that escapes it calls std::terminate(), as with std::thread.
+*/
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept {
+            return DetachedTask();
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return std::suspend_never();
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return std::suspend_never();
+        }
+
+        void return_void() noexcept {
+        }
+
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+#endif // OSCP_GPP_HAS_COROUTINES
+
+} // namespace oscp
+
+#endif // _OSCP_ASYNC_CLIENT_H_
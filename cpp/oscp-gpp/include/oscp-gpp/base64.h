@@ -5,11 +5,18 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 typedef unsigned char BYTE;
 
 namespace oscp {
 std::string base64_encode(BYTE const* buf, unsigned int bufLen);
+
+// Decoding stops at the first '=' or at the first character that is not in the base64 alphabet
 std::vector<BYTE> base64_decode(std::string const&);
+
+// Table-driven variant of base64_decode() that decodes four characters per step, with identical results.
+// base64_decode() stays the reference, the fuzz target fuzz_base64 compares the two.
+std::vector<BYTE> base64_decode_fast(std::string_view encoded);
 } // namespace oscp
 
 #endif // __OSCP_BASE64_H_
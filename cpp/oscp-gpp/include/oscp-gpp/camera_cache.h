@@ -0,0 +1,110 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_CAMERA_CACHE_H_
+#define _OSCP_CAMERA_CACHE_H_
+
+#include <oscp-gpp/camera_intrinsics.h>
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oscp {
+
+struct CameraCachePolicy {
+    size_t maxBytes = 256 * 1024 * 1024; // the least recently used cameras are evicted above this
+    std::time_t ttlMs = 30000; // entries are rebuilt this long after they were prepared
+    bool buildUndistortionMaps = false; // true to also build the undistortion maps, maps larger than maxBytes are never built
+};
+
+struct CameraCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0; // removed for the memory cap or the TTL
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+/**
+Short-lived cache of the PreparedCamera of each client session.
+
+Every CameraReading carries its full CameraParameters, but consecutive frames of a device almost always repeat them.
+Entries are keyed by (session, sensorId, model, modelParams, image size), so a change of any of them,
+e.g. a refocus, prepares a new entry instead of returning stale intrinsics.
+The least recently used entries are evicted once the cache exceeds the memory cap, and entries are
+rebuilt after the TTL so sessions that come and go do not pin their tables.
+Returned entries are immutable and stay valid after eviction. All methods are thread-safe.
+*/
+class CameraCache {
+public:
+    explicit CameraCache(const CameraCachePolicy& policy = CameraCachePolicy());
+
+    /**
+    Returns the prepared camera of the reading, preparing it on a miss.
+    Throws std::invalid_argument if the camera parameters are invalid, see makeCameraIntrinsics().
+    */
+    std::shared_ptr<const PreparedCamera> get(const std::string& sessionKey, const CameraReading& reading);
+
+    void clear();
+
+    CameraCacheStats stats() const;
+
+    const CameraCachePolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    struct Key {
+        std::string sessionKey;
+        std::string sensorId;
+        CameraModel model = CameraModel::UNKNOWN;
+        std::vector<float> modelParams;
+        size_t width = 0;
+        size_t height = 0;
+        size_t hash = 0;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return key.hash;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const PreparedCamera> camera;
+        size_t bytes = 0;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    using EntryList = std::list<Entry>; // most recently used first
+
+    void evictOverCap(); // requires mutex_
+
+    const CameraCachePolicy policy_;
+    mutable std::mutex mutex_;
+    EntryList entries_;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+    size_t bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_CAMERA_CACHE_H_
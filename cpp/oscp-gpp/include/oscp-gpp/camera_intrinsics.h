@@ -0,0 +1,108 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_CAMERA_INTRINSICS_H_
+#define _OSCP_CAMERA_INTRINSICS_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oscp {
+
+/**
+Returns the number of modelParams the camera model expects (see cameraModelParamLayouts), 0 for UNKNOWN.
+*/
+size_t cameraModelParamCount(CameraModel model);
+
+// Largest width and height of a camera image, in pixels
+constexpr size_t maxCameraImageSide = 65536;
+
+/**
+Pinhole part of CameraParameters, in pixels and normalized by the image size.
+The distortion coefficients are kept in params in the order of CameraModel.
+*/
+struct CameraIntrinsics {
+    CameraModel model = CameraModel::UNKNOWN;
+    size_t width = 0;
+    size_t height = 0;
+    double fx = 0.0; // pixels
+    double fy = 0.0;
+    double cx = 0.0;
+    double cy = 0.0;
+    double fxNormalized = 0.0; // fx / width
+    double fyNormalized = 0.0; // fy / height
+    double cxNormalized = 0.0; // cx / width
+    double cyNormalized = 0.0; // cy / height
+    std::vector<double> params; // all modelParams, including the pinhole ones
+
+    // 3x3 camera matrix in row-major order
+    void cameraMatrix(double K[9]) const {
+        K[0] = fx;  K[1] = 0.0; K[2] = cx;
+        K[3] = 0.0; K[4] = fy;  K[5] = cy;
+        K[6] = 0.0; K[7] = 0.0; K[8] = 1.0;
+    }
+
+    bool hasDistortion() const {
+        return model != CameraModel::SIMPLE_PINHOLE && model != CameraModel::PINHOLE;
+    }
+};
+
+/**
+Lookup table to undistort an image: for every pixel (u, v) of the undistorted image, which is a pinhole
+image with the same fx, fy, cx, cy, the (sub)pixel of the distorted image to sample, like cv::initUndistortRectifyMap.
+Empty for camera models without distortion.
+*/
+struct UndistortionMap {
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<float> mapX; // row-major, width * height
+    std::vector<float> mapY;
+
+    bool empty() const {
+        return mapX.empty();
+    }
+};
+
+/**
+Everything derived from the CameraParameters of a camera that is worth reusing across frames
+*/
+struct PreparedCamera {
+    CameraIntrinsics intrinsics;
+    UndistortionMap undistortionMap;
+
+    size_t memoryBytes() const {
+        return sizeof(PreparedCamera) + intrinsics.params.capacity() * sizeof(double)
+            + (undistortionMap.mapX.capacity() + undistortionMap.mapY.capacity()) * sizeof(float);
+    }
+};
+
+/**
+Validates the camera parameters of an image of width x height pixels and extracts the intrinsics.
+Throws std::invalid_argument for an unknown model, a wrong number of modelParams,
+an empty image or one with a side larger than maxCameraImageSide.
+*/
+CameraIntrinsics makeCameraIntrinsics(const CameraParameters& params, size_t width, size_t height);
+
+/**
+Returns the bytes of the lookup tables of the undistortion map of the camera, 0 if the model has no distortion,
+SIZE_MAX if they would not even fit into the address space.
+*/
+size_t undistortionMapBytes(const CameraIntrinsics& intrinsics);
+
+/**
+Builds the undistortion lookup table of the camera, an empty one if the model has no distortion
+or if it would take more than maxBytes.
+*/
+UndistortionMap makeUndistortionMap(const CameraIntrinsics& intrinsics, size_t maxBytes = SIZE_MAX);
+
+} // namespace oscp
+
+#endif // _OSCP_CAMERA_INTRINSICS_H_
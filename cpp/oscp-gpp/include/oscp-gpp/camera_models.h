@@ -0,0 +1,427 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_CAMERA_MODELS_H_
+#define _OSCP_CAMERA_MODELS_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+/**
+Camera models of the CameraModel enum (same conventions as COLMAP), specialized at compile time.
+
+CameraModelTraits<M> describes the parameter layout of model M and implements its lens distortion on
+normalized image coordinates. The function templates below build projection, unprojection, batch
+undistortion and remap tables on top of it. The batch functions take structure-of-arrays input.
+The loops of projectPoints() and buildUndistortionMap() have no dependencies between iterations, so the
+compiler vectorizes them for the models without transcendental functions (and for all models if a vector
+math library is available). Unprojection runs an iterative solver with an early exit per point, so
+unprojectPoints() and undistortPixels() are plain loops.
+Use dispatchCameraModel() to get from a runtime CameraModel to the specialized code.
+*/
+
+// Hint that the iterations of the following loop are independent
+#if defined(__clang__)
+#define OSCP_GPP_VECTORIZE_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define OSCP_GPP_VECTORIZE_LOOP _Pragma("GCC ivdep")
+#else
+#define OSCP_GPP_VECTORIZE_LOOP
+#endif
+
+namespace oscp {
+
+namespace camera_models_detail {
+
+// Number of comma-separated names in a parameter list like "fx, fy, cx, cy"
+constexpr size_t countNames(std::string_view names) {
+    size_t count = names.empty() ? 0 : 1;
+    for (char c : names) {
+        if (c == ',') {
+            count++;
+        }
+    }
+    return count;
+}
+
+constexpr bool startsWith(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+// The parameter layout of model M, derived from cameraModelParamLayouts
+template<CameraModel M>
+struct ParamLayout {
+    static constexpr std::string_view paramNames = cameraModelParamLayout(M);
+    static constexpr size_t paramCount = countNames(paramNames);
+    static constexpr bool singleFocalLength = startsWith(paramNames, "f, cx, cy");
+    static constexpr bool hasDistortion = paramCount > (singleFocalLength ? 3 : 4);
+    static_assert(singleFocalLength || startsWith(paramNames, "fx, fy, cx, cy"),
+                  "The modelParams of a camera model must start with f, cx, cy or fx, fy, cx, cy");
+};
+
+// Equidistant fisheye mapping of the normalized point: theta / r with theta = atan(r)
+template<typename T>
+inline T fisheyeScale(T x, T y) {
+    const T r = std::sqrt(x * x + y * y);
+    return r > T(1e-12) ? std::atan(r) / r : T(1);
+}
+
+} // namespace camera_models_detail
+
+template<CameraModel M>
+struct CameraModelTraits;
+
+// Each specialization provides:
+//   paramNames, paramCount - the layout of cameraModelParamLayouts
+//   singleFocalLength - params start with f, cx, cy instead of fx, fy, cx, cy
+//   hasDistortion - false if there are only pinhole parameters and distort() is the identity
+//   distort(p, x, y, xd, yd) - applies the lens distortion to the normalized image coordinates (x, y)
+
+template<>
+struct CameraModelTraits<CameraModel::SIMPLE_PINHOLE> : camera_models_detail::ParamLayout<CameraModel::SIMPLE_PINHOLE> {
+
+    template<typename T>
+    static void distort(const T*, T x, T y, T& xd, T& yd) {
+        xd = x;
+        yd = y;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::PINHOLE> : camera_models_detail::ParamLayout<CameraModel::PINHOLE> {
+
+    template<typename T>
+    static void distort(const T*, T x, T y, T& xd, T& yd) {
+        xd = x;
+        yd = y;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::SIMPLE_RADIAL> : camera_models_detail::ParamLayout<CameraModel::SIMPLE_RADIAL> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T radial = T(1) + p[3] * (x * x + y * y);
+        xd = x * radial;
+        yd = y * radial;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::RADIAL> : camera_models_detail::ParamLayout<CameraModel::RADIAL> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T r2 = x * x + y * y;
+        const T radial = T(1) + r2 * (p[3] + r2 * p[4]);
+        xd = x * radial;
+        yd = y * radial;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::OPENCV> : camera_models_detail::ParamLayout<CameraModel::OPENCV> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T k1 = p[4], k2 = p[5], p1 = p[6], p2 = p[7];
+        const T r2 = x * x + y * y;
+        const T radial = T(1) + r2 * (k1 + r2 * k2);
+        xd = x * radial + T(2) * p1 * x * y + p2 * (r2 + T(2) * x * x);
+        yd = y * radial + T(2) * p2 * x * y + p1 * (r2 + T(2) * y * y);
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::OPENCV_FISHEYE> : camera_models_detail::ParamLayout<CameraModel::OPENCV_FISHEYE> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T k1 = p[4], k2 = p[5], k3 = p[6], k4 = p[7];
+        const T scale = camera_models_detail::fisheyeScale(x, y);
+        const T theta2 = (x * x + y * y) * scale * scale;
+        const T radial = scale * (T(1) + theta2 * (k1 + theta2 * (k2 + theta2 * (k3 + theta2 * k4))));
+        xd = x * radial;
+        yd = y * radial;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::FULL_OPENCV> : camera_models_detail::ParamLayout<CameraModel::FULL_OPENCV> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T k1 = p[4], k2 = p[5], p1 = p[6], p2 = p[7];
+        const T k3 = p[8], k4 = p[9], k5 = p[10], k6 = p[11];
+        const T r2 = x * x + y * y;
+        const T radial = (T(1) + r2 * (k1 + r2 * (k2 + r2 * k3))) / (T(1) + r2 * (k4 + r2 * (k5 + r2 * k6)));
+        xd = x * radial + T(2) * p1 * x * y + p2 * (r2 + T(2) * x * x);
+        yd = y * radial + T(2) * p2 * x * y + p1 * (r2 + T(2) * y * y);
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::FOV> : camera_models_detail::ParamLayout<CameraModel::FOV> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T omega = p[4];
+        T factor = T(1);
+        if (std::abs(omega) > T(1e-9)) {
+            const T twoTanHalfOmega = T(2) * std::tan(T(0.5) * omega);
+            const T r = std::sqrt(x * x + y * y);
+            factor = r > T(1e-12) ? std::atan(r * twoTanHalfOmega) / (r * omega) : twoTanHalfOmega / omega;
+        }
+        xd = x * factor;
+        yd = y * factor;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::SIMPLE_RADIAL_FISHEYE> : camera_models_detail::ParamLayout<CameraModel::SIMPLE_RADIAL_FISHEYE> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T scale = camera_models_detail::fisheyeScale(x, y);
+        const T theta2 = (x * x + y * y) * scale * scale;
+        const T radial = scale * (T(1) + p[3] * theta2);
+        xd = x * radial;
+        yd = y * radial;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::RADIAL_FISHEYE> : camera_models_detail::ParamLayout<CameraModel::RADIAL_FISHEYE> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T scale = camera_models_detail::fisheyeScale(x, y);
+        const T theta2 = (x * x + y * y) * scale * scale;
+        const T radial = scale * (T(1) + theta2 * (p[3] + theta2 * p[4]));
+        xd = x * radial;
+        yd = y * radial;
+    }
+};
+
+template<>
+struct CameraModelTraits<CameraModel::THIN_PRISM_FISHEYE> : camera_models_detail::ParamLayout<CameraModel::THIN_PRISM_FISHEYE> {
+
+    template<typename T>
+    static void distort(const T* p, T x, T y, T& xd, T& yd) {
+        const T k1 = p[4], k2 = p[5], p1 = p[6], p2 = p[7];
+        const T k3 = p[8], k4 = p[9], sx1 = p[10], sy1 = p[11];
+        const T scale = camera_models_detail::fisheyeScale(x, y);
+        const T u = x * scale;
+        const T v = y * scale;
+        const T theta2 = u * u + v * v;
+        const T radial = T(1) + theta2 * (k1 + theta2 * (k2 + theta2 * (k3 + theta2 * k4)));
+        xd = u * radial + T(2) * p1 * u * v + p2 * (theta2 + T(2) * u * u) + sx1 * theta2;
+        yd = v * radial + T(2) * p2 * u * v + p1 * (theta2 + T(2) * v * v) + sy1 * theta2;
+    }
+};
+
+/**
+Calls f(std::integral_constant<CameraModel, M>()) for the runtime model, so f can call the templates below
+with decltype(tag)::value. Throws std::invalid_argument for CameraModel::UNKNOWN.
+*/
+template<typename F>
+decltype(auto) dispatchCameraModel(CameraModel model, F&& f) {
+    switch (model) {
+        case CameraModel::SIMPLE_PINHOLE:
+            return f(std::integral_constant<CameraModel, CameraModel::SIMPLE_PINHOLE>());
+        case CameraModel::PINHOLE:
+            return f(std::integral_constant<CameraModel, CameraModel::PINHOLE>());
+        case CameraModel::SIMPLE_RADIAL:
+            return f(std::integral_constant<CameraModel, CameraModel::SIMPLE_RADIAL>());
+        case CameraModel::RADIAL:
+            return f(std::integral_constant<CameraModel, CameraModel::RADIAL>());
+        case CameraModel::OPENCV:
+            return f(std::integral_constant<CameraModel, CameraModel::OPENCV>());
+        case CameraModel::OPENCV_FISHEYE:
+            return f(std::integral_constant<CameraModel, CameraModel::OPENCV_FISHEYE>());
+        case CameraModel::FULL_OPENCV:
+            return f(std::integral_constant<CameraModel, CameraModel::FULL_OPENCV>());
+        case CameraModel::FOV:
+            return f(std::integral_constant<CameraModel, CameraModel::FOV>());
+        case CameraModel::SIMPLE_RADIAL_FISHEYE:
+            return f(std::integral_constant<CameraModel, CameraModel::SIMPLE_RADIAL_FISHEYE>());
+        case CameraModel::RADIAL_FISHEYE:
+            return f(std::integral_constant<CameraModel, CameraModel::RADIAL_FISHEYE>());
+        case CameraModel::THIN_PRISM_FISHEYE:
+            return f(std::integral_constant<CameraModel, CameraModel::THIN_PRISM_FISHEYE>());
+        default:
+            throw std::invalid_argument("Unknown camera model");
+    }
+}
+
+// Pinhole parameters of any model
+template<CameraModel M, typename T>
+inline void pinholeParams(const T* p, T& fx, T& fy, T& cx, T& cy) {
+    if constexpr (CameraModelTraits<M>::singleFocalLength) {
+        fx = p[0];
+        fy = p[0];
+        cx = p[1];
+        cy = p[2];
+    } else {
+        fx = p[0];
+        fy = p[1];
+        cx = p[2];
+        cy = p[3];
+    }
+}
+
+/**
+Inverts the lens distortion: finds the normalized (x, y) with distort(x, y) = (xd, yd) by Newton iterations
+with a numerical Jacobian, starting from (xd, yd).
+*/
+template<CameraModel M, typename T>
+inline void undistortNormalized(const T* p, T xd, T yd, T& x, T& y) {
+    using Traits = CameraModelTraits<M>;
+    x = xd;
+    y = yd;
+    if constexpr (Traits::hasDistortion) {
+        const int maxIterations = 20;
+        const T tolerance = std::numeric_limits<T>::epsilon() * T(16);
+        const T step = std::sqrt(std::numeric_limits<T>::epsilon());
+        for (int i = 0; i < maxIterations; i++) {
+            T fx, fy;
+            Traits::distort(p, x, y, fx, fy);
+            const T rx = fx - xd;
+            const T ry = fy - yd;
+            if (std::abs(rx) <= tolerance && std::abs(ry) <= tolerance) {
+                break;
+            }
+            const T hx = step * std::max(T(1), std::abs(x));
+            const T hy = step * std::max(T(1), std::abs(y));
+            T x0, y0, x1, y1;
+            Traits::distort(p, x - hx, y, x0, y0);
+            Traits::distort(p, x + hx, y, x1, y1);
+            const T j00 = (x1 - x0) / (T(2) * hx);
+            const T j10 = (y1 - y0) / (T(2) * hx);
+            Traits::distort(p, x, y - hy, x0, y0);
+            Traits::distort(p, x, y + hy, x1, y1);
+            const T j01 = (x1 - x0) / (T(2) * hy);
+            const T j11 = (y1 - y0) / (T(2) * hy);
+            const T det = j00 * j11 - j01 * j10;
+            if (std::abs(det) < std::numeric_limits<T>::min()) {
+                break;
+            }
+            const T dx = (j11 * rx - j01 * ry) / det;
+            const T dy = (j00 * ry - j10 * rx) / det;
+            x -= dx;
+            y -= dy;
+            if (std::abs(dx) <= tolerance * std::max(T(1), std::abs(x)) && std::abs(dy) <= tolerance * std::max(T(1), std::abs(y))) {
+                break;
+            }
+        }
+    }
+}
+
+/**
+Projects the point (X, Y, Z) in camera coordinates (Z forward) to the pixel (u, v).
+*/
+template<CameraModel M, typename T>
+inline void projectPoint(const T* p, T X, T Y, T Z, T& u, T& v) {
+    T fx, fy, cx, cy;
+    pinholeParams<M>(p, fx, fy, cx, cy);
+    T xd, yd;
+    CameraModelTraits<M>::distort(p, X / Z, Y / Z, xd, yd);
+    u = fx * xd + cx;
+    v = fy * yd + cy;
+}
+
+/**
+Unprojects the pixel (u, v) to the normalized ray direction (x, y, 1) in camera coordinates.
+*/
+template<CameraModel M, typename T>
+inline void unprojectPoint(const T* p, T u, T v, T& x, T& y) {
+    T fx, fy, cx, cy;
+    pinholeParams<M>(p, fx, fy, cx, cy);
+    undistortNormalized<M>(p, (u - cx) / fx, (v - cy) / fy, x, y);
+}
+
+/**
+Batch projectPoint() of n points given as separate X, Y, Z arrays.
+*/
+template<CameraModel M, typename T>
+void projectPoints(const T* p, const T* X, const T* Y, const T* Z, T* u, T* v, size_t n) {
+    T fx, fy, cx, cy;
+    pinholeParams<M>(p, fx, fy, cx, cy);
+    OSCP_GPP_VECTORIZE_LOOP
+    for (size_t i = 0; i < n; i++) {
+        T xd, yd;
+        CameraModelTraits<M>::distort(p, X[i] / Z[i], Y[i] / Z[i], xd, yd);
+        u[i] = fx * xd + cx;
+        v[i] = fy * yd + cy;
+    }
+}
+
+/**
+Batch unprojectPoint() of n pixels given as separate u, v arrays.
+*/
+template<CameraModel M, typename T>
+void unprojectPoints(const T* p, const T* u, const T* v, T* x, T* y, size_t n) {
+    T fx, fy, cx, cy;
+    pinholeParams<M>(p, fx, fy, cx, cy);
+    const T invFx = T(1) / fx;
+    const T invFy = T(1) / fy;
+    for (size_t i = 0; i < n; i++) {
+        undistortNormalized<M>(p, (u[i] - cx) * invFx, (v[i] - cy) * invFy, x[i], y[i]);
+    }
+}
+
+/**
+Batch undistortion of n pixels of the distorted image to the pixels of the pinhole image with the same fx, fy, cx, cy.
+*/
+template<CameraModel M, typename T>
+void undistortPixels(const T* p, const T* u, const T* v, T* undistortedU, T* undistortedV, size_t n) {
+    T fx, fy, cx, cy;
+    pinholeParams<M>(p, fx, fy, cx, cy);
+    unprojectPoints<M>(p, u, v, undistortedU, undistortedV, n);
+    OSCP_GPP_VECTORIZE_LOOP
+    for (size_t i = 0; i < n; i++) {
+        undistortedU[i] = fx * undistortedU[i] + cx;
+        undistortedV[i] = fy * undistortedV[i] + cy;
+    }
+}
+
+/**
+Remap table to undistort a width x height image: for each pixel of the pinhole image with the same fx, fy, cx, cy,
+the (sub)pixel of the distorted image to sample, like cv::initUndistortRectifyMap. mapX and mapY are row-major.
+*/
+template<CameraModel M, typename T>
+void buildUndistortionMap(const T* p, size_t width, size_t height, float* mapX, float* mapY) {
+    T fx, fy, cx, cy;
+    pinholeParams<M>(p, fx, fy, cx, cy);
+    const T invFx = T(1) / fx;
+    const T invFy = T(1) / fy;
+    for (size_t row = 0; row < height; row++) {
+        const T y = (static_cast<T>(row) - cy) * invFy;
+        float* rowX = mapX + row * width;
+        float* rowY = mapY + row * width;
+        OSCP_GPP_VECTORIZE_LOOP
+        for (size_t col = 0; col < width; col++) {
+            T xd, yd;
+            CameraModelTraits<M>::distort(p, (static_cast<T>(col) - cx) * invFx, y, xd, yd);
+            rowX[col] = static_cast<float>(fx * xd + cx);
+            rowY[col] = static_cast<float>(fy * yd + cy);
+        }
+    }
+}
+
+} // namespace oscp
+
+#endif // _OSCP_CAMERA_MODELS_H_
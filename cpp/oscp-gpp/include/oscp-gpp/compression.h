@@ -0,0 +1,129 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_COMPRESSION_H_
+#define _OSCP_COMPRESSION_H_
+
+#include <oscp-gpp/enum_strings.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace oscp {
+
+// The HTTP content codings of request and response bodies (Content-Encoding, Accept-Encoding)
+enum class ContentCoding {
+    IDENTITY,
+    GZIP,
+    ZSTD,
+    UNKNOWN
+};
+
+inline constexpr enum_strings_detail::EnumName<ContentCoding> contentCodingNames[] = {
+    {ContentCoding::IDENTITY, "identity"},
+    {ContentCoding::GZIP, "gzip"},
+    {ContentCoding::ZSTD, "zstd"},
+    {ContentCoding::UNKNOWN, "UNKNOWN"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(contentCodingNames), "contentCodingNames must list ContentCoding in declaration order");
+
+// The name of the coding in Content-Encoding
+constexpr std::string_view toString(ContentCoding coding) noexcept {
+    return enum_strings_detail::nameOf(contentCodingNames, coding);
+}
+
+// Whether this build of the library can compress and decompress the coding (zlib and zstd are optional dependencies)
+bool isContentCodingSupported(ContentCoding coding);
+
+/**
+Reads a Content-Encoding header: one coding, case-insensitive, "x-gzip" being gzip and an empty header IDENTITY.
+Several codings applied on top of each other are not supported and read as UNKNOWN.
+*/
+ContentCoding parseContentCoding(std::string_view contentEncoding);
+
+// Whether an Accept-Encoding header allows the coding, i.e. lists it or "*" without q=0
+bool acceptsContentCoding(std::string_view acceptEncoding, ContentCoding coding);
+
+struct CompressionPolicy {
+    size_t minBytes = 1024; // smaller bodies are sent as they are, the gain would not pay for the CPU time
+    double minSavings = 0.3; // compress only if the samples shrink by at least this fraction
+    size_t sampleBytes = 2048; // the heuristic compresses this many bytes at evenly spaced positions of the body...
+    size_t sampleCount = 8; // ...this many times
+    int gzipLevel = 1; // zlib 1 (fastest) to 9
+    int zstdLevel = 1; // zstd 1 (fastest) to 19, or negative for even faster
+};
+
+/**
+Chooses per body whether to send it with the given coding or as it is (IDENTITY): compressed are only bodies that are
+at least minBytes, whose media type is not compressed already (images, video, audio, archives), and of which a few
+evenly spaced samples compress by at least minSavings. Structured JSON such as IMU readings and batches typically
+saves 80% and more, while a request that is mostly one base64 JPEG saves about 25% and is sent as it is by default.
+Returns IDENTITY if the coding is not supported by this build.
+*/
+ContentCoding chooseContentCoding(std::string_view body, std::string_view contentType, ContentCoding coding,
+    const CompressionPolicy& policy = CompressionPolicy());
+
+// Compresses a whole body, IDENTITY returns a copy. Throws std::invalid_argument if the coding is not supported.
+std::string compressBody(std::string_view body, ContentCoding coding, const CompressionPolicy& policy = CompressionPolicy());
+
+enum class DecompressionStatus {
+    OK,
+    TOO_LARGE, // the decompressed body would exceed the limit, e.g. a decompression bomb
+    INVALID_DATA, // corrupt or truncated
+    UNSUPPORTED_CODING // UNKNOWN, or not supported by this build
+};
+
+inline constexpr enum_strings_detail::EnumName<DecompressionStatus> decompressionStatusNames[] = {
+    {DecompressionStatus::OK, "OK"},
+    {DecompressionStatus::TOO_LARGE, "TOO_LARGE"},
+    {DecompressionStatus::INVALID_DATA, "INVALID_DATA"},
+    {DecompressionStatus::UNSUPPORTED_CODING, "UNSUPPORTED_CODING"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(decompressionStatusNames), "decompressionStatusNames must list DecompressionStatus in declaration order");
+
+constexpr std::string_view toString(DecompressionStatus status) noexcept {
+    return enum_strings_detail::nameOf(decompressionStatusNames, status);
+}
+
+/**
+Streaming decompression of a body that arrives in chunks, with a limit on the decompressed size.
+The output grows in steps of at most 64 KiB and decompression stops as soon as the limit would be exceeded,
+so a small body that expands to gigabytes costs no more than the limit. zstd frames that need a window of more
+than 8 MiB are rejected as INVALID_DATA for the same reason. Errors are returned rather than thrown, and every error is final.
+Not thread-safe, one Decompressor per body.
+*/
+class Decompressor {
+public:
+    Decompressor(ContentCoding coding, size_t maxDecompressedBytes);
+    ~Decompressor();
+
+    Decompressor(const Decompressor&) = delete;
+    Decompressor& operator=(const Decompressor&) = delete;
+
+    // Decompresses the next chunk of the body and appends the result to output
+    DecompressionStatus write(const char* data, size_t size, std::string& output);
+
+    // To be called after the last chunk, fails with INVALID_DATA if the body was truncated
+    DecompressionStatus finish();
+
+    // Decompressed bytes so far
+    size_t decompressedBytes() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+// Decompresses a whole body with a Decompressor
+DecompressionStatus decompressBody(std::string_view body, ContentCoding coding, size_t maxDecompressedBytes, std::string& output);
+
+} // namespace oscp
+
+#endif // _OSCP_COMPRESSION_H_
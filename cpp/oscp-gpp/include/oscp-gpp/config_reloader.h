@@ -0,0 +1,103 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_CONFIG_RELOADER_H_
+#define _OSCP_CONFIG_RELOADER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace oscp {
+
+/**
+An immutable value that is replaced as a whole, read-copy-update style: readers take the current snapshot with load()
+and keep using it for as long as they hold it, e.g. until their request is answered, while publish() makes a new one
+current for everybody who loads afterwards. The old snapshot is freed by its last reader. Readers never wait for a writer.
+*/
+template<typename T>
+class AtomicSnapshot {
+public:
+    explicit AtomicSnapshot(std::shared_ptr<const T> value) : value_(std::move(value)) {
+    }
+
+    AtomicSnapshot(const AtomicSnapshot&) = delete;
+    AtomicSnapshot& operator=(const AtomicSnapshot&) = delete;
+
+    std::shared_ptr<const T> load() const {
+        return std::atomic_load_explicit(&value_, std::memory_order_acquire);
+    }
+
+    void publish(std::shared_ptr<const T> value) {
+        std::atomic_store_explicit(&value_, std::move(value), std::memory_order_release);
+    }
+
+private:
+    std::shared_ptr<const T> value_; // only accessed through the atomic shared_ptr functions
+};
+
+struct ConfigReloaderPolicy {
+    std::time_t pollIntervalMs = 1000; // how often the modification time of the file and SIGHUP are checked
+    bool reloadOnSighup = true; // POSIX only
+};
+
+struct ConfigReloaderStats {
+    uint64_t reloads = 0;
+    uint64_t failures = 0; // the file could not be read or apply rejected it
+};
+
+/**
+Watches a config file and hands its contents to apply() when its modification time changes or the process gets SIGHUP,
+on a thread of its own. apply() parses and publishes the new config, e.g. to an AtomicSnapshot, and returns false or throws
+to reject it, which keeps the current config. The modification time of the loaded version is passed in, so that a file
+changed in between, e.g. while a worker process was restarted, is loaded right away.
+At most one ConfigReloader per process should handle SIGHUP. The destructor stops the thread.
+*/
+class ConfigReloader {
+public:
+    using Apply = std::function<bool(const std::string& contents)>;
+
+    ConfigReloader(std::string path, std::filesystem::file_time_type loadedVersion, Apply apply,
+        const ConfigReloaderPolicy& policy = ConfigReloaderPolicy());
+    ~ConfigReloader();
+
+    ConfigReloader(const ConfigReloader&) = delete;
+    ConfigReloader& operator=(const ConfigReloader&) = delete;
+
+    ConfigReloaderStats stats() const;
+
+    // The modification time of a file, file_time_type::min() if it does not exist
+    static std::filesystem::file_time_type version(const std::string& path);
+
+private:
+    void run();
+    void reload(std::filesystem::file_time_type version);
+
+    const std::string path_;
+    const Apply apply_;
+    const ConfigReloaderPolicy policy_;
+    std::filesystem::file_time_type loadedVersion_;
+    std::atomic<uint64_t> reloads_{0};
+    std::atomic<uint64_t> failures_{0};
+
+    std::mutex mutex_;
+    std::condition_variable stop_;
+    bool stopping_ = false;
+    std::thread thread_; // last, it starts using the members above right away
+};
+
+} // namespace oscp
+
+#endif // _OSCP_CONFIG_RELOADER_H_
@@ -0,0 +1,166 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_CONTENT_NEGOTIATION_H_
+#define _OSCP_CONTENT_NEGOTIATION_H_
+
+#include <oscp-gpp/enum_strings.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace oscp {
+
+// How a message is encoded on the wire
+enum class WireEncoding {
+    JSON,
+    BINARY,
+    UNKNOWN
+};
+
+inline constexpr enum_strings_detail::EnumName<WireEncoding> wireEncodingNames[] = {
+    {WireEncoding::JSON, "JSON"},
+    {WireEncoding::BINARY, "BINARY"},
+    {WireEncoding::UNKNOWN, "UNKNOWN"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(wireEncodingNames), "wireEncodingNames must list WireEncoding in declaration order");
+
+constexpr std::string_view toString(WireEncoding encoding) noexcept {
+    return enum_strings_detail::nameOf(wireEncodingNames, encoding);
+}
+
+struct ProtocolVersion {
+    int versionMajor = 0;
+    int versionMinor = 0;
+};
+
+/**
+A media type of a Content-Type header or a media range of an Accept header, e.g.
+"application/vnd.oscp+json;version=2.0;q=0.8". The strings are views into the parsed header value.
+Only the parameters that take part in the negotiation are kept, the others are skipped.
+*/
+struct MediaType {
+    std::string_view type; // "*" in the media range "*/*"
+    std::string_view subtype; // "*" in the media ranges "*/*" and "type/*"
+    int versionMajor = -1; // -1 without a "version" parameter
+    int versionMinor = -1; // -1 without a minor version, e.g. "version=2" accepts every 2.x
+    int quality = 1000; // the "q" parameter in thousandths
+};
+
+/**
+Parses "type/subtype *( ; name=value )" without allocating. Returns false for a malformed media type,
+or if the "version" or "q" parameter has an invalid value.
+*/
+bool parseMediaType(std::string_view text, MediaType& mediaType);
+
+/**
+Splits the first element off a comma-separated header value such as Accept and returns it without surrounding whitespace.
+Commas in quoted parameter values do not separate. The list is empty after its last element.
+*/
+std::string_view nextListElement(std::string_view& list);
+
+// What a media type says about the encoding: "application/json" and every "+json" suffix are JSON, anything else is UNKNOWN
+WireEncoding encodingOf(const MediaType& mediaType);
+
+// A registered protocol version in one encoding, with the strings the negotiation needs computed once
+struct Representation {
+    std::string type; // lowercase, e.g. "application"
+    std::string subtype; // lowercase, e.g. "vnd.oscp+json"
+    ProtocolVersion version;
+    WireEncoding encoding = WireEncoding::UNKNOWN;
+    std::string contentType; // of the responses, e.g. "application/vnd.oscp+json; version=2.0"
+};
+
+/**
+Builds a Representation of the media type "type/subtype" (without parameters).
+Throws std::invalid_argument for a malformed media type or a wildcard.
+*/
+Representation makeRepresentation(std::string_view mediaType, ProtocolVersion version, WireEncoding encoding);
+
+// The negotiation compares a fixed-size array per request, so the number of registered representations is bounded
+constexpr size_t maxRepresentations = 16;
+
+/**
+Selects the representation of a response for an Accept header in one pass over the header, without allocating:
+the representation with the highest q value wins, where the q value of a representation comes from the most specific
+media range that matches it (type/subtype with version, type/subtype, a wildcard subtype, the full wildcard).
+On equal q values the more specific match wins, so a client that names a version gets it, then the earlier registered representation.
+An empty Accept header accepts everything and selects the first representation.
+Returns std::nullopt if no representation is acceptable, a server answers 406 Not Acceptable then.
+*/
+std::optional<size_t> selectResponseRepresentation(const Representation* representations, size_t count, std::string_view accept);
+
+/**
+Selects the representation a request body is in from its Content-Type header: a registered type/subtype must also match
+the version if the header has one. Other media types fall back to the first representation of their encoding,
+e.g. "application/json" to the preferred JSON version. An empty Content-Type selects the first representation.
+Returns std::nullopt if the body cannot be read, a server answers 415 Unsupported Media Type then.
+*/
+std::optional<size_t> selectRequestRepresentation(const Representation* representations, size_t count, std::string_view contentType);
+
+/**
+Maps the protocol versions and encodings a server speaks to their handlers, e.g. the functions that write a GeoPoseResponse.
+The representations are registered once at startup, in the order of preference (e.g. the newest version first).
+After that, negotiating a request neither allocates nor copies strings, so each additional protocol version only costs
+one more comparison of the media ranges. Selection is const and can be called from any thread once registration is done.
+*/
+template<typename Handler>
+class ContentNegotiator {
+public:
+    struct Selection {
+        const Representation* representation = nullptr;
+        const Handler* handler = nullptr;
+
+        explicit operator bool() const noexcept {
+            return representation != nullptr;
+        }
+    };
+
+    // Throws std::invalid_argument for a malformed media type and std::length_error above maxRepresentations
+    void add(std::string_view mediaType, ProtocolVersion version, WireEncoding encoding, Handler handler) {
+        if (representations_.size() == maxRepresentations) {
+            throw std::length_error("A ContentNegotiator holds at most " + std::to_string(maxRepresentations) + " representations");
+        }
+        representations_.push_back(makeRepresentation(mediaType, version, encoding));
+        handlers_.push_back(std::move(handler));
+    }
+
+    // See selectResponseRepresentation()
+    Selection selectResponse(std::string_view accept) const {
+        return select(selectResponseRepresentation(representations_.data(), representations_.size(), accept));
+    }
+
+    // See selectRequestRepresentation()
+    Selection selectRequest(std::string_view contentType) const {
+        return select(selectRequestRepresentation(representations_.data(), representations_.size(), contentType));
+    }
+
+    const std::vector<Representation>& representations() const {
+        return representations_;
+    }
+
+private:
+    Selection select(std::optional<size_t> index) const {
+        if (!index) {
+            return Selection();
+        }
+        return Selection{&representations_[*index], &handlers_[*index]};
+    }
+
+    std::vector<Representation> representations_;
+    std::vector<Handler> handlers_;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_CONTENT_NEGOTIATION_H_
@@ -0,0 +1,69 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_ENUM_STRINGS_H_
+#define _OSCP_ENUM_STRINGS_H_
+
+#include <cstddef>
+#include <string_view>
+
+namespace oscp {
+
+// Compile-time name tables of enums, see e.g. sensorTypeNames
+namespace enum_strings_detail {
+
+// The name of the sentinel of unknown values, which is written but never parsed
+inline constexpr std::string_view unknownName = "UNKNOWN";
+
+template<typename Enum>
+struct EnumName {
+    Enum value;
+    std::string_view name;
+};
+
+// The name of a value is then a plain array access
+template<typename Enum, size_t N>
+constexpr bool isInDeclarationOrder(const EnumName<Enum> (&names)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        if (static_cast<size_t>(names[i].value) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Enum, size_t N>
+constexpr std::string_view nameOf(const EnumName<Enum> (&names)[N], Enum value) noexcept {
+    const size_t index = static_cast<size_t>(value);
+    return index < N ? names[index].name : unknownName;
+}
+
+// Compares the length and the first character before the whole name, so a mismatch is decided by one or two integer comparisons.
+// "UNKNOWN" is not the name of a value, so it is rejected like any other unknown name.
+template<typename Enum, size_t N>
+constexpr bool tryParse(const EnumName<Enum> (&names)[N], std::string_view str, Enum& value) noexcept {
+    if (str.empty()) {
+        return false;
+    }
+    for (const EnumName<Enum>& name : names) {
+        if (name.name.size() == str.size() && name.name[0] == str[0] && name.name == str) {
+            if (name.name == unknownName) {
+                return false;
+            }
+            value = name.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace enum_strings_detail
+
+} // namespace oscp
+
+#endif // _OSCP_ENUM_STRINGS_H_
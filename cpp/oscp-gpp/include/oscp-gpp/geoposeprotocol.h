@@ -13,10 +13,18 @@
 #ifndef _OSCP_GEOPOSE_PROTOCOL_H_
 #define _OSCP_GEOPOSE_PROTOCOL_H_
 
+#include <oscp-gpp/enum_strings.h>
 #include <oscp-gpp/geopose.h>
+#include <oscp-gpp/parse_result.h>
 
 #include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 
@@ -38,25 +46,21 @@ enum class SensorType {
 };
 // TODO: add altitude sensor
 
-inline std::string toString(const enum oscp::SensorType sensorType) {
-    switch(sensorType) {
-        case SensorType::CAMERA:
-            return "camera";
-        case SensorType::GEOLOCATION:
-            return "geolocation";
-        case SensorType::WIFI:
-            return "wifi";
-        case SensorType::BLUETOOTH:
-            return "bluetooth";
-        case SensorType::ACCELEROMETER:
-            return "accelerometer";
-        case SensorType::GYROSCOPE:
-            return "gyroscope";
-        case SensorType::MAGNETOMETER:
-            return "magnetometer";
-        default:
-            throw std::runtime_error("Unknown sensor type");
-    }
+inline constexpr enum_strings_detail::EnumName<SensorType> sensorTypeNames[] = {
+    {SensorType::CAMERA, "camera"},
+    {SensorType::GEOLOCATION, "geolocation"},
+    {SensorType::WIFI, "wifi"},
+    {SensorType::BLUETOOTH, "bluetooth"},
+    {SensorType::ACCELEROMETER, "accelerometer"},
+    {SensorType::GYROSCOPE, "gyroscope"},
+    {SensorType::MAGNETOMETER, "magnetometer"},
+    {SensorType::UNKNOWN, "UNKNOWN"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(sensorTypeNames), "sensorTypeNames must list SensorType in declaration order");
+
+// Never throws, returns "UNKNOWN" for SensorType::UNKNOWN and invalid values
+constexpr std::string_view toString(SensorType sensorType) noexcept {
+    return enum_strings_detail::nameOf(sensorTypeNames, sensorType);
 }
 
 inline std::ostream & operator<< (std::ostream &out, oscp::SensorType const &sensorType) {
@@ -64,24 +68,17 @@ inline std::ostream & operator<< (std::ostream &out, oscp::SensorType const &sen
     return out;
 }
 
-inline enum SensorType sensorTypefromString(const std::string& str) {
-    if (str.compare("camera")==0) {
-        return SensorType::CAMERA;
-    } else if (str.compare("geolocation")==0) {
-        return SensorType::GEOLOCATION;
-    } else if (str.compare("wifi")==0) {
-        return SensorType::WIFI;
-    } else if (str.compare("bluetooth")==0) {
-        return SensorType::BLUETOOTH;
-    } else if (str.compare("accelerometer")==0) {
-        return SensorType::ACCELEROMETER;
-    } else if (str.compare("gyroscope")==0) {
-        return SensorType::GYROSCOPE;
-    } else if (str.compare("magnetometer")==0) {
-        return SensorType::MAGNETOMETER;
-    } else {
-        throw std::runtime_error("Unknown sensor type: " + str);
+// Returns false if str is not the name of a sensor type
+constexpr bool tryParse(std::string_view str, SensorType& sensorType) noexcept {
+    return enum_strings_detail::tryParse(sensorTypeNames, str, sensorType);
+}
+
+inline enum SensorType sensorTypefromString(std::string_view str) {
+    SensorType sensorType = SensorType::UNKNOWN;
+    if (!tryParse(str, sensorType)) {
+        throw std::runtime_error("Unknown sensor type: " + std::string(str));
     }
+    return sensorType;
 }
 
 
@@ -97,19 +94,18 @@ enum class ImageFormat {
     UNKNOWN
 };
 
-inline std::string toString(const enum oscp::ImageFormat imageFormat) {
-    switch(imageFormat) {
-        case ImageFormat::RGBA32:
-            return "RGBA32";
-        case ImageFormat::GRAY8:
-            return "GRAY8";
-        case ImageFormat::DEPTH:
-            return "DEPTH";
-        case ImageFormat::JPG:
-            return "JPG";
-        default:
-            throw std::runtime_error("Unknown image format");
-    }
+inline constexpr enum_strings_detail::EnumName<ImageFormat> imageFormatNames[] = {
+    {ImageFormat::RGBA32, "RGBA32"},
+    {ImageFormat::GRAY8, "GRAY8"},
+    {ImageFormat::DEPTH, "DEPTH"},
+    {ImageFormat::JPG, "JPG"},
+    {ImageFormat::UNKNOWN, "UNKNOWN"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(imageFormatNames), "imageFormatNames must list ImageFormat in declaration order");
+
+// Never throws, returns "UNKNOWN" for ImageFormat::UNKNOWN and invalid values
+constexpr std::string_view toString(ImageFormat imageFormat) noexcept {
+    return enum_strings_detail::nameOf(imageFormatNames, imageFormat);
 }
 
 inline std::ostream & operator<< (std::ostream &out, oscp::ImageFormat const &imageFormat) {
@@ -117,18 +113,17 @@ inline std::ostream & operator<< (std::ostream &out, oscp::ImageFormat const &im
     return out;
 }
 
-inline enum ImageFormat imageFormatFromString(const std::string& str) {
-    if (str.compare("RGBA32")==0) {
-        return ImageFormat::RGBA32;
-    } else if (str.compare("GRAY8")==0) {
-        return ImageFormat::GRAY8;
-    } else if (str.compare("DEPTH")==0) {
-        return ImageFormat::DEPTH;
-    } else if (str.compare("JPG")==0) {
-        return ImageFormat::JPG;
-    } else {
-        throw std::runtime_error("Unknown image format: " + str);
+// Returns false if str is not the name of an image format
+constexpr bool tryParse(std::string_view str, ImageFormat& imageFormat) noexcept {
+    return enum_strings_detail::tryParse(imageFormatNames, str, imageFormat);
+}
+
+inline enum ImageFormat imageFormatFromString(std::string_view str) {
+    ImageFormat imageFormat = ImageFormat::UNKNOWN;
+    if (!tryParse(str, imageFormat)) {
+        throw std::runtime_error("Unknown image format: " + std::string(str));
     }
+    return imageFormat;
 }
 
 /**
@@ -162,49 +157,66 @@ inline std::string toString(const oscp::ImageOrientation &t) {
 /**
 * The camera models of Colmap are used here
 * See https://colmap.github.io/cameras.html
+* The modelParams of each model are listed in cameraModelParamLayouts
 */
 enum class CameraModel {
-    SIMPLE_PINHOLE, // f, cx, cy
-    PINHOLE, // fx, fy, cx, cy
-    SIMPLE_RADIAL, // f, cx, cy, k
-    RADIAL, // f, cx, cy, k1, k2
-    OPENCV, // fx, fy, cx, cy, k1, k2, p1, p2
-    OPENCV_FISHEYE, // fx, fy, cx, cy, k1, k2, k3, k4
-    FULL_OPENCV, // fx, fy, cx, cy, k1, k2, p1, p2, k3, k4, k5, k6
-    FOV, // fx, fy, cx, cy, omega
-    SIMPLE_RADIAL_FISHEYE, // f, cx, cy, k
-    RADIAL_FISHEYE, // f, cx, cy, k1, k2
-    THIN_PRISM_FISHEYE, // fx, fy, cx, cy, k1, k2, p1, p2, k3, k4, sx1, sy1
+    SIMPLE_PINHOLE,
+    PINHOLE,
+    SIMPLE_RADIAL,
+    RADIAL,
+    OPENCV,
+    OPENCV_FISHEYE,
+    FULL_OPENCV,
+    FOV,
+    SIMPLE_RADIAL_FISHEYE,
+    RADIAL_FISHEYE,
+    THIN_PRISM_FISHEYE,
     UNKNOWN
 };
 
-inline std::string toString(const enum oscp::CameraModel cameraModel) {
-    switch(cameraModel) {
-        case CameraModel::SIMPLE_PINHOLE:
-            return "SIMPLE_PINHOLE";
-        case CameraModel::PINHOLE:
-            return "PINHOLE";
-        case CameraModel::SIMPLE_RADIAL:
-            return "SIMPLE_RADIAL";
-        case CameraModel::RADIAL:
-            return "RADIAL";
-        case CameraModel::OPENCV:
-            return "OPENCV";
-        case CameraModel::OPENCV_FISHEYE:
-            return "OPENCV_FISHEYE";
-        case CameraModel::FULL_OPENCV:
-            return "FULL_OPENCV";
-        case CameraModel::FOV:
-            return "FOV";
-        case CameraModel::SIMPLE_RADIAL_FISHEYE:
-            return "SIMPLE_RADIAL_FISHEYE";
-        case CameraModel::RADIAL_FISHEYE:
-            return "RADIAL_FISHEYE";
-        case CameraModel::THIN_PRISM_FISHEYE:
-            return "THIN_PRISM_FISHEYE";
-        default:
-            throw std::runtime_error("Unknown camera model");
-    }
+inline constexpr enum_strings_detail::EnumName<CameraModel> cameraModelNames[] = {
+    {CameraModel::SIMPLE_PINHOLE, "SIMPLE_PINHOLE"},
+    {CameraModel::PINHOLE, "PINHOLE"},
+    {CameraModel::SIMPLE_RADIAL, "SIMPLE_RADIAL"},
+    {CameraModel::RADIAL, "RADIAL"},
+    {CameraModel::OPENCV, "OPENCV"},
+    {CameraModel::OPENCV_FISHEYE, "OPENCV_FISHEYE"},
+    {CameraModel::FULL_OPENCV, "FULL_OPENCV"},
+    {CameraModel::FOV, "FOV"},
+    {CameraModel::SIMPLE_RADIAL_FISHEYE, "SIMPLE_RADIAL_FISHEYE"},
+    {CameraModel::RADIAL_FISHEYE, "RADIAL_FISHEYE"},
+    {CameraModel::THIN_PRISM_FISHEYE, "THIN_PRISM_FISHEYE"},
+    {CameraModel::UNKNOWN, "UNKNOWN"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(cameraModelNames), "cameraModelNames must list CameraModel in declaration order");
+
+// Never throws, returns "UNKNOWN" for CameraModel::UNKNOWN and invalid values
+constexpr std::string_view toString(CameraModel cameraModel) noexcept {
+    return enum_strings_detail::nameOf(cameraModelNames, cameraModel);
+}
+
+// The names of the modelParams of each camera model in their order, the parameter counts and the
+// specializations of camera_models.h are derived from this table
+inline constexpr enum_strings_detail::EnumName<CameraModel> cameraModelParamLayouts[] = {
+    {CameraModel::SIMPLE_PINHOLE, "f, cx, cy"},
+    {CameraModel::PINHOLE, "fx, fy, cx, cy"},
+    {CameraModel::SIMPLE_RADIAL, "f, cx, cy, k"},
+    {CameraModel::RADIAL, "f, cx, cy, k1, k2"},
+    {CameraModel::OPENCV, "fx, fy, cx, cy, k1, k2, p1, p2"},
+    {CameraModel::OPENCV_FISHEYE, "fx, fy, cx, cy, k1, k2, k3, k4"},
+    {CameraModel::FULL_OPENCV, "fx, fy, cx, cy, k1, k2, p1, p2, k3, k4, k5, k6"},
+    {CameraModel::FOV, "fx, fy, cx, cy, omega"},
+    {CameraModel::SIMPLE_RADIAL_FISHEYE, "f, cx, cy, k"},
+    {CameraModel::RADIAL_FISHEYE, "f, cx, cy, k1, k2"},
+    {CameraModel::THIN_PRISM_FISHEYE, "fx, fy, cx, cy, k1, k2, p1, p2, k3, k4, sx1, sy1"},
+    {CameraModel::UNKNOWN, ""},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(cameraModelParamLayouts), "cameraModelParamLayouts must list CameraModel in declaration order");
+
+// Comma-separated parameter names, e.g. "fx, fy, cx, cy" for PINHOLE, empty for UNKNOWN and invalid values
+constexpr std::string_view cameraModelParamLayout(CameraModel cameraModel) noexcept {
+    const size_t index = static_cast<size_t>(cameraModel);
+    return index < std::size(cameraModelParamLayouts) ? cameraModelParamLayouts[index].name : std::string_view();
 }
 
 inline std::ostream & operator<< (std::ostream &out, oscp::CameraModel const &cameraModel) {
@@ -212,32 +224,17 @@ inline std::ostream & operator<< (std::ostream &out, oscp::CameraModel const &ca
     return out;
 }
 
-inline enum CameraModel cameraModelFromString(const std::string& str) {
-    if (str.compare("SIMPLE_PINHOLE")==0) {
-        return CameraModel::SIMPLE_PINHOLE;
-    } else if (str.compare("PINHOLE")==0) {
-        return CameraModel::PINHOLE;
-    } else if (str.compare("SIMPLE_RADIAL")==0) {
-        return CameraModel::SIMPLE_RADIAL;
-    } else if (str.compare("RADIAL")==0) {
-        return CameraModel::RADIAL;
-    } else if (str.compare("OPENCV")==0) {
-        return CameraModel::OPENCV;
-    } else if (str.compare("OPENCV_FISHEYE")==0) {
-        return CameraModel::OPENCV_FISHEYE;
-    } else if (str.compare("FULL_OPENCV")==0) {
-        return CameraModel::FULL_OPENCV;
-    } else if (str.compare("FOV")==0) {
-        return CameraModel::FOV;
-    } else if (str.compare("SIMPLE_RADIAL_FISHEYE")==0) {
-        return CameraModel::SIMPLE_RADIAL_FISHEYE;
-    } else if (str.compare("RADIAL_FISHEYE")==0) {
-        return CameraModel::RADIAL_FISHEYE;
-    } else if (str.compare("THIN_PRISM_FISHEYE")==0) {
-        return CameraModel::THIN_PRISM_FISHEYE;
-    } else {
-        throw std::runtime_error("Unknown camera model: " + str);
+// Returns false if str is not the name of a camera model
+constexpr bool tryParse(std::string_view str, CameraModel& cameraModel) noexcept {
+    return enum_strings_detail::tryParse(cameraModelNames, str, cameraModel);
+}
+
+inline enum CameraModel cameraModelFromString(std::string_view str) {
+    CameraModel cameraModel = CameraModel::UNKNOWN;
+    if (!tryParse(str, cameraModel)) {
+        throw std::runtime_error("Unknown camera model: " + std::string(str));
     }
+    return cameraModel;
 }
 
 struct Vector3 {
@@ -246,36 +243,86 @@ struct Vector3 {
     float z = 0.0f;
 };
 
+/**
+* All strings and containers of the protocol structs are allocator-aware (std::pmr),
+* so that a whole request can be allocated from a single memory resource, e.g. a
+* per-request std::pmr::monotonic_buffer_resource that is released in one shot.
+* Default-constructed objects use the default memory resource (i.e. the heap).
+* Every struct below that owns memory provides the allocator-extended constructors
+* required by uses-allocator construction, so nested containers propagate the resource.
+*/
+using allocator_type = std::pmr::polymorphic_allocator<char>;
+
 struct CameraParameters {
+    using allocator_type = oscp::allocator_type;
+
     enum CameraModel model = CameraModel::UNKNOWN; // [optional] // TODO: std::string in the v1 standard, but enum is better suited here
-    std::vector<float> modelParams; // [optional]
-    std::vector<float> minMaxDepth; // [optional] // for depth image
-    std::vector<float> minMaxDisparity; // [optional] // for disparity image
+    std::pmr::vector<float> modelParams; // [optional]
+    std::pmr::vector<float> minMaxDepth; // [optional] // for depth image
+    std::pmr::vector<float> minMaxDisparity; // [optional] // for disparity image
+
+    CameraParameters() = default;
+    explicit CameraParameters(const allocator_type& alloc)
+        : modelParams(alloc), minMaxDepth(alloc), minMaxDisparity(alloc) {}
+    CameraParameters(const CameraParameters& other, const allocator_type& alloc) : CameraParameters(alloc) { *this = other; }
+    CameraParameters(CameraParameters&& other, const allocator_type& alloc) : CameraParameters(alloc) { *this = std::move(other); }
 };
 
 struct Privacy {
-    std::vector<std::string> dataRetention; //acceptable policies for server-side data retention
-    std::vector<std::string> dataAcceptableUse; //acceptable policies for server-side data use
-    std::vector<std::string> dataSanitizationApplied; //client-side data sanitization applied
-    std::vector<std::string> dataSanitizationRequested; //server-side data sanitization requested
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::vector<std::pmr::string> dataRetention; //acceptable policies for server-side data retention
+    std::pmr::vector<std::pmr::string> dataAcceptableUse; //acceptable policies for server-side data use
+    std::pmr::vector<std::pmr::string> dataSanitizationApplied; //client-side data sanitization applied
+    std::pmr::vector<std::pmr::string> dataSanitizationRequested; //server-side data sanitization requested
+
+    Privacy() = default;
+    explicit Privacy(const allocator_type& alloc)
+        : dataRetention(alloc), dataAcceptableUse(alloc), dataSanitizationApplied(alloc), dataSanitizationRequested(alloc) {}
+    Privacy(const Privacy& other, const allocator_type& alloc) : Privacy(alloc) { *this = other; }
+    Privacy(Privacy&& other, const allocator_type& alloc) : Privacy(alloc) { *this = std::move(other); }
 };
 
+inline bool operator==(const Privacy& lhs, const Privacy& rhs) {
+    return lhs.dataRetention == rhs.dataRetention
+        && lhs.dataAcceptableUse == rhs.dataAcceptableUse
+        && lhs.dataSanitizationApplied == rhs.dataSanitizationApplied
+        && lhs.dataSanitizationRequested == rhs.dataSanitizationRequested;
+}
+
+inline bool operator!=(const Privacy& lhs, const Privacy& rhs) {
+    return !(lhs == rhs);
+}
+
+/**
+Dense integer handle of a sensor: its index in GeoPoseRequest::sensors.
+Readings reference their sensor by sensorId on the wire, indexSensors() resolves the handles once after parsing.
+*/
+using SensorHandle = std::uint32_t;
+constexpr SensorHandle invalidSensorHandle = std::numeric_limits<SensorHandle>::max();
+
 struct BaseSensorReading {
+    using allocator_type = oscp::allocator_type;
+
     std::time_t timestamp; // The number of milliseconds since the Unix Epoch.
-    std::string sensorId;
-    struct Privacy privacy = Privacy();
+    std::pmr::string sensorId;
+    std::optional<Privacy> privacy; // [optional] // if not set, the reading inherits GeoPoseRequest::privacy
+    SensorHandle sensorHandle = invalidSensorHandle; // not serialized // set by indexSensors()
 
     //SensorType _sensorType = SensorType::UNKNOWN;
     // added by Gabor to be able to determine how to parse a received SensorReading
     // Currently an AccelerometerReading, a GyroscopeReading, and a MagnetometerReading would look exactly the same!
     // We could find out the sensorType via Sensors[sensorId] but there is no guarantee that the Sensors were parsed already and stored anywhere.
+
+    BaseSensorReading() = default;
+    explicit BaseSensorReading(const allocator_type& alloc) : sensorId(alloc) {}
 };
 
 struct CameraReading : public BaseSensorReading {
     size_t sequenceNumber = 0;
     enum ImageFormat imageFormat = ImageFormat::UNKNOWN; // TODO: string
     size_t size[2] = {0,0}; // width, height
-    std::string imageBytes; // base64 encoded image data
+    std::pmr::string imageBytes; // base64 encoded image data
     struct ImageOrientation imageOrientation = ImageOrientation(); // [optional]
 
     CameraParameters params;
@@ -285,6 +332,11 @@ struct CameraReading : public BaseSensorReading {
     //CameraReading() {
     //    _sensorType = SensorType::CAMERA;
     //}
+
+    CameraReading() = default;
+    explicit CameraReading(const allocator_type& alloc) : BaseSensorReading(alloc), imageBytes(alloc), params(alloc) {}
+    CameraReading(const CameraReading& other, const allocator_type& alloc) : CameraReading(alloc) { *this = other; }
+    CameraReading(CameraReading&& other, const allocator_type& alloc) : CameraReading(alloc) { *this = std::move(other); }
 };
 
 //aligns with https://w3c.github.io/geolocation-sensor/
@@ -296,59 +348,153 @@ struct GeolocationReading : BaseSensorReading {
     float altitudeAccuracy = 0.0f;
     float heading = 0.0f;
     float speed = 0.0f;
+
+    GeolocationReading() = default;
+    explicit GeolocationReading(const allocator_type& alloc) : BaseSensorReading(alloc) {}
+    GeolocationReading(const GeolocationReading& other, const allocator_type& alloc) : GeolocationReading(alloc) { *this = other; }
+    GeolocationReading(GeolocationReading&& other, const allocator_type& alloc) : GeolocationReading(alloc) { *this = std::move(other); }
 };
 
 struct WiFiReading : BaseSensorReading {
-    std::string BSSID;
+    std::pmr::string BSSID;
     float frequency = 0.0f; // TODO: shouldn't this be a band frequency range?
     float RSSI = 0.0f; // TODO: shouldn't this be a vector?
-    std::string SSID;
+    std::pmr::string SSID;
     std::time_t scanTimeStart;  // The number of milliseconds since the Unix Epoch.
     std::time_t scanTimeEnd;  // The number of milliseconds since the Unix Epoch.
+
+    WiFiReading() = default;
+    explicit WiFiReading(const allocator_type& alloc) : BaseSensorReading(alloc), BSSID(alloc), SSID(alloc) {}
+    WiFiReading(const WiFiReading& other, const allocator_type& alloc) : WiFiReading(alloc) { *this = other; }
+    WiFiReading(WiFiReading&& other, const allocator_type& alloc) : WiFiReading(alloc) { *this = std::move(other); }
 };
 
 struct BluetoothReading : BaseSensorReading {
-    std::string address;
+    std::pmr::string address;
     float RSSI = 0.0f; // TODO: shouldn't this be a vector?
-    std::string name;
+    std::pmr::string name;
+
+    BluetoothReading() = default;
+    explicit BluetoothReading(const allocator_type& alloc) : BaseSensorReading(alloc), address(alloc), name(alloc) {}
+    BluetoothReading(const BluetoothReading& other, const allocator_type& alloc) : BluetoothReading(alloc) { *this = other; }
+    BluetoothReading(BluetoothReading&& other, const allocator_type& alloc) : BluetoothReading(alloc) { *this = std::move(other); }
 };
 
 struct AccelerometerReading : BaseSensorReading {
     float x = 0.0f;
     float y = 0.0f;
     float z = 0.0f;
+
+    AccelerometerReading() = default;
+    explicit AccelerometerReading(const allocator_type& alloc) : BaseSensorReading(alloc) {}
+    AccelerometerReading(const AccelerometerReading& other, const allocator_type& alloc) : AccelerometerReading(alloc) { *this = other; }
+    AccelerometerReading(AccelerometerReading&& other, const allocator_type& alloc) : AccelerometerReading(alloc) { *this = std::move(other); }
 };
 
 struct GyroscopeReading : BaseSensorReading {
     float x = 0.0f;
     float y = 0.0f;
     float z = 0.0f;
+
+    GyroscopeReading() = default;
+    explicit GyroscopeReading(const allocator_type& alloc) : BaseSensorReading(alloc) {}
+    GyroscopeReading(const GyroscopeReading& other, const allocator_type& alloc) : GyroscopeReading(alloc) { *this = other; }
+    GyroscopeReading(GyroscopeReading&& other, const allocator_type& alloc) : GyroscopeReading(alloc) { *this = std::move(other); }
 };
 
 struct MagnetometerReading : BaseSensorReading {
     float x = 0.0f;
     float y = 0.0f;
     float z = 0.0f;
+
+    MagnetometerReading() = default;
+    explicit MagnetometerReading(const allocator_type& alloc) : BaseSensorReading(alloc) {}
+    MagnetometerReading(const MagnetometerReading& other, const allocator_type& alloc) : MagnetometerReading(alloc) { *this = other; }
+    MagnetometerReading(MagnetometerReading&& other, const allocator_type& alloc) : MagnetometerReading(alloc) { *this = std::move(other); }
+};
+
+/**
+Columnar (structure of arrays) block of 3-axis samples from one accelerometer, gyroscope or magnetometer.
+The sensorId and privacy header is shared by all samples of the block, so a sample costs 20 bytes
+instead of a full BaseSensorReading. All four arrays have the same length.
+On the wire, the samples are encoded as parallel JSON arrays "timestamps", "x", "y" and "z".
+The per-sample readings (AccelerometerReading etc.) remain supported for compatibility.
+*/
+struct ImuReadingBlock {
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::string sensorId;
+    std::optional<Privacy> privacy; // [optional] // if not set, the block inherits GeoPoseRequest::privacy
+    SensorHandle sensorHandle = invalidSensorHandle; // not serialized // set by indexSensors()
+    std::pmr::vector<std::time_t> timestamps; // The number of milliseconds since the Unix Epoch.
+    std::pmr::vector<float> x;
+    std::pmr::vector<float> y;
+    std::pmr::vector<float> z;
+
+    ImuReadingBlock() = default;
+    explicit ImuReadingBlock(const allocator_type& alloc)
+        : sensorId(alloc), timestamps(alloc), x(alloc), y(alloc), z(alloc) {}
+    ImuReadingBlock(const ImuReadingBlock& other, const allocator_type& alloc) : ImuReadingBlock(alloc) { *this = other; }
+    ImuReadingBlock(ImuReadingBlock&& other, const allocator_type& alloc) : ImuReadingBlock(alloc) { *this = std::move(other); }
+
+    size_t size() const {
+        return timestamps.size();
+    }
+
+    void reserve(size_t n) {
+        timestamps.reserve(n);
+        x.reserve(n);
+        y.reserve(n);
+        z.reserve(n);
+    }
+
+    void push_back(std::time_t timestamp, float sampleX, float sampleY, float sampleZ) {
+        timestamps.push_back(timestamp);
+        x.push_back(sampleX);
+        y.push_back(sampleY);
+        z.push_back(sampleZ);
+    }
 };
 
 struct Sensor {
+    using allocator_type = oscp::allocator_type;
+
     SensorType type = SensorType::UNKNOWN; //std::string type; // camera, geolocation, wifi, bluetooth, accelerometer, gyroscope, magnetometer
-    std::string id;
-    std::string name; // [optional]
-    std::string model; // [optional] // TODO: is this CameraModel or other model? If CameraModel, it is redundant here and should be inside params only.
-    std::string rigIdentifier; // [optional]
+    std::pmr::string id;
+    std::pmr::string name; // [optional]
+    std::pmr::string model; // [optional] // TODO: is this CameraModel or other model? If CameraModel, it is redundant here and should be inside params only.
+    std::pmr::string rigIdentifier; // [optional]
     struct Quaternion rigRotation; // [optional] // rotation quaternion from rig to sensor
     struct Vector3 rigTranslation; // [optional] //  translation vector from rig to sensor
+
+    Sensor() = default;
+    explicit Sensor(const allocator_type& alloc) : id(alloc), name(alloc), model(alloc), rigIdentifier(alloc) {}
+    Sensor(const Sensor& other, const allocator_type& alloc) : Sensor(alloc) { *this = other; }
+    Sensor(Sensor&& other, const allocator_type& alloc) : Sensor(alloc) { *this = std::move(other); }
 };
 
 struct SensorReadings {
-    std::vector<CameraReading> cameraReadings;
-    std::vector<AccelerometerReading> accelerometerReadings;
-    std::vector<GeolocationReading> geolocationReadings;
-    std::vector<WiFiReading> wifiReadings;
-    std::vector<BluetoothReading> bluetoothReadings;
-    std::vector<GyroscopeReading> gyroscopeReadings;
-    std::vector<MagnetometerReading> magnetometerReadings;
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::vector<CameraReading> cameraReadings;
+    std::pmr::vector<AccelerometerReading> accelerometerReadings;
+    std::pmr::vector<GeolocationReading> geolocationReadings;
+    std::pmr::vector<WiFiReading> wifiReadings;
+    std::pmr::vector<BluetoothReading> bluetoothReadings;
+    std::pmr::vector<GyroscopeReading> gyroscopeReadings;
+    std::pmr::vector<MagnetometerReading> magnetometerReadings;
+    // Compact alternatives to the per-sample IMU readings above, see ImuReadingBlock
+    std::pmr::vector<ImuReadingBlock> accelerometerBlocks;
+    std::pmr::vector<ImuReadingBlock> gyroscopeBlocks;
+    std::pmr::vector<ImuReadingBlock> magnetometerBlocks;
+
+    SensorReadings() = default;
+    explicit SensorReadings(const allocator_type& alloc)
+        : cameraReadings(alloc), accelerometerReadings(alloc), geolocationReadings(alloc), wifiReadings(alloc),
+          bluetoothReadings(alloc), gyroscopeReadings(alloc), magnetometerReadings(alloc),
+          accelerometerBlocks(alloc), gyroscopeBlocks(alloc), magnetometerBlocks(alloc) {}
+    SensorReadings(const SensorReadings& other, const allocator_type& alloc) : SensorReadings(alloc) { *this = other; }
+    SensorReadings(SensorReadings&& other, const allocator_type& alloc) : SensorReadings(alloc) { *this = std::move(other); }
 };
 
 struct GeoPoseAccuracy {
@@ -357,22 +503,179 @@ struct GeoPoseAccuracy {
 };
 
 struct GeoPoseResponse {
-    std::string type = "geopose"; //ex. geopose
-    std::string id; // UUID
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::string type = "geopose"; //ex. geopose
+    std::pmr::string id; // UUID
     std::time_t timestamp; // TODO: uint64_t timestamp;? // The number of milliseconds since the Unix Epoch.
     struct GeoPoseAccuracy accuracy;
     struct GeoPose geopose;
+
+    GeoPoseResponse() = default;
+    explicit GeoPoseResponse(const allocator_type& alloc) : type("geopose", alloc), id(alloc) {}
+    GeoPoseResponse(const GeoPoseResponse& other, const allocator_type& alloc) : GeoPoseResponse(alloc) { *this = other; }
+    GeoPoseResponse(GeoPoseResponse&& other, const allocator_type& alloc) : GeoPoseResponse(alloc) { *this = std::move(other); }
 };
 
 struct GeoPoseRequest {
-    std::string type = "geopose"; //ex. geopose
-    std::string id; // UUID
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::string type = "geopose"; //ex. geopose
+    std::pmr::string id; // UUID
     std::time_t timestamp; // TODO: uint64_t? timestamp;? // The number of milliseconds since the Unix Epoch.
-    std::vector<Sensor> sensors;
+    std::optional<Privacy> privacy; // [optional] // default for all readings that do not specify their own privacy
+    std::pmr::vector<Sensor> sensors;
+    std::pmr::string sensorsToken; // [optional] // instead of sensors: a sensor set the server acknowledged earlier, see resolveSensors()
     SensorReadings sensorReadings;
-    std::vector<GeoPoseResponse> priorPoses; // [optional] // previous geoposes // TODO: are these of type GeoPose or GeoPoseResponse?
+    std::pmr::vector<GeoPoseResponse> priorPoses; // [optional] // previous geoposes // TODO: are these of type GeoPose or GeoPoseResponse?
+
+    GeoPoseRequest() = default;
+    explicit GeoPoseRequest(const allocator_type& alloc)
+        : type("geopose", alloc), id(alloc), sensors(alloc), sensorsToken(alloc), sensorReadings(alloc), priorPoses(alloc) {}
+    GeoPoseRequest(const GeoPoseRequest& other, const allocator_type& alloc) : GeoPoseRequest(alloc) { *this = other; }
+    GeoPoseRequest(GeoPoseRequest&& other, const allocator_type& alloc) : GeoPoseRequest(alloc) { *this = std::move(other); }
+};
+
+/**
+Converts per-sample IMU readings (AccelerometerReading, GyroscopeReading or MagnetometerReading)
+into columnar blocks. Consecutive readings with the same sensorId and privacy end up in the same block.
+*/
+template<typename ImuReading>
+void appendImuReadingBlocks(const std::pmr::vector<ImuReading>& readings, std::pmr::vector<ImuReadingBlock>& blocks) {
+    for (const ImuReading& reading : readings) {
+        if (blocks.empty() || blocks.back().sensorId != reading.sensorId || blocks.back().privacy != reading.privacy) {
+            ImuReadingBlock& block = blocks.emplace_back();
+            block.sensorId = reading.sensorId;
+            block.privacy = reading.privacy;
+        }
+        blocks.back().push_back(reading.timestamp, reading.x, reading.y, reading.z);
+    }
+}
+
+/**
+Expands a columnar block back into per-sample IMU readings, e.g. for code that only understands the per-sample form.
+*/
+template<typename ImuReading>
+void appendImuReadings(const ImuReadingBlock& block, std::pmr::vector<ImuReading>& readings) {
+    readings.reserve(readings.size() + block.size());
+    for (size_t i = 0; i < block.size(); i++) {
+        ImuReading& reading = readings.emplace_back();
+        reading.timestamp = block.timestamps[i];
+        reading.sensorId = block.sensorId;
+        reading.privacy = block.privacy;
+        reading.x = block.x[i];
+        reading.y = block.y[i];
+        reading.z = block.z[i];
+    }
+}
+
+/**
+Resolves the sensorHandle of every reading and IMU block of the request from its sensorId.
+Called by from_json after parsing; call it again after building or modifying a request by hand.
+Throws std::runtime_error if sensor IDs are not unique, if a reading references an undeclared sensor,
+or if a reading references a sensor of another type (e.g. a camera reading of a gyroscope sensor).
+*/
+void indexSensors(GeoPoseRequest& request);
+
+/**
+Same as indexSensors(), but returns what is wrong instead of throwing,
+e.g. UNDECLARED_SENSOR at "/sensorReadings/cameraReadings/0/sensorId".
+*/
+std::optional<ParseError> tryIndexSensors(GeoPoseRequest& request);
+
+/**
+Returns the sensor of a reading (or ImuReadingBlock) in O(1). Requires indexSensors() to have been called.
+*/
+template<typename Reading>
+const Sensor& sensorOf(const Reading& reading, const GeoPoseRequest& request) {
+    if (reading.sensorHandle >= request.sensors.size()) {
+        throw std::out_of_range("The sensor of reading " + std::string(reading.sensorId) + " is not indexed");
+    }
+    return request.sensors[reading.sensorHandle];
+}
+
+/**
+Returns the privacy that applies to a reading (or ImuReadingBlock) of the request:
+its own privacy if set, otherwise the request-level default, otherwise an empty Privacy.
+*/
+template<typename Reading>
+const Privacy& effectivePrivacy(const Reading& reading, const GeoPoseRequest& request) {
+    static const Privacy noPrivacy;
+    if (reading.privacy.has_value()) {
+        return *reading.privacy;
+    }
+    if (request.privacy.has_value()) {
+        return *request.privacy;
+    }
+    return noPrivacy;
+}
+
+/**
+Moves repeated per-reading privacy into the request-level default, so it is held only once in memory.
+to_json() still writes the effective privacy into every reading for servers that require it there.
+If the request has no default yet, the most common privacy of the readings becomes the default,
+but only if every reading has its own privacy (otherwise the readings without one would start inheriting it).
+Readings whose privacy equals the default are reset to inherit it. The effective privacy of every reading is unchanged.
+*/
+void factorOutPrivacy(GeoPoseRequest& request);
+
+struct SessionCamera {
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::string sensorId;
+    CameraParameters params;
+
+    SessionCamera() = default;
+    explicit SessionCamera(const allocator_type& alloc) : sensorId(alloc), params(alloc) {}
+    SessionCamera(const SessionCamera& other, const allocator_type& alloc) : SessionCamera(alloc) { *this = other; }
+    SessionCamera(SessionCamera&& other, const allocator_type& alloc) : SessionCamera(alloc) { *this = std::move(other); }
+};
+
+/**
+Sent once at the start of a localization session (protocol extension): the parts of a GeoPoseRequest that
+stay the same for all frames of a continuously localizing client. The frames of the session are GeoPoseRequests
+without sensors, whose camera readings may also leave out their params (see parseGeoPoseFrame).
+*/
+struct GeoPoseSession {
+    using allocator_type = oscp::allocator_type;
+
+    std::pmr::string type = "geopose-session";
+    std::optional<Privacy> privacy; // [optional] // default for all readings of all frames
+    std::pmr::vector<Sensor> sensors;
+    std::pmr::vector<SessionCamera> cameras; // [optional] // intrinsics of the camera sensors
+
+    GeoPoseSession() = default;
+    explicit GeoPoseSession(const allocator_type& alloc)
+        : type("geopose-session", alloc), sensors(alloc), cameras(alloc) {}
+    GeoPoseSession(const GeoPoseSession& other, const allocator_type& alloc) : GeoPoseSession(alloc) { *this = other; }
+    GeoPoseSession(GeoPoseSession&& other, const allocator_type& alloc) : GeoPoseSession(alloc) { *this = std::move(other); }
 };
 
+/**
+Checks that the sensor IDs of the session are unique and that every camera references a declared camera sensor.
+Throws std::runtime_error otherwise.
+*/
+void validateSession(const GeoPoseSession& session);
+
+// Same as validateSession(), but returns what is wrong instead of throwing
+std::optional<ParseError> tryValidateSession(const GeoPoseSession& session);
+
+/**
+Completes a request that left out what the session (or sensor set) already declared:
+copies the sensors, makes the session privacy the request-level default unless the request has its own,
+gives camera readings without params the params of their camera, then calls indexSensors().
+*/
+void resolveSensors(GeoPoseRequest& request, const GeoPoseSession& session);
+
+// Same as resolveSensors(), but returns what is wrong instead of throwing
+std::optional<ParseError> tryResolveSensors(GeoPoseRequest& request, const GeoPoseSession& session);
+
+/**
+The sensor set of a complete request: its sensors, its request-level privacy and the params of
+the first camera reading of each camera sensor. The reverse of resolveSensors().
+*/
+GeoPoseSession sessionOf(const GeoPoseRequest& request);
+
 // TODO: add protocol version number in request and response
 
 } // namespace oscp
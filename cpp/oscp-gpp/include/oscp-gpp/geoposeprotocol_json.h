@@ -18,39 +18,14 @@ using json = nlohmann::json;
 
 namespace oscp {
 
-NLOHMANN_JSON_SERIALIZE_ENUM(SensorType, {
-    {SensorType::CAMERA, "camera"},
-    {SensorType::GEOLOCATION, "geolocation"},
-    {SensorType::WIFI, "wifi"},
-    {SensorType::BLUETOOTH, "bluetooth"},
-    {SensorType::ACCELEROMETER, "accelerometer"},
-    {SensorType::GYROSCOPE, "gyroscope"},
-    {SensorType::MAGNETOMETER, "magnetometer"},
-    {SensorType::UNKNOWN, "UNKNOWN"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(ImageFormat, {
-    {ImageFormat::RGBA32, "RGBA32"},
-    {ImageFormat::GRAY8, "GRAY8"},
-    {ImageFormat::DEPTH, "DEPTH"},
-    {ImageFormat::JPG, "JPG"},
-    {ImageFormat::UNKNOWN, "UNKNOWN"},
-});
-
-NLOHMANN_JSON_SERIALIZE_ENUM(CameraModel, {
-    {CameraModel::SIMPLE_PINHOLE, "SIMPLE_PINHOLE"},
-    {CameraModel::PINHOLE, "PINHOLE"},
-    {CameraModel::SIMPLE_RADIAL, "SIMPLE_RADIAL"},
-    {CameraModel::RADIAL, "RADIAL"},
-    {CameraModel::OPENCV, "OPENCV"},
-    {CameraModel::OPENCV_FISHEYE, "OPENCV_FISHEYE"},
-    {CameraModel::FULL_OPENCV, "FULL_OPENCV"},
-    {CameraModel::FOV, "FOV"},
-    {CameraModel::SIMPLE_RADIAL_FISHEYE, "SIMPLE_RADIAL_FISHEYE"},
-    {CameraModel::RADIAL_FISHEYE, "RADIAL_FISHEYE"},
-    {CameraModel::THIN_PRISM_FISHEYE, "THIN_PRISM_FISHEYE"},
-    {CameraModel::UNKNOWN, "UNKNOWN"}
-});
+// The enums are written by name; names that are not known are read as UNKNOWN.
+// Both directions use the lookup tables of geoposeprotocol.h instead of comparing json values.
+void to_json(json& j, SensorType t);
+void from_json(const json& j, SensorType& t);
+void to_json(json& j, ImageFormat t);
+void from_json(const json& j, ImageFormat& t);
+void to_json(json& j, CameraModel t);
+void from_json(const json& j, CameraModel& t);
 
 void to_json(json& j, const Vector3& v);
 void from_json(const json& j, Vector3& v);
@@ -74,6 +49,8 @@ void to_json(json& j, const GyroscopeReading& t);
 void from_json(const json& j, GyroscopeReading& t);
 void to_json(json& j, const MagnetometerReading& t);
 void from_json(const json& j, MagnetometerReading& t);
+void to_json(json& j, const ImuReadingBlock& t);
+void from_json(const json& j, ImuReadingBlock& t);
 void to_json(json& j, const Sensor& t);
 void from_json(const json& j, Sensor& t);
 void to_json(json& j, const SensorReadings& t);
@@ -83,8 +60,53 @@ void from_json(const json& j, GeoPoseAccuracy& t);
 void to_json(json& j, const GeoPoseResponse& t);
 void from_json(const json& j, GeoPoseResponse& t);
 void to_json(json& j, const GeoPoseRequest& t);
+
+/**
+A request with a "sensorsToken" instead of "sensors" is parsed without its sensors and without indexing them,
+the receiver resolves the token to a GeoPoseSession and calls resolveSensors(), see SensorRegistry.
+*/
 void from_json(const json& j, GeoPoseRequest& t);
 
+/**
+Parses a GeoPoseRequest with all of its strings and containers allocated from the given memory resource,
+e.g. a per-request std::pmr::monotonic_buffer_resource that is released in one shot after the response was sent.
+The memory resource must outlive the returned request.
+*/
+GeoPoseRequest parseGeoPoseRequest(const json& j, std::pmr::memory_resource* resource);
+
+void to_json(json& j, const SessionCamera& t);
+void from_json(const json& j, SessionCamera& t);
+void to_json(json& j, const GeoPoseSession& t);
+void from_json(const json& j, GeoPoseSession& t);
+
+/**
+Parses a frame of a localization session: a GeoPoseRequest whose "sensors" are left out because they were
+declared once in the GeoPoseSession. The sensors are copied from the session, the session privacy becomes
+the request-level privacy unless the frame has its own, and camera readings without "params" get the params
+of their camera from the session. The request is allocated from the given memory resource like with parseGeoPoseRequest.
+*/
+GeoPoseRequest parseGeoPoseFrame(const json& j, const GeoPoseSession& session, std::pmr::memory_resource* resource);
+
+/**
+Non-throwing parsing for the hot path of a server, where invalid input is routine and must not cost an exception.
+The tryParse functions read the document in a single pass and report the first violation of the protocol
+through the returned ParseResult: its ParseErrorCode and a JSON pointer to the offending value,
+e.g. MISSING_FIELD at "/sensorReadings/cameraReadings/0/imageFormat".
+The throwing functions above share the same reader and throw std::runtime_error with the message and the path.
+*/
+
+// Parses a JSON text, a syntax error is reported as INVALID_JSON with its byte offset in the message
+ParseResult<json> tryParseJson(std::string_view text);
+
+// Same as parseGeoPoseRequest(), but without exceptions on invalid input
+ParseResult<GeoPoseRequest> tryParseGeoPoseRequest(const json& j, std::pmr::memory_resource* resource);
+
+// Same as parseGeoPoseFrame(), but without exceptions on invalid input
+ParseResult<GeoPoseRequest> tryParseGeoPoseFrame(const json& j, const GeoPoseSession& session, std::pmr::memory_resource* resource);
+
+// Same as from_json(GeoPoseSession), but without exceptions on invalid input
+ParseResult<GeoPoseSession> tryParseGeoPoseSession(const json& j);
+
 } // namespace oscp
 
 #endif // _OSCP_GEOPOSE_PROTOCOL_JSON_H_
@@ -0,0 +1,60 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_HASH_H_
+#define _OSCP_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace oscp {
+
+/**
+XXH64 of the data, compatible with the reference xxHash implementation (https://github.com/Cyan4973/xxHash).
+Not a cryptographic hash. Reads several GB/s, so hashing an image costs much less than decoding it.
+*/
+uint64_t xxh64(const void* data, size_t size, uint64_t seed = 0);
+
+inline uint64_t xxh64(std::string_view data, uint64_t seed = 0) {
+    return xxh64(data.data(), data.size(), seed);
+}
+
+/**
+Streaming XXH64: update() with the pieces of the input in order, then digest().
+The digest equals xxh64() of the concatenated pieces.
+*/
+class Xxh64 {
+public:
+    explicit Xxh64(uint64_t seed = 0);
+
+    void update(const void* data, size_t size);
+
+    void update(std::string_view data) {
+        update(data.data(), data.size());
+    }
+
+    // Hashes the object representation of a trivially copyable value
+    template<typename T>
+    void updateValue(const T& value) {
+        update(&value, sizeof(T));
+    }
+
+    uint64_t digest() const;
+
+private:
+    uint64_t accumulators_[4];
+    uint64_t seed_;
+    uint64_t totalSize_ = 0;
+    unsigned char buffer_[32];
+    size_t bufferSize_ = 0;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_HASH_H_
@@ -0,0 +1,81 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_HTTP_RESPONSE_PARSER_H_
+#define _OSCP_HTTP_RESPONSE_PARSER_H_
+
+#include <oscp-gpp/async_client.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace oscp {
+
+enum class HttpParseStatus {
+    INCOMPLETE, // more bytes are needed
+    COMPLETE,
+    INVALID, // not an HTTP/1.x response, or broken framing
+    TOO_LARGE // headers above 64 KiB or a body above maxBodyBytes
+};
+
+/**
+Reads one HTTP/1.1 response from the bytes of a connection as they arrive: the status line, the headers and a body
+delimited by Content-Length, chunked transfer coding or the end of the connection. The body is not decompressed.
+Used by AsyncClient for each of its connections.
+*/
+class HttpResponseParser {
+public:
+    explicit HttpResponseParser(size_t maxBodyBytes);
+
+    // Prepares for the response to the next request, which has no body if it was a HEAD request
+    void reset(bool headRequest);
+
+    bool receivedAny() const {
+        return !buffer_.empty();
+    }
+
+    // Whether the connection can carry another request after the response
+    bool keepAlive() const {
+        return keepAlive_ && framing_ != Framing::UNTIL_CLOSE;
+    }
+
+    HttpParseStatus append(const char* data, size_t size);
+
+    // At the end of the connection, which completes a response that is delimited by it
+    HttpParseStatus close();
+
+    // Complete once append() or close() returned COMPLETE
+    HttpResponse& response() {
+        return response_;
+    }
+
+private:
+    enum class Framing {
+        LENGTH,
+        CHUNKED,
+        UNTIL_CLOSE
+    };
+
+    bool parseHeaders(std::string_view headers);
+    HttpParseStatus parseChunks();
+
+    const size_t maxBodyBytes_;
+    std::string buffer_;
+    size_t headerEnd_ = 0;
+    size_t chunkOffset_ = 0; // of the next chunk size line
+    Framing framing_ = Framing::LENGTH;
+    size_t contentLength_ = 0;
+    bool headRequest_ = false;
+    bool keepAlive_ = true;
+    HttpResponse response_;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_HTTP_RESPONSE_PARSER_H_
@@ -0,0 +1,81 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_IMU_PREINTEGRATION_H_
+#define _OSCP_IMU_PREINTEGRATION_H_
+
+#include <oscp-gpp/geopose.h>
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <cstddef>
+#include <ctime>
+
+namespace oscp {
+
+/**
+Non-owning view of time-ordered IMU samples stored as parallel arrays, e.g. the columns of an ImuReadingBlock.
+*/
+struct ImuSamples {
+    const std::time_t* timestamps = nullptr; // The number of milliseconds since the Unix Epoch.
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+    size_t count = 0;
+
+    ImuSamples() = default;
+    explicit ImuSamples(const ImuReadingBlock& block)
+        : timestamps(block.timestamps.data()), x(block.x.data()), y(block.y.data()), z(block.z.data()), count(block.size()) {}
+};
+
+/**
+Sensor biases subtracted from every sample before integration
+*/
+struct ImuBias {
+    double gyroscope[3] = {0.0, 0.0, 0.0}; // rad/s
+    double accelerometer[3] = {0.0, 0.0, 0.0}; // m/s^2
+};
+
+/**
+Motion of the device between two timestamps i and j, expressed in the device frame at i.
+The accelerometer measures specific force, so gravity is still contained in deltaVelocity and deltaPosition;
+with the world-frame rotation R_i, velocity v_i and gravity g of the state at i, the state at j is
+    R_j = R_i * deltaRotation
+    v_j = v_i + g * deltaTime + R_i * deltaVelocity
+    p_j = p_i + v_i * deltaTime + 0.5 * g * deltaTime^2 + R_i * deltaPosition
+*/
+struct ImuPreintegration {
+    double deltaTime = 0.0; // seconds actually covered by samples
+    Quaternion deltaRotation; // identity by default
+    double deltaVelocity[3] = {0.0, 0.0, 0.0}; // m/s
+    double deltaPosition[3] = {0.0, 0.0, 0.0}; // m
+};
+
+/**
+Integrates the gyroscope (rad/s) and accelerometer (m/s^2) samples in [begin, end) into one relative motion.
+
+The gyroscope drives the integration: each gyroscope sample is held until the next one (or until end),
+the accelerometer is linearly interpolated at the gyroscope timestamps, so the two sensors need not be synchronized.
+Time before the first gyroscope sample is not covered, see ImuPreintegration::deltaTime.
+Without accelerometer samples, only the rotation is integrated.
+Runs in O(gyroscope.count + accelerometer.count) and does not allocate.
+*/
+ImuPreintegration preintegrateImu(const ImuSamples& gyroscope, const ImuSamples& accelerometer,
+                                  std::time_t begin, std::time_t end, const ImuBias& bias = ImuBias());
+
+/**
+Rotation of the device between begin and end from the gyroscope of the readings, see preintegrateImu().
+The first gyroscope of the readings is used, with all its blocks (or per-sample readings if there are no blocks):
+a recording split into several blocks, e.g. where its privacy changes, is integrated as a whole.
+The last sample of a block is held until the next block of the sensor starts.
+Returns the identity without gyroscope samples. Per-sample readings are converted in a stack buffer for typical sample counts.
+*/
+Quaternion integrateGyroscope(const SensorReadings& readings, std::time_t begin, std::time_t end);
+
+} // namespace oscp
+
+#endif // _OSCP_IMU_PREINTEGRATION_H_
@@ -0,0 +1,107 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_MAP_SHARD_INDEX_H_
+#define _OSCP_MAP_SHARD_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oscp {
+
+/**
+Latitude/longitude aligned region in degrees (WGS84).
+If minLon > maxLon, the region crosses the antimeridian.
+*/
+struct GeoBoundingBox {
+    double minLat = 0.0;
+    double minLon = 0.0;
+    double maxLat = 0.0;
+    double maxLon = 0.0;
+
+    bool contains(double lat, double lon) const {
+        if (lat < minLat || lat > maxLat) {
+            return false;
+        }
+        if (minLon <= maxLon) {
+            return lon >= minLon && lon <= maxLon;
+        }
+        return lon >= minLon || lon <= maxLon; // crosses the antimeridian
+    }
+};
+
+/**
+A VPS map covering a region, e.g. one city.
+*/
+struct MapShard {
+    std::string id;
+    GeoBoundingBox bounds;
+};
+
+/**
+Spatial index to route a request to the map shard(s) covering its geolocation.
+
+The globe is divided into a regular grid of cells of cellSizeDegrees x cellSizeDegrees,
+each cell is identified by a 64-bit cell ID, and every shard is registered in the cells its bounds overlap.
+A lookup is one hash map probe plus a bounds check of the few shards registered in that cell,
+so it takes well below a microsecond and does not allocate.
+Shards overlapping more than maxCellsPerShard cells, e.g. a whole country at the default cell size,
+are not registered per cell but bounds checked on every lookup.
+The index is immutable after construction and can be shared between threads.
+*/
+class MapShardIndex {
+public:
+    static constexpr double defaultCellSizeDegrees = 0.05; // roughly 5 km
+    static constexpr double minCellSizeDegrees = 0.000001;
+    static constexpr size_t maxCellsPerShard = 65536; // 12.8 x 12.8 degrees at the default cell size
+
+    explicit MapShardIndex(std::vector<MapShard> shards, double cellSizeDegrees = defaultCellSizeDegrees);
+
+    /**
+    Writes the indices (into shards()) of up to maxResults shards containing the location to results,
+    in the order the shards were given. Returns the number of indices written, 0 if there is no coverage.
+    */
+    size_t find(double lat, double lon, size_t* results, size_t maxResults) const;
+
+    /**
+    Returns the first shard containing the location, or nullptr if there is no coverage.
+    */
+    const MapShard* findFirst(double lat, double lon) const;
+
+    const std::vector<MapShard>& shards() const {
+        return shards_;
+    }
+
+    bool empty() const {
+        return shards_.empty();
+    }
+
+private:
+    struct CellRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    int64_t latCell(double lat) const;
+    int64_t lonCell(double lon) const;
+    static uint64_t cellId(int64_t latCell, int64_t lonCell);
+
+    std::vector<MapShard> shards_;
+    double cellSizeDegrees_;
+    int64_t lonCellCount_;
+    std::unordered_map<uint64_t, CellRange> cells_; // cell ID -> range in cellShards_
+    std::vector<uint32_t> cellShards_; // shard indices of all cells, grouped by cell
+    std::vector<uint32_t> largeShards_; // shard indices of the shards spanning more than maxCellsPerShard cells
+};
+
+} // namespace oscp
+
+#endif // _OSCP_MAP_SHARD_INDEX_H_
@@ -0,0 +1,131 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_PARSE_RESULT_H_
+#define _OSCP_PARSE_RESULT_H_
+
+#include <oscp-gpp/enum_strings.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace oscp {
+
+enum class ParseErrorCode {
+    INVALID_JSON, // the body is not well-formed JSON
+    MISSING_FIELD,
+    WRONG_TYPE,
+    UNKNOWN_ENUM_VALUE, // e.g. an unknown camera model
+    INVALID_VALUE, // e.g. the arrays of an IMU block differ in length
+    DUPLICATE_SENSOR_ID,
+    UNDECLARED_SENSOR, // a reading references a sensor that is not declared
+    SENSOR_TYPE_MISMATCH, // a reading references a sensor of another type
+    UNKNOWN_SENSORS_TOKEN, // the server does not know (anymore) the sensorsToken of the request
+    UNKNOWN
+};
+
+inline constexpr enum_strings_detail::EnumName<ParseErrorCode> parseErrorCodeNames[] = {
+    {ParseErrorCode::INVALID_JSON, "INVALID_JSON"},
+    {ParseErrorCode::MISSING_FIELD, "MISSING_FIELD"},
+    {ParseErrorCode::WRONG_TYPE, "WRONG_TYPE"},
+    {ParseErrorCode::UNKNOWN_ENUM_VALUE, "UNKNOWN_ENUM_VALUE"},
+    {ParseErrorCode::INVALID_VALUE, "INVALID_VALUE"},
+    {ParseErrorCode::DUPLICATE_SENSOR_ID, "DUPLICATE_SENSOR_ID"},
+    {ParseErrorCode::UNDECLARED_SENSOR, "UNDECLARED_SENSOR"},
+    {ParseErrorCode::SENSOR_TYPE_MISMATCH, "SENSOR_TYPE_MISMATCH"},
+    {ParseErrorCode::UNKNOWN_SENSORS_TOKEN, "UNKNOWN_SENSORS_TOKEN"},
+    {ParseErrorCode::UNKNOWN, "UNKNOWN"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(parseErrorCodeNames), "parseErrorCodeNames must list ParseErrorCode in declaration order");
+
+constexpr std::string_view toString(ParseErrorCode code) noexcept {
+    return enum_strings_detail::nameOf(parseErrorCodeNames, code);
+}
+
+/**
+Why a message could not be parsed, and where: path is a JSON pointer (RFC 6901) to the offending value,
+e.g. "/sensorReadings/cameraReadings/0/imageFormat", or empty for the whole document.
+*/
+struct ParseError {
+    ParseErrorCode code = ParseErrorCode::UNKNOWN;
+    std::string path;
+    std::string message;
+
+    ParseError() = default;
+    ParseError(ParseErrorCode code, std::string path, std::string message)
+        : code(code), path(std::move(path)), message(std::move(message)) {}
+};
+
+/**
+Either a parsed value or the ParseError that prevented it, in the spirit of C++23 std::expected.
+Returned by the non-throwing parse functions, e.g. tryParseGeoPoseRequest().
+*/
+template<typename T>
+class ParseResult {
+public:
+    // Taking T&& makes a plain "return value;" move, which keeps the memory resource of allocator-aware values
+    ParseResult(T&& value) : result_(std::in_place_index<0>, std::move(value)) {}
+    ParseResult(const T& value) : result_(std::in_place_index<0>, value) {}
+    ParseResult(ParseError&& error) : result_(std::in_place_index<1>, std::move(error)) {}
+    ParseResult(const ParseError& error) : result_(std::in_place_index<1>, error) {}
+
+    bool has_value() const noexcept {
+        return result_.index() == 0;
+    }
+
+    explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    // Requires has_value()
+    T& value() & {
+        return *std::get_if<0>(&result_);
+    }
+
+    const T& value() const & {
+        return *std::get_if<0>(&result_);
+    }
+
+    T&& value() && {
+        return std::move(*std::get_if<0>(&result_));
+    }
+
+    T& operator*() & {
+        return value();
+    }
+
+    const T& operator*() const & {
+        return value();
+    }
+
+    T&& operator*() && {
+        return std::move(*this).value();
+    }
+
+    T* operator->() {
+        return &value();
+    }
+
+    const T* operator->() const {
+        return &value();
+    }
+
+    // Requires !has_value()
+    const ParseError& error() const {
+        return *std::get_if<1>(&result_);
+    }
+
+private:
+    std::variant<T, ParseError> result_;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_PARSE_RESULT_H_
@@ -0,0 +1,105 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_POSE_TRACKER_H_
+#define _OSCP_POSE_TRACKER_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace oscp {
+
+/**
+When the PoseTracker may answer a request by propagating a prior pose instead of a full localization
+*/
+struct PoseTrackerPolicy {
+    std::time_t maxPriorAgeMs = 500; // priors older than this are never propagated
+    float positionAccuracyGrowth = 0.5f; // meters per second since the prior
+    float orientationAccuracyGrowth = 5.0f; // degrees per second since the prior
+    float maxPositionAccuracy = 1.0f; // meters, a propagated pose must stay within this accuracy
+    float maxOrientationAccuracy = 5.0f; // degrees, a propagated pose must stay within this accuracy
+    std::time_t sessionTimeoutMs = 60000; // sessions without requests for this long are forgotten
+};
+
+struct PoseTrackerStats {
+    uint64_t hits = 0; // requests answered by propagation
+    uint64_t missesNoPrior = 0; // no pose of the session is remembered
+    uint64_t missesStalePrior = 0; // the prior is older than maxPriorAgeMs (or newer than the request)
+    uint64_t missesInaccurate = 0; // the propagated accuracy would exceed the policy limits
+
+    uint64_t misses() const {
+        return missesNoPrior + missesStalePrior + missesInaccurate;
+    }
+
+    double hitRate() const {
+        const uint64_t total = hits + misses();
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+Server-side fast path for clients that localize several times per second.
+
+For every client session, the tracker remembers the last pose the server computed for it. If that pose is fresh enough,
+the request is answered by propagating it with the gyroscope readings of the request instead of a full localization.
+Poses sent by the client, e.g. GeoPoseRequest::priorPoses, are never propagated, and the session key must be issued
+by the server and unguessable (e.g. the ID of a LocalizationSession), never a client-chosen header.
+The accuracy of a propagated pose grows with the time since the prior, so clients are sent to full localization
+once the accuracy exceeds the policy limits. All methods are thread-safe.
+*/
+class PoseTracker {
+public:
+    explicit PoseTracker(const PoseTrackerPolicy& policy = PoseTrackerPolicy());
+
+    /**
+    Tries to answer the request by propagating a prior pose. On success, fills response, remembers it as the
+    new prior of the session and returns true. An empty sessionKey never has a prior.
+    */
+    bool tryPropagate(const std::string& sessionKey, const GeoPoseRequest& request, GeoPoseResponse& response);
+
+    /**
+    Remembers the result of a full localization as the prior of the session.
+    */
+    void accept(const std::string& sessionKey, const GeoPoseResponse& response);
+
+    PoseTrackerStats stats() const;
+
+    const PoseTrackerPolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    struct Prior {
+        std::time_t timestamp = 0;
+        GeoPoseAccuracy accuracy;
+        GeoPose geopose;
+        std::chrono::steady_clock::time_point lastSeen;
+    };
+
+    void remember(const std::string& sessionKey, const Prior& prior);
+
+    const PoseTrackerPolicy policy_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Prior> sessions_;
+    uint64_t updatesSinceSweep_ = 0;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> missesNoPrior_{0};
+    std::atomic<uint64_t> missesStalePrior_{0};
+    std::atomic<uint64_t> missesInaccurate_{0};
+};
+
+} // namespace oscp
+
+#endif // _OSCP_POSE_TRACKER_H_
@@ -0,0 +1,86 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_QUATERNION_UTILS_H_
+#define _OSCP_QUATERNION_UTILS_H_
+
+#include <oscp-gpp/geopose.h>
+
+#include <cmath>
+
+namespace oscp {
+
+// Hamilton product: the rotation b followed by the rotation a, i.e. a * b
+inline Quaternion multiply(const Quaternion& a, const Quaternion& b) {
+    Quaternion q;
+    q.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+    q.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    q.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+    q.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+    return q;
+}
+
+inline Quaternion conjugate(const Quaternion& q) {
+    Quaternion c;
+    c.x = -q.x;
+    c.y = -q.y;
+    c.z = -q.z;
+    c.w = q.w;
+    return c;
+}
+
+inline Quaternion normalized(const Quaternion& q) {
+    const double norm = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (norm <= 0.0) {
+        return Quaternion();
+    }
+    Quaternion n;
+    n.x = q.x / norm;
+    n.y = q.y / norm;
+    n.z = q.z / norm;
+    n.w = q.w / norm;
+    return n;
+}
+
+// Exponential map: the rotation by the angle |(x, y, z)| in radians around the axis (x, y, z)
+inline Quaternion fromRotationVector(double x, double y, double z) {
+    const double angle = std::sqrt(x * x + y * y + z * z);
+    Quaternion q;
+    if (angle < 1e-9) {
+        // first order approximation, avoids the division by zero
+        q.x = 0.5 * x;
+        q.y = 0.5 * y;
+        q.z = 0.5 * z;
+        q.w = 1.0;
+        return normalized(q);
+    }
+    const double s = std::sin(0.5 * angle) / angle;
+    q.x = s * x;
+    q.y = s * y;
+    q.z = s * z;
+    q.w = std::cos(0.5 * angle);
+    return q;
+}
+
+// Rotates the vector v by the unit quaternion q, writes the result to out (may alias v)
+inline void rotate(const Quaternion& q, const double v[3], double out[3]) {
+    // t = 2 * cross(q.xyz, v); out = v + q.w * t + cross(q.xyz, t)
+    const double tx = 2.0 * (q.y * v[2] - q.z * v[1]);
+    const double ty = 2.0 * (q.z * v[0] - q.x * v[2]);
+    const double tz = 2.0 * (q.x * v[1] - q.y * v[0]);
+    const double rx = v[0] + q.w * tx + (q.y * tz - q.z * ty);
+    const double ry = v[1] + q.w * ty + (q.z * tx - q.x * tz);
+    const double rz = v[2] + q.w * tz + (q.x * ty - q.y * tx);
+    out[0] = rx;
+    out[1] = ry;
+    out[2] = rz;
+}
+
+} // namespace oscp
+
+#endif // _OSCP_QUATERNION_UTILS_H_
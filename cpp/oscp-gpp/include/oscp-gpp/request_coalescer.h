@@ -0,0 +1,89 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_REQUEST_COALESCER_H_
+#define _OSCP_REQUEST_COALESCER_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace oscp {
+
+struct RequestCoalescerPolicy {
+    std::time_t completedTtlMs = 30000; // how long a completed response is replayed to retries
+    size_t maxCompleted = 10000; // the oldest completed responses are dropped above this
+};
+
+struct RequestCoalescerStats {
+    uint64_t executed = 0; // requests that ran the localization
+    uint64_t coalesced = 0; // duplicates that waited for an in-flight original
+    uint64_t replayed = 0; // duplicates answered from the completed responses
+    uint64_t failed = 0; // executions that threw, their duplicates get the same exception
+    size_t inFlight = 0;
+    size_t completed = 0;
+};
+
+/**
+Makes GeoPoseRequests idempotent by their id (a UUID generated by the client).
+
+The first request with a key runs the localization. A duplicate arriving while it is in flight waits for
+the same result instead of localizing again, and a duplicate arriving later gets the stored response
+for completedTtlMs. Failures are handed to the waiting duplicates but not stored, so a later retry runs again.
+Callers should include the client identity in the key, so one client cannot replay another client's response.
+All methods are thread-safe.
+*/
+class RequestCoalescer {
+public:
+    explicit RequestCoalescer(const RequestCoalescerPolicy& policy = RequestCoalescerPolicy());
+
+    /**
+    Returns the response for the key, calling localize only if no other call with the same key
+    is in flight or completed recently. An empty key disables deduplication for this call.
+    Exceptions thrown by localize are rethrown to the caller and to all coalesced duplicates.
+    */
+    GeoPoseResponse run(const std::string& key, const std::function<GeoPoseResponse()>& localize);
+
+    RequestCoalescerStats stats() const;
+
+    const RequestCoalescerPolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    struct Completed {
+        GeoPoseResponse response;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    void complete(const std::string& key, const GeoPoseResponse& response); // requires mutex_
+
+    const RequestCoalescerPolicy policy_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<GeoPoseResponse>> inFlight_;
+    std::unordered_map<std::string, Completed> completed_;
+    std::deque<std::pair<std::string, std::chrono::steady_clock::time_point>> completedOrder_; // completed_ by expiry
+
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> replayed_{0};
+    std::atomic<uint64_t> failed_{0};
+};
+
+} // namespace oscp
+
+#endif // _OSCP_REQUEST_COALESCER_H_
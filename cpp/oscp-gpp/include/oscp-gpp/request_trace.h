@@ -0,0 +1,146 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_REQUEST_TRACE_H_
+#define _OSCP_REQUEST_TRACE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace oscp {
+
+/**
+The timed stages of handling one request, e.g. reading the body, parsing, localizing and serializing.
+Spans are stored in a fixed array without allocating, with the monotonic clock (std::chrono::steady_clock) in nanoseconds.
+Spans beyond maxSpans are counted as dropped rather than recorded. Spans may nest and may be begun and ended
+on different threads, e.g. by the workers of a batch, but each span must be ended by the thread that began it.
+The spans are read (serverTiming(), TraceLog::add()) after the request is done.
+*/
+class RequestTrace {
+public:
+    static constexpr size_t maxSpans = 32;
+
+    struct Span {
+        const char* name = nullptr; // a static string, used as Server-Timing metric name, so a token without spaces
+        int64_t startNs = 0;
+        int64_t endNs = -1; // -1 while the span is open
+        uint32_t thread = 0; // small number of the thread, stable for the life of the process
+    };
+
+    // The label identifies the request in an exported trace, e.g. "POST /geopose"
+    explicit RequestTrace(std::string label = std::string());
+
+    RequestTrace(const RequestTrace&) = delete;
+    RequestTrace& operator=(const RequestTrace&) = delete;
+
+    // Starts a span and returns its index for end(), or maxSpans if the trace is full
+    size_t begin(const char* name);
+
+    void end(size_t span);
+
+    // The number of spans begun, at most maxSpans
+    size_t size() const;
+
+    const Span& span(size_t index) const {
+        return spans_[index];
+    }
+
+    size_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    const std::string& label() const {
+        return label_;
+    }
+
+    /**
+    The value of a Server-Timing response header with the ended spans in the order they began,
+    e.g. "request;dur=1.234, body;dur=0.051, localize;dur=0.902" with the durations in milliseconds.
+    */
+    std::string serverTiming() const;
+
+    // Now on the clock of the spans
+    static int64_t nowNs();
+
+private:
+    std::array<Span, maxSpans> spans_;
+    std::atomic<size_t> next_{0};
+    std::atomic<size_t> dropped_{0};
+    std::string label_;
+};
+
+/**
+Times a scope as a span of a trace. Does nothing without a trace, so callers pass nullptr for requests
+that are not traced and pay nothing but a branch.
+*/
+class TraceSpan {
+public:
+    TraceSpan(RequestTrace* trace, const char* name) : trace_(trace), span_(trace ? trace->begin(name) : 0) {
+    }
+
+    ~TraceSpan() {
+        end();
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // Ends the span before the end of the scope, e.g. before a stage that follows in the same scope
+    void end() {
+        if (trace_) {
+            trace_->end(span_);
+            trace_ = nullptr;
+        }
+    }
+
+private:
+    RequestTrace* trace_;
+    size_t span_;
+};
+
+/**
+The most recent traces of a server, exported in the Chrome trace event format, which chrome://tracing,
+Perfetto (ui.perfetto.dev) and speedscope show as a timeline of nested spans per thread.
+Above maxTraces, the oldest traces are dropped. All methods are thread-safe.
+*/
+class TraceLog {
+public:
+    explicit TraceLog(size_t maxTraces = 1000);
+
+    // Copies the ended spans of a finished trace
+    void add(const RequestTrace& trace);
+
+    /**
+    {"traceEvents": [...], "displayTimeUnit": "ms"} with one complete event ("ph": "X") per span,
+    the thread of the span as "tid" and the label of its trace in "args". Timestamps are in microseconds of the monotonic clock.
+    */
+    std::string chromeTraceJson() const;
+
+    size_t size() const;
+
+    void clear();
+
+private:
+    struct Record {
+        std::string label;
+        std::vector<RequestTrace::Span> spans;
+    };
+
+    const size_t maxTraces_;
+    mutable std::mutex mutex_;
+    std::deque<Record> records_;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_REQUEST_TRACE_H_
@@ -0,0 +1,101 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_RESPONSE_CACHE_H_
+#define _OSCP_RESPONSE_CACHE_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace oscp {
+
+struct ResponseCachePolicy {
+    size_t maxEntries = 4096; // over all shards
+    std::time_t ttlMs = 10000;
+    size_t shardCount = 16;
+    double geolocationBucketDegrees = 0.001; // roughly 100 m, geolocations in the same bucket share cache entries
+};
+
+struct ResponseCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0; // removed for the size limit, expired entries are not counted
+    size_t entries = 0;
+};
+
+/**
+Cache of GeoPoseResponses for requests that repeat the same camera frames, e.g. retries after a timeout
+or kiosks sending the same image over and over.
+
+Requests are keyed by the XXH64 of their camera readings (the base64 image text as received, so a hit skips decoding,
+plus image format, size, orientation and camera parameters) and of their geolocation rounded to a bucket.
+Readings of other sensors, ids and timestamps do not contribute, so a retry with a new id still hits.
+The cache is split into shards with their own lock and LRU list, so httplib worker threads rarely contend.
+Keys are 64-bit hashes, a collision would return the response of a different frame; with XXH64 it is negligible.
+All methods are thread-safe.
+*/
+class ResponseCache {
+public:
+    explicit ResponseCache(const ResponseCachePolicy& policy = ResponseCachePolicy());
+
+    /**
+    Computes the cache key of the request. Returns false if the request has no camera reading, then it is not cacheable.
+    */
+    bool key(const GeoPoseRequest& request, uint64_t& key) const;
+
+    /**
+    Copies the cached response to response and returns true if there is a fresh entry for the key.
+    The id and timestamp of the copy are those of the original request, callers answering a new request overwrite them.
+    */
+    bool find(uint64_t key, GeoPoseResponse& response);
+
+    void insert(uint64_t key, const GeoPoseResponse& response);
+
+    void clear();
+
+    ResponseCacheStats stats() const;
+
+    const ResponseCachePolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        GeoPoseResponse response;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> entries; // most recently used first
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    };
+
+    Shard& shardOf(uint64_t key);
+
+    const ResponseCachePolicy policy_;
+    size_t maxEntriesPerShard_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+} // namespace oscp
+
+#endif // _OSCP_RESPONSE_CACHE_H_
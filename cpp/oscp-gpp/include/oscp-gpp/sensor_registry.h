@@ -0,0 +1,103 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_SENSOR_REGISTRY_H_
+#define _OSCP_SENSOR_REGISTRY_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace oscp {
+
+struct SensorRegistryPolicy {
+    size_t maxEntries = 65536; // the oldest sensor sets are forgotten above this
+};
+
+struct SensorRegistryStats {
+    uint64_t added = 0; // new sensor sets
+    uint64_t hits = 0; // resolved tokens
+    uint64_t misses = 0; // unknown tokens
+    uint64_t evictions = 0;
+    uint64_t collisions = 0; // sensor sets not added because another one has the same token
+    size_t entries = 0;
+};
+
+// Thrown for a sensorsToken the registry does not know (anymore), the client should resend the sensors
+class UnknownSensorsTokenError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+Server-side table of the sensor sets (sensors, privacy and camera params, as a GeoPoseSession) that clients
+reference by a short token instead of resending them with every GeoPoseRequest.
+
+The token is the hex XXH64 of the content, so every client with the same devices shares an entry and
+registering a set again is cheap. Since XXH64 is not collision-resistant, a set whose token is taken by
+different content is not added. The oldest sets are forgotten above maxEntries, clients then get
+UnknownSensorsTokenError and send the full sensors again.
+Lookups only take a shared lock. All methods are thread-safe.
+*/
+class SensorRegistry {
+public:
+    explicit SensorRegistry(const SensorRegistryPolicy& policy = SensorRegistryPolicy());
+
+    /**
+    Registers the sensor set and returns its token. Returns the same token if the set is already registered,
+    or an empty string if another set has the same token.
+    */
+    std::string add(GeoPoseSession sensors);
+
+    // Returns nullptr if the token is unknown
+    std::shared_ptr<const GeoPoseSession> find(const std::string& token) const;
+
+    /**
+    Completes a request parsed with a sensorsToken instead of sensors, see resolveSensors().
+    Does nothing if the request has no token or has its sensors anyway. Throws UnknownSensorsTokenError if the token is unknown.
+    */
+    void resolve(GeoPoseRequest& request) const;
+
+    // Same as resolve(), but returns UNKNOWN_SENSORS_TOKEN (or what resolveSensors() found wrong) instead of throwing
+    std::optional<ParseError> tryResolve(GeoPoseRequest& request) const;
+
+    SensorRegistryStats stats() const;
+
+    const SensorRegistryPolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    struct Entry {
+        std::string content; // canonical encoding, to detect collisions
+        std::shared_ptr<const GeoPoseSession> sensors;
+    };
+
+    const SensorRegistryPolicy policy_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::deque<std::string> order_; // tokens of entries_ by age
+
+    std::atomic<uint64_t> added_{0};
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> collisions_{0};
+};
+
+} // namespace oscp
+
+#endif // _OSCP_SENSOR_REGISTRY_H_
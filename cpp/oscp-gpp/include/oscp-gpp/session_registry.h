@@ -0,0 +1,152 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_SESSION_REGISTRY_H_
+#define _OSCP_SESSION_REGISTRY_H_
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace oscp {
+
+struct SessionRegistryPolicy {
+    std::time_t idleTimeoutMs = 60000; // sessions without frames or a reader for this long are closed
+    size_t maxSessions = 1024; // creating more sessions fails
+    size_t maxQueuedMessages = 256; // the oldest undelivered messages of a session are dropped above this
+    size_t maxFramesInFlight = 8; // frames of a session accepted but not yet localized, more are refused
+};
+
+struct SessionRegistryStats {
+    uint64_t created = 0;
+    uint64_t closed = 0; // closed by the client
+    uint64_t expired = 0; // closed for the idle timeout
+    size_t active = 0;
+};
+
+/**
+One localization session of a continuously localizing client: the GeoPoseSession sent at its start,
+and the queue of serialized messages (e.g. GeoPoseResponses) waiting to be pushed to the client.
+All methods are thread-safe.
+*/
+class LocalizationSession {
+public:
+    LocalizationSession(std::string id, GeoPoseSession definition, size_t maxQueuedMessages, size_t maxFramesInFlight);
+
+    const std::string& id() const {
+        return id_;
+    }
+
+    const GeoPoseSession& definition() const {
+        return definition_;
+    }
+
+    /**
+    Queues a message for the client, dropping the oldest one if the queue is full.
+    Returns false (and drops the message) if the session is closed.
+    */
+    bool push(std::string message);
+
+    /**
+    Waits up to timeout for the next message. Returns false on timeout, or once the session is closed
+    and all queued messages were delivered; check closed() to tell the two apart.
+    */
+    bool pop(std::string& message, std::chrono::milliseconds timeout);
+
+    // Wakes up a waiting pop(), the messages still queued can be popped
+    void close();
+
+    bool closed() const;
+
+    uint64_t droppedMessages() const {
+        return dropped_;
+    }
+
+    /**
+    Counts a frame as accepted for localization. Returns false, without counting it, if maxFramesInFlight frames
+    are already in flight, so that one client cannot queue unbounded work. Call endFrame() once the frame is done.
+    */
+    bool beginFrame();
+
+    void endFrame();
+
+    size_t framesInFlight() const {
+        return framesInFlight_;
+    }
+
+    // Marks the session as used, postponing its idle timeout
+    void touch();
+
+    std::chrono::steady_clock::time_point lastActive() const;
+
+private:
+    const std::string id_;
+    const GeoPoseSession definition_;
+    const size_t maxQueuedMessages_;
+    const size_t maxFramesInFlight_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::string> messages_;
+    bool closed_ = false;
+    std::chrono::steady_clock::time_point lastActive_;
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<size_t> framesInFlight_{0};
+};
+
+/**
+The open localization sessions of a server, by their randomly generated ID.
+Idle sessions are closed when the next session is created or when they are looked up.
+All methods are thread-safe.
+*/
+class SessionRegistry {
+public:
+    explicit SessionRegistry(const SessionRegistryPolicy& policy = SessionRegistryPolicy());
+
+    // Opens a session, returns nullptr if maxSessions are open
+    std::shared_ptr<LocalizationSession> create(GeoPoseSession definition);
+
+    // Returns nullptr if there is no such session or it expired
+    std::shared_ptr<LocalizationSession> find(const std::string& id);
+
+    // Returns false if there is no such session
+    bool close(const std::string& id);
+
+    SessionRegistryStats stats() const;
+
+    const SessionRegistryPolicy& policy() const {
+        return policy_;
+    }
+
+private:
+    bool expired(const LocalizationSession& session, std::chrono::steady_clock::time_point now) const;
+    void sweep(std::chrono::steady_clock::time_point now); // requires mutex_
+    std::string newId(); // requires mutex_
+
+    const SessionRegistryPolicy policy_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<LocalizationSession>> sessions_;
+    std::random_device random_; // not a seeded PRNG, whose output could be predicted from earlier IDs
+
+    std::atomic<uint64_t> created_{0};
+    std::atomic<uint64_t> closed_{0};
+    std::atomic<uint64_t> expired_{0};
+};
+
+} // namespace oscp
+
+#endif // _OSCP_SESSION_REGISTRY_H_
@@ -0,0 +1,58 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_WORKER_POOL_H_
+#define _OSCP_WORKER_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oscp {
+
+/**
+Fixed number of threads running submitted tasks in FIFO order, e.g. the frames of a batch request.
+Tasks must not throw. The destructor runs the tasks still queued, then joins the threads.
+*/
+class WorkerPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit WorkerPool(size_t threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Like submit(), but refuses the task and returns false if maxQueued tasks are already waiting for a thread
+    bool trySubmit(std::function<void()> task, size_t maxQueued);
+
+    // The tasks waiting for a thread
+    size_t queued() const;
+
+    size_t size() const {
+        return threads_.size();
+    }
+
+private:
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_WORKER_POOL_H_
@@ -0,0 +1,103 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_WORKER_PROCESSES_H_
+#define _OSCP_WORKER_PROCESSES_H_
+
+#include <oscp-gpp/enum_strings.h>
+
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace oscp {
+
+// How the worker processes of a server are pinned to CPUs
+enum class CpuPinning {
+    NONE, // the scheduler moves them freely
+    CPU, // each worker gets its own share of the CPUs the server may run on
+    NUMA_NODE // the workers take turns over the NUMA nodes and get all CPUs of their node, so their memory stays local
+};
+
+inline constexpr enum_strings_detail::EnumName<CpuPinning> cpuPinningNames[] = {
+    {CpuPinning::NONE, "NONE"},
+    {CpuPinning::CPU, "CPU"},
+    {CpuPinning::NUMA_NODE, "NUMA_NODE"},
+};
+static_assert(enum_strings_detail::isInDeclarationOrder(cpuPinningNames), "cpuPinningNames must list CpuPinning in declaration order");
+
+constexpr std::string_view toString(CpuPinning pinning) noexcept {
+    return enum_strings_detail::nameOf(cpuPinningNames, pinning);
+}
+
+constexpr bool tryParseCpuPinning(std::string_view str, CpuPinning& pinning) noexcept {
+    return enum_strings_detail::tryParse(cpuPinningNames, str, pinning);
+}
+
+// Parses a Linux CPU list such as "0-3,8,10-11" into CPU numbers, an empty vector if it is malformed
+std::vector<int> parseCpuList(std::string_view cpuList);
+
+/**
+The CPUs each of the given number of workers is pinned to, among the CPUs the process may run on (its affinity mask).
+With more workers than CPUs, workers share CPUs. Empty sets with CpuPinning::NONE or on platforms without affinity support.
+NUMA nodes are read from /sys/devices/system/node, a machine without them is one node.
+*/
+std::vector<std::vector<int>> workerCpuSets(size_t workers, CpuPinning pinning);
+
+// Pins the calling thread, and the threads it starts afterwards, to the CPUs. Does nothing for an empty set, false on failure.
+bool pinToCpus(const std::vector<int>& cpus);
+
+// Lets several sockets bind to the same address and port, the kernel spreads incoming connections over them (SO_REUSEPORT)
+bool enableReusePort(int socket);
+
+struct SupervisorPolicy {
+    size_t workers = 1;
+    std::time_t restartDelayMs = 1000; // before a crashed worker is started again
+    std::time_t maxRestartDelayMs = 30000; // the delay doubles for every crash within minUptimeMs of the start, up to this
+    std::time_t minUptimeMs = 10000;
+};
+
+struct SupervisorStats {
+    uint64_t started = 0;
+    uint64_t crashed = 0; // killed by a signal or exited with a status other than 0
+};
+
+/**
+Forks worker processes and starts them again when they crash, a prefork model as in nginx or Apache.
+run() returns in each worker with its index, in a fresh process that continues where the supervisor called run(),
+so everything set up before is inherited copy-on-write and shared as long as no worker writes it, e.g. the parsed config.
+Threads do not survive fork(), so run() must be called before any are started, and output buffered in stdio before would be
+written by every worker, so flush it first.
+The supervisor itself stays in run(): SIGTERM or SIGINT stop it and all workers, the workers get SIGTERM as well if the supervisor dies.
+SIGHUP is passed on to the workers, e.g. to reload their config. Workers start with SIGHUP ignored until they handle it.
+A worker that exits with status 0 is not started again, run() returns std::nullopt in the supervisor when none is left.
+POSIX only, run() throws std::runtime_error on other platforms.
+*/
+class WorkerSupervisor {
+public:
+    explicit WorkerSupervisor(const SupervisorPolicy& policy = SupervisorPolicy());
+
+    WorkerSupervisor(const WorkerSupervisor&) = delete;
+    WorkerSupervisor& operator=(const WorkerSupervisor&) = delete;
+
+    std::optional<size_t> run();
+
+    SupervisorStats stats() const {
+        return stats_;
+    }
+
+private:
+    const SupervisorPolicy policy_;
+    SupervisorStats stats_;
+};
+
+} // namespace oscp
+
+#endif // _OSCP_WORKER_PROCESSES_H_
@@ -0,0 +1,226 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/admission_control.h>
+
+#include <cmath>
+
+namespace oscp {
+
+bool parseTimeoutMs(std::string_view text, std::time_t& timeoutMs) {
+    if (text.empty() || text.size() > 9) {
+        return false;
+    }
+    std::time_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    timeoutMs = value;
+    return true;
+}
+
+void RequestBudget::setTimeout(std::time_t timeoutMs, Clock::time_point arrival) {
+    deadline_ = arrival + std::chrono::milliseconds(timeoutMs);
+}
+
+void RequestBudget::setMaxAge(std::time_t requestTimestampMs, std::time_t maxAgeMs,
+    std::chrono::system_clock::time_point nowSystem, Clock::time_point now)
+{
+    if (maxAgeMs <= 0 || requestTimestampMs <= 0) {
+        return;
+    }
+    const std::time_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(nowSystem.time_since_epoch()).count();
+    const std::time_t ageMs = nowMs > requestTimestampMs ? nowMs - requestTimestampMs : 0;
+    ageDeadline_ = now + std::chrono::milliseconds(maxAgeMs - ageMs); // in the past if already too old
+}
+
+std::optional<DropReason> RequestBudget::expired(Clock::time_point now) const {
+    if (now >= deadline_) {
+        return DropReason::DEADLINE_EXCEEDED;
+    }
+    if (now >= ageDeadline_) {
+        return DropReason::TOO_OLD;
+    }
+    return std::nullopt;
+}
+
+RequestBudget::Clock::time_point RequestBudget::deadline() const {
+    return deadline_ < ageDeadline_ ? deadline_ : ageDeadline_;
+}
+
+AdmissionController::Slot::Slot(Slot&& other) noexcept
+    : controller_(other.controller_), reason_(other.reason_), queueDelay_(other.queueDelay_)
+{
+    other.controller_ = nullptr;
+}
+
+AdmissionController::Slot& AdmissionController::Slot::operator=(Slot&& other) noexcept {
+    if (this != &other) {
+        if (controller_) {
+            controller_->release();
+        }
+        controller_ = other.controller_;
+        reason_ = other.reason_;
+        queueDelay_ = other.queueDelay_;
+        other.controller_ = nullptr;
+    }
+    return *this;
+}
+
+AdmissionController::Slot::~Slot() {
+    if (controller_) {
+        controller_->release();
+    }
+}
+
+AdmissionController::AdmissionController(const AdmissionPolicy& policy) : policy_(policy) {
+}
+
+AdmissionController::Slot AdmissionController::acquire(const RequestBudget& budget) {
+    Slot slot;
+    const Clock::time_point enqueued = Clock::now();
+    if (std::optional<DropReason> reason = budget.expired(enqueued)) {
+        countDrop(*reason);
+        slot.reason_ = *reason;
+        return slot;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (policy_.maxConcurrent > 0 && (running_ >= policy_.maxConcurrent || !waiters_.empty())) {
+        const Clock::time_point deadline = budget.deadline();
+        std::condition_variable slotFreed;
+        const auto waiter = waiters_.insert(waiters_.end(), &slotFreed);
+        while (running_ >= policy_.maxConcurrent || waiters_.front() != &slotFreed) {
+            if (deadline == Clock::time_point::max()) {
+                slotFreed.wait(lock);
+            } else if (slotFreed.wait_until(lock, deadline) == std::cv_status::timeout) {
+                if (std::optional<DropReason> reason = budget.expired(Clock::now())) {
+                    waiters_.erase(waiter);
+                    wakeFront();
+                    lock.unlock();
+                    countDrop(*reason);
+                    slot.reason_ = *reason;
+                    return slot;
+                }
+            }
+        }
+        waiters_.erase(waiter);
+
+        const Clock::time_point dequeued = Clock::now();
+        slot.queueDelay_ = dequeued - enqueued;
+        if (shouldShed(slot.queueDelay_, dequeued)) {
+            wakeFront();
+            lock.unlock();
+            countDrop(DropReason::OVERLOADED);
+            slot.reason_ = DropReason::OVERLOADED;
+            return slot;
+        }
+    } else if (policy_.maxConcurrent > 0) {
+        shouldShed(Clock::duration::zero(), enqueued);
+    }
+    running_++;
+    wakeFront();
+    lock.unlock();
+
+    admitted_++;
+    slot.controller_ = this;
+    return slot;
+}
+
+// CoDel (RFC 8289), with the queueing delay of each request at the head of the queue as sojourn time
+bool AdmissionController::shouldShed(Clock::duration queueDelay, Clock::time_point now) {
+    const Clock::duration target = std::chrono::milliseconds(policy_.targetDelayMs);
+    const Clock::duration interval = std::chrono::milliseconds(policy_.intervalMs);
+    auto controlLaw = [&interval](Clock::time_point t, uint32_t count) {
+        return t + std::chrono::duration_cast<Clock::duration>(interval / std::sqrt(static_cast<double>(count)));
+    };
+
+    bool aboveTarget = false;
+    if (queueDelay < target || waiters_.empty()) {
+        // Below target, or the last waiting request, which is never shed
+        firstAboveTarget_ = Clock::time_point();
+    } else if (firstAboveTarget_ == Clock::time_point()) {
+        firstAboveTarget_ = now + interval;
+    } else {
+        aboveTarget = now >= firstAboveTarget_;
+    }
+
+    if (shedding_) {
+        if (!aboveTarget) {
+            shedding_ = false;
+            return false;
+        }
+        if (now >= shedNext_) {
+            shedCount_++;
+            shedNext_ = controlLaw(shedNext_, shedCount_);
+            return true;
+        }
+        return false;
+    }
+    if (aboveTarget) {
+        // Resume close to the previous shedding rate if the queue came back soon after the last shedding ended
+        shedding_ = true;
+        const uint32_t delta = shedCount_ - lastShedCount_;
+        shedCount_ = (delta > 1 && now - shedNext_ < 16 * interval) ? delta : 1;
+        shedNext_ = controlLaw(now, shedCount_);
+        lastShedCount_ = shedCount_;
+        return true;
+    }
+    return false;
+}
+
+void AdmissionController::wakeFront() {
+    if (!waiters_.empty() && running_ < policy_.maxConcurrent) {
+        waiters_.front()->notify_one();
+    }
+}
+
+void AdmissionController::release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_--;
+    wakeFront();
+}
+
+std::optional<DropReason> AdmissionController::check(const RequestBudget& budget) {
+    std::optional<DropReason> reason = budget.expired();
+    if (reason) {
+        countDrop(*reason);
+    }
+    return reason;
+}
+
+void AdmissionController::countDrop(DropReason reason) {
+    switch (reason) {
+    case DropReason::DEADLINE_EXCEEDED:
+        deadlineExceeded_++;
+        break;
+    case DropReason::TOO_OLD:
+        tooOld_++;
+        break;
+    case DropReason::OVERLOADED:
+        overloaded_++;
+        break;
+    }
+}
+
+AdmissionStats AdmissionController::stats() const {
+    AdmissionStats stats;
+    stats.admitted = admitted_.load();
+    stats.deadlineExceeded = deadlineExceeded_.load();
+    stats.tooOld = tooOld_.load();
+    stats.overloaded = overloaded_.load();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.running = running_;
+    stats.queued = waiters_.size();
+    return stats;
+}
+
+} // namespace oscp
@@ -0,0 +1,573 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/async_client.h>
+#include <oscp-gpp/compression.h>
+#include <oscp-gpp/geoposeprotocol_json.h>
+#include <oscp-gpp/http_response_parser.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace oscp {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        const char ca = (a[i] >= 'A' && a[i] <= 'Z') ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+        const char cb = (b[i] >= 'A' && b[i] <= 'Z') ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+        if (ca != cb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view headerValue(const HttpHeaders& headers, std::string_view name) {
+    for (const std::pair<std::string, std::string>& header : headers) {
+        if (equalsIgnoreCase(header.first, name)) {
+            return header.second;
+        }
+    }
+    return std::string_view();
+}
+
+// Decompresses the body in place if it has a Content-Encoding
+TransferStatus decodeBody(HttpResponse& response, size_t maxResponseBytes) {
+    const std::string_view contentEncoding = response.header("Content-Encoding");
+    const ContentCoding coding = parseContentCoding(contentEncoding);
+    if (coding == ContentCoding::IDENTITY) {
+        return TransferStatus::OK;
+    }
+    std::string body;
+    const DecompressionStatus status = decompressBody(response.body, coding, maxResponseBytes, body);
+    if (status == DecompressionStatus::TOO_LARGE) {
+        return TransferStatus::TOO_LARGE;
+    }
+    if (status != DecompressionStatus::OK) {
+        return TransferStatus::INVALID_RESPONSE;
+    }
+    response.body = std::move(body);
+    return TransferStatus::OK;
+}
+
+LocalizeResult toLocalizeResult(HttpResponse&& response) {
+    LocalizeResult result;
+    result.status = response.status;
+    result.httpStatus = response.httpStatus;
+    if (response.status != TransferStatus::OK) {
+        result.error = std::string(toString(response.status));
+        return result;
+    }
+    if (response.httpStatus != 200) {
+        result.error = std::move(response.body);
+        return result;
+    }
+    result.sensorsToken = std::string(response.header("X-OSCP-Sensors-Token"));
+    ParseResult<nlohmann::json> json = tryParseJson(response.body);
+    if (!json) {
+        result.status = TransferStatus::INVALID_RESPONSE;
+        result.error = json.error().message;
+        return result;
+    }
+    try {
+        result.response = json->get<GeoPoseResponse>();
+    } catch (const std::exception& e) {
+        result.status = TransferStatus::INVALID_RESPONSE;
+        result.error = e.what();
+    }
+    return result;
+}
+
+} // namespace
+
+
+std::string_view HttpResponse::header(std::string_view name) const {
+    return headerValue(headers, name);
+}
+
+void AsyncClient::localize(const GeoPoseRequest& request, LocalizeCallback callback) {
+    HttpRequest httpRequest;
+    httpRequest.path = "/geopose";
+    httpRequest.headers = {
+        {"Content-Type", "application/json"},
+        {"Accept", "application/vnd.oscp+json;version=2.0"},
+        {"X-OSCP-Timeout-Ms", std::to_string(policy_.timeoutMs)}
+    };
+    httpRequest.body = nlohmann::json(request).dump();
+    send(std::move(httpRequest), [callback = std::move(callback)](HttpResponse&& response) {
+        callback(toLocalizeResult(std::move(response)));
+    });
+}
+
+void AsyncClient::run() {
+    while (pending() > 0) {
+        poll(-1);
+    }
+}
+
+#ifdef __linux__
+
+struct AsyncClient::State {
+    struct Pending {
+        std::string head; // request line and headers
+        std::string body;
+        bool headRequest = false;
+        Callback callback;
+        Clock::time_point deadline;
+        bool retried = false;
+    };
+
+    struct Connection {
+        explicit Connection(size_t maxResponseBytes) : parser(maxResponseBytes) {
+        }
+
+        int socket = -1;
+        uint32_t events = 0; // watched with epoll
+        bool connected = false;
+        bool reused = false; // carried a response before, so the server may have closed it while it was idle
+        bool closed = false;
+        std::optional<Pending> pending;
+        size_t sent = 0; // bytes of head and body
+        HttpResponseParser parser;
+    };
+
+    AsyncClientPolicy policy;
+    std::string host; // the Host header
+    sockaddr_storage address = {};
+    socklen_t addressLength = 0;
+    int epoll = -1;
+
+    std::deque<Pending> queue; // waiting for a connection, ordered by deadline
+    std::vector<std::unique_ptr<Connection>> connections;
+    std::vector<Connection*> idle;
+    size_t open = 0; // connections not closed
+    size_t active = 0; // connections with a request
+    std::vector<std::pair<Callback, HttpResponse>> completed; // callbacks to call at the end of poll()
+    AsyncClientStats stats;
+
+    void complete(Pending& pending, HttpResponse&& response) {
+        if (response.status != TransferStatus::OK) {
+            stats.failures++;
+        }
+        completed.emplace_back(std::move(pending.callback), std::move(response));
+    }
+
+    void fail(Pending& pending, TransferStatus status) {
+        HttpResponse response;
+        response.status = status;
+        complete(pending, std::move(response));
+    }
+
+    Pending take(Connection& connection) {
+        Pending pending = std::move(*connection.pending);
+        connection.pending.reset();
+        active--;
+        return pending;
+    }
+
+    void watch(Connection& connection, uint32_t events) {
+        if (connection.events != events) {
+            epoll_event event = {};
+            event.events = events;
+            event.data.ptr = &connection;
+            epoll_ctl(epoll, EPOLL_CTL_MOD, connection.socket, &event);
+            connection.events = events;
+        }
+    }
+
+    // Closed connections are freed at the end of poll(), after the events that may still point to them
+    void close(Connection& connection) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, connection.socket, nullptr);
+        ::close(connection.socket);
+        connection.closed = true;
+        open--;
+        idle.erase(std::remove(idle.begin(), idle.end(), &connection), idle.end());
+    }
+
+    Connection* connect() {
+        const int s = socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (s < 0) {
+            return nullptr;
+        }
+        const int yes = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        if (::connect(s, reinterpret_cast<const sockaddr*>(&address), addressLength) != 0 && errno != EINPROGRESS) {
+            ::close(s);
+            return nullptr;
+        }
+        auto connection = std::make_unique<Connection>(policy.maxResponseBytes);
+        connection->socket = s;
+        connection->events = EPOLLOUT; // writable once connected
+        epoll_event event = {};
+        event.events = connection->events;
+        event.data.ptr = connection.get();
+        if (epoll_ctl(epoll, EPOLL_CTL_ADD, s, &event) != 0) {
+            ::close(s);
+            return nullptr;
+        }
+        connections.push_back(std::move(connection));
+        open++;
+        stats.connections++;
+        return connections.back().get();
+    }
+
+    // Starts the queued requests on idle connections, and on new ones up to maxConnections
+    void dispatch() {
+        while (!queue.empty()) {
+            Connection* connection = nullptr;
+            if (!idle.empty()) {
+                connection = idle.back(); // the most recently used one is the least likely to have been closed by the server
+                idle.pop_back();
+            } else if (open < policy.maxConnections) {
+                connection = connect();
+                if (connection == nullptr) {
+                    fail(queue.front(), TransferStatus::CONNECT_FAILED);
+                    queue.pop_front();
+                    continue;
+                }
+            } else {
+                return;
+            }
+            connection->pending = std::move(queue.front());
+            queue.pop_front();
+            connection->sent = 0;
+            connection->parser.reset(connection->pending->headRequest);
+            active++;
+            if (connection->connected) {
+                write(*connection);
+            }
+        }
+    }
+
+    void write(Connection& connection) {
+        const Pending& pending = *connection.pending;
+        const size_t size = pending.head.size() + pending.body.size();
+        while (connection.sent < size) {
+            // Head and body in one call without copying the body, which is mostly a base64 image
+            iovec parts[2];
+            size_t count = 0;
+            size_t offset = connection.sent;
+            if (offset < pending.head.size()) {
+                parts[count++] = {const_cast<char*>(pending.head.data()) + offset, pending.head.size() - offset};
+                offset = 0;
+            } else {
+                offset -= pending.head.size();
+            }
+            if (offset < pending.body.size()) {
+                parts[count++] = {const_cast<char*>(pending.body.data()) + offset, pending.body.size() - offset};
+            }
+            msghdr message = {};
+            message.msg_iov = parts;
+            message.msg_iovlen = count;
+            const ssize_t sent = sendmsg(connection.socket, &message, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    watch(connection, EPOLLOUT | EPOLLIN);
+                    return;
+                }
+                broken(connection);
+                return;
+            }
+            connection.sent += static_cast<size_t>(sent);
+        }
+        watch(connection, EPOLLIN);
+    }
+
+    void read(Connection& connection) {
+        char buffer[64 * 1024];
+        for (;;) {
+            const ssize_t received = recv(connection.socket, buffer, sizeof(buffer), 0);
+            if (received < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    broken(connection);
+                }
+                return;
+            }
+            const HttpParseStatus status = received == 0 ? connection.parser.close()
+                : connection.parser.append(buffer, static_cast<size_t>(received));
+            if (status == HttpParseStatus::COMPLETE) {
+                finish(connection, received == 0);
+                return;
+            }
+            if (received == 0) {
+                broken(connection);
+                return;
+            }
+            if (status != HttpParseStatus::INCOMPLETE) {
+                Pending pending = take(connection);
+                fail(pending, status == HttpParseStatus::TOO_LARGE ? TransferStatus::TOO_LARGE : TransferStatus::INVALID_RESPONSE);
+                close(connection);
+                return;
+            }
+        }
+    }
+
+    void finish(Connection& connection, bool ended) {
+        HttpResponse response = std::move(connection.parser.response());
+        response.status = decodeBody(response, policy.maxResponseBytes);
+        if (response.status != TransferStatus::OK) {
+            response.httpStatus = 0;
+        }
+        Pending pending = take(connection);
+        if (ended || !connection.parser.keepAlive()) {
+            close(connection);
+        } else {
+            connection.reused = true;
+            idle.push_back(&connection);
+        }
+        complete(pending, std::move(response));
+    }
+
+    // The connection failed while it carried a request
+    void broken(Connection& connection) {
+        Pending pending = take(connection);
+        const bool retry = connection.reused && !connection.parser.receivedAny() && !pending.retried;
+        const TransferStatus status = connection.connected ? TransferStatus::CONNECTION_CLOSED : TransferStatus::CONNECT_FAILED;
+        close(connection);
+        if (retry) {
+            pending.retried = true;
+            stats.retries++;
+            queue.push_front(std::move(pending));
+        } else {
+            fail(pending, status);
+        }
+    }
+
+    void handle(Connection& connection, uint32_t events) {
+        if (connection.closed) {
+            return;
+        }
+        if (!connection.pending) {
+            close(connection); // an idle connection became readable: the server closed it
+            return;
+        }
+        if (!connection.connected) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (getsockopt(connection.socket, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+                broken(connection);
+                return;
+            }
+            connection.connected = true;
+            write(connection);
+            return;
+        }
+        if ((events & EPOLLOUT) != 0) {
+            write(connection);
+        }
+        if (!connection.closed && connection.pending && (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) {
+            read(connection);
+        }
+    }
+
+    void expire(Clock::time_point now) {
+        while (!queue.empty() && queue.front().deadline <= now) {
+            fail(queue.front(), TransferStatus::TIMEOUT);
+            queue.pop_front();
+        }
+        for (const std::unique_ptr<Connection>& connection : connections) {
+            if (!connection->closed && connection->pending && connection->pending->deadline <= now) {
+                Pending pending = take(*connection);
+                fail(pending, TransferStatus::TIMEOUT);
+                close(*connection);
+            }
+        }
+    }
+
+    // How long epoll_wait() may wait without missing a deadline
+    int waitMs(int timeoutMs, Clock::time_point now) const {
+        if (!completed.empty()) {
+            return 0;
+        }
+        std::optional<Clock::time_point> deadline;
+        if (!queue.empty()) {
+            deadline = queue.front().deadline;
+        }
+        for (const std::unique_ptr<Connection>& connection : connections) {
+            if (connection->pending && (!deadline || connection->pending->deadline < *deadline)) {
+                deadline = connection->pending->deadline;
+            }
+        }
+        if (!deadline) {
+            return timeoutMs;
+        }
+        // Rounded up, so that the deadline has passed when epoll_wait() returns
+        const auto untilDeadline = std::chrono::ceil<std::chrono::milliseconds>(*deadline - now).count();
+        const int wait = static_cast<int>(std::max<decltype(untilDeadline)>(untilDeadline, 0));
+        return timeoutMs < 0 ? wait : std::min(timeoutMs, wait);
+    }
+
+    size_t callCompleted() {
+        std::vector<std::pair<Callback, HttpResponse>> done;
+        done.swap(completed);
+        for (std::pair<Callback, HttpResponse>& entry : done) {
+            entry.first(std::move(entry.second));
+        }
+        // Requests sent by the callbacks go out right away
+        dispatch();
+        return done.size();
+    }
+};
+
+AsyncClient::AsyncClient(const std::string& host, int port, const AsyncClientPolicy& policy)
+    : policy_(policy), state_(std::make_unique<State>())
+{
+    state_->policy = policy;
+    state_->host = host + ":" + std::to_string(port);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICSERV;
+    addrinfo* addresses = nullptr;
+    const int error = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+    if (error != 0 || addresses == nullptr) {
+        throw std::runtime_error("Could not resolve " + host + ": " + gai_strerror(error));
+    }
+    std::memcpy(&state_->address, addresses->ai_addr, addresses->ai_addrlen);
+    state_->addressLength = addresses->ai_addrlen;
+    freeaddrinfo(addresses);
+
+    state_->epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (state_->epoll < 0) {
+        throw std::runtime_error("Could not create an epoll instance");
+    }
+}
+
+AsyncClient::~AsyncClient() {
+    for (const std::unique_ptr<State::Connection>& connection : state_->connections) {
+        if (!connection->closed) {
+            ::close(connection->socket);
+        }
+    }
+    ::close(state_->epoll);
+}
+
+void AsyncClient::send(HttpRequest request, Callback callback) {
+    State::Pending pending;
+    pending.head.reserve(256);
+    pending.head.append(request.method).append(" ").append(request.path).append(" HTTP/1.1\r\nHost: ").append(state_->host).append("\r\n");
+    for (const std::pair<std::string, std::string>& header : request.headers) {
+        pending.head.append(header.first).append(": ").append(header.second).append("\r\n");
+    }
+    if (!request.body.empty() || request.method == "POST" || request.method == "PUT" || request.method == "PATCH") {
+        pending.head.append("Content-Length: ").append(std::to_string(request.body.size())).append("\r\n");
+    }
+    pending.head.append("\r\n");
+    pending.body = std::move(request.body);
+    pending.headRequest = request.method == "HEAD";
+    pending.callback = std::move(callback);
+    pending.deadline = Clock::now() + std::chrono::milliseconds(state_->policy.timeoutMs);
+    state_->queue.push_back(std::move(pending));
+    state_->stats.requests++;
+}
+
+size_t AsyncClient::poll(int timeoutMs) {
+    State& state = *state_;
+    state.dispatch();
+    if (pending() == 0 && state.completed.empty() && timeoutMs < 0) {
+        return 0;
+    }
+
+    epoll_event events[64];
+    const int count = epoll_wait(state.epoll, events, 64, state.waitMs(timeoutMs, Clock::now()));
+    for (int i = 0; i < count; i++) {
+        state.handle(*static_cast<State::Connection*>(events[i].data.ptr), events[i].events);
+    }
+    state.expire(Clock::now());
+    state.connections.erase(std::remove_if(state.connections.begin(), state.connections.end(),
+        [](const std::unique_ptr<State::Connection>& connection) { return connection->closed; }), state.connections.end());
+    state.dispatch();
+    return state.callCompleted();
+}
+
+void AsyncClient::cancel() {
+    State& state = *state_;
+    for (const std::unique_ptr<State::Connection>& connection : state.connections) {
+        if (!connection->closed && connection->pending) {
+            State::Pending pending = state.take(*connection);
+            state.fail(pending, TransferStatus::CANCELLED);
+            state.close(*connection);
+        }
+    }
+    for (State::Pending& pending : state.queue) {
+        state.fail(pending, TransferStatus::CANCELLED);
+    }
+    state.queue.clear();
+    state.callCompleted();
+}
+
+size_t AsyncClient::pending() const {
+    return state_->queue.size() + state_->active;
+}
+
+AsyncClientStats AsyncClient::stats() const {
+    return state_->stats;
+}
+
+#else
+
+struct AsyncClient::State {
+};
+
+AsyncClient::AsyncClient(const std::string&, int, const AsyncClientPolicy& policy) : policy_(policy) {
+    throw std::runtime_error("The asynchronous client is not supported on this platform");
+}
+
+AsyncClient::~AsyncClient() = default;
+
+void AsyncClient::send(HttpRequest, Callback) {
+}
+
+size_t AsyncClient::poll(int) {
+    return 0;
+}
+
+void AsyncClient::cancel() {
+}
+
+size_t AsyncClient::pending() const {
+    return 0;
+}
+
+AsyncClientStats AsyncClient::stats() const {
+    return AsyncClientStats();
+}
+
+#endif // __linux__
+
+} // namespace oscp
@@ -12,8 +12,9 @@ static const std::string base64_chars =
              "0123456789+/";
 
 
+// Not isalnum(), which depends on the locale and accepts e.g. Latin-1 letters
 static inline bool is_base64(BYTE c) {
-  return (isalnum(c) || (c == '+') || (c == '/'));
+  return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c == '+') || (c == '/');
 }
 
 std::string base64_encode(BYTE const* buf, unsigned int bufLen) {
@@ -58,10 +59,10 @@ std::string base64_encode(BYTE const* buf, unsigned int bufLen) {
 }
 
 std::vector<BYTE> base64_decode(std::string const& encoded_string) {
-  int in_len = encoded_string.size();
+  size_t in_len = encoded_string.size(); // an int would turn negative for inputs over 2 GB and read past the end
   int i = 0;
   int j = 0;
-  int in_ = 0;
+  size_t in_ = 0;
   BYTE char_array_4[4], char_array_3[3];
   std::vector<BYTE> ret;
 
@@ -98,4 +99,59 @@ std::vector<BYTE> base64_decode(std::string const& encoded_string) {
   return ret;
 }
 
+// Maps a character to its 6-bit value, or to invalid_base64 for '=' and everything outside the alphabet
+static constexpr BYTE invalid_base64 = 0x80;
+
+struct Base64DecodeTable {
+  BYTE values[256];
+
+  constexpr Base64DecodeTable() : values() {
+    for (int c = 0; c < 256; c++)
+      values[c] = invalid_base64;
+    for (int v = 0; v < 64; v++)
+      values[static_cast<BYTE>("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[v])] = static_cast<BYTE>(v);
+  }
+};
+
+static constexpr Base64DecodeTable base64_decode_table;
+
+std::vector<BYTE> base64_decode_fast(std::string_view encoded) {
+  const BYTE* in = reinterpret_cast<const BYTE*>(encoded.data());
+  const size_t in_len = encoded.size();
+  const BYTE* table = base64_decode_table.values;
+
+  // Sized for the whole input up front and trimmed at the end, so the loop writes without reallocating
+  std::vector<BYTE> ret(in_len / 4 * 3 + 2);
+  BYTE* out = ret.data();
+
+  size_t in_ = 0;
+  while (in_ + 4 <= in_len) {
+    const unsigned int a = table[in[in_]];
+    const unsigned int b = table[in[in_ + 1]];
+    const unsigned int c = table[in[in_ + 2]];
+    const unsigned int d = table[in[in_ + 3]];
+    if ((a | b | c | d) & invalid_base64)
+      break;
+    const unsigned int triple = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = static_cast<BYTE>(triple >> 16);
+    out[1] = static_cast<BYTE>(triple >> 8);
+    out[2] = static_cast<BYTE>(triple);
+    out += 3;
+    in_ += 4;
+  }
+
+  // Less than four valid characters remain, otherwise the loop would have decoded them,
+  // they are decoded like the tail of base64_decode()
+  unsigned int tail[4] = {0, 0, 0, 0};
+  int i = 0;
+  while (i < 3 && in_ < in_len && !(table[in[in_]] & invalid_base64))
+    tail[i++] = table[in[in_++]];
+  const unsigned int triple = (tail[0] << 18) | (tail[1] << 12) | (tail[2] << 6) | tail[3];
+  for (int j = 0; j < i - 1; j++)
+    *out++ = static_cast<BYTE>(triple >> (16 - 8 * j));
+
+  ret.resize(out - ret.data());
+  return ret;
+}
+
 } // namespace oscp
@@ -0,0 +1,129 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/camera_cache.h>
+
+#include <cstring>
+
+namespace oscp {
+
+// FNV-1a over raw bytes, chained through seed
+static size_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool CameraCache::Key::operator==(const Key& other) const {
+    return hash == other.hash && model == other.model && width == other.width && height == other.height
+        && sensorId == other.sensorId && sessionKey == other.sessionKey
+        && modelParams.size() == other.modelParams.size()
+        // bitwise, so that NaN parameters still find their entry
+        && std::memcmp(modelParams.data(), other.modelParams.data(), modelParams.size() * sizeof(float)) == 0;
+}
+
+CameraCache::CameraCache(const CameraCachePolicy& policy) : policy_(policy) {
+}
+
+std::shared_ptr<const PreparedCamera> CameraCache::get(const std::string& sessionKey, const CameraReading& reading) {
+    Key key;
+    key.sessionKey = sessionKey;
+    key.sensorId.assign(reading.sensorId.begin(), reading.sensorId.end());
+    key.model = reading.params.model;
+    key.modelParams.assign(reading.params.modelParams.begin(), reading.params.modelParams.end());
+    key.width = reading.size[0];
+    key.height = reading.size[1];
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hashBytes(key.sessionKey.data(), key.sessionKey.size(), hash);
+    hash = hashBytes(key.sensorId.data(), key.sensorId.size(), hash);
+    hash = hashBytes(&key.model, sizeof(key.model), hash);
+    hash = hashBytes(key.modelParams.data(), key.modelParams.size() * sizeof(float), hash);
+    hash = hashBytes(&key.width, sizeof(key.width), hash);
+    hash = hashBytes(&key.height, sizeof(key.height), hash);
+    key.hash = static_cast<size_t>(hash);
+
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            if (now < it->second->expires) {
+                entries_.splice(entries_.begin(), entries_, it->second);
+                hits_++;
+                return it->second->camera;
+            }
+            bytes_ -= it->second->bytes;
+            entries_.erase(it->second);
+            index_.erase(it);
+            evictions_++;
+        }
+        misses_++;
+    }
+
+    // Prepared outside the lock, concurrent misses of the same camera may both prepare it
+    auto camera = std::make_shared<PreparedCamera>();
+    camera->intrinsics = makeCameraIntrinsics(reading.params, key.width, key.height);
+    if (policy_.buildUndistortionMaps) {
+        // A map over the cap would be handed out uncached anyway, so it is not built in the first place
+        camera->undistortionMap = makeUndistortionMap(camera->intrinsics, policy_.maxBytes);
+    }
+
+    Entry entry;
+    entry.camera = camera;
+    entry.bytes = camera->memoryBytes();
+    entry.expires = now + std::chrono::milliseconds(policy_.ttlMs);
+    if (entry.bytes > policy_.maxBytes) {
+        return camera; // would evict everything else, hand it out uncached
+    }
+    entry.key = key;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return it->second->camera; // another thread was faster
+    }
+    entries_.push_front(std::move(entry));
+    index_.emplace(std::move(key), entries_.begin());
+    bytes_ += entries_.front().bytes;
+    evictOverCap();
+    return camera;
+}
+
+void CameraCache::evictOverCap() {
+    while (bytes_ > policy_.maxBytes && !entries_.empty()) {
+        const Entry& last = entries_.back();
+        bytes_ -= last.bytes;
+        index_.erase(last.key);
+        entries_.pop_back();
+        evictions_++;
+    }
+}
+
+void CameraCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+CameraCacheStats CameraCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CameraCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
+
+} // namespace oscp
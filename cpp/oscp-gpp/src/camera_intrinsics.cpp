@@ -0,0 +1,88 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/camera_intrinsics.h>
+#include <oscp-gpp/camera_models.h>
+
+#include <stdexcept>
+
+namespace oscp {
+
+size_t cameraModelParamCount(CameraModel model) {
+    if (model == CameraModel::UNKNOWN) {
+        return 0;
+    }
+    return dispatchCameraModel(model, [](auto tag) {
+        return CameraModelTraits<decltype(tag)::value>::paramCount;
+    });
+}
+
+CameraIntrinsics makeCameraIntrinsics(const CameraParameters& params, size_t width, size_t height) {
+    const size_t paramCount = cameraModelParamCount(params.model);
+    if (paramCount == 0) {
+        throw std::invalid_argument("Unknown camera model");
+    }
+    if (params.modelParams.size() != paramCount) {
+        throw std::invalid_argument("Camera model " + std::string(toString(params.model)) + " expects " + std::to_string(paramCount)
+            + " modelParams, got " + std::to_string(params.modelParams.size()));
+    }
+    if (width == 0 || height == 0) {
+        throw std::invalid_argument("The image size of the camera reading is not set");
+    }
+    if (width > maxCameraImageSide || height > maxCameraImageSide) {
+        throw std::invalid_argument("The image size of the camera reading exceeds " + std::to_string(maxCameraImageSide) + " pixels");
+    }
+
+    CameraIntrinsics intrinsics;
+    intrinsics.model = params.model;
+    intrinsics.width = width;
+    intrinsics.height = height;
+    intrinsics.params.assign(params.modelParams.begin(), params.modelParams.end());
+    dispatchCameraModel(params.model, [&intrinsics](auto tag) {
+        pinholeParams<decltype(tag)::value>(intrinsics.params.data(), intrinsics.fx, intrinsics.fy, intrinsics.cx, intrinsics.cy);
+    });
+    if (!(intrinsics.fx > 0.0) || !(intrinsics.fy > 0.0)) {
+        throw std::invalid_argument("The focal length of the camera must be positive");
+    }
+    intrinsics.fxNormalized = intrinsics.fx / static_cast<double>(width);
+    intrinsics.fyNormalized = intrinsics.fy / static_cast<double>(height);
+    intrinsics.cxNormalized = intrinsics.cx / static_cast<double>(width);
+    intrinsics.cyNormalized = intrinsics.cy / static_cast<double>(height);
+    return intrinsics;
+}
+
+size_t undistortionMapBytes(const CameraIntrinsics& intrinsics) {
+    if (!intrinsics.hasDistortion()) {
+        return 0;
+    }
+    constexpr size_t bytesPerPixel = 2 * sizeof(float); // mapX and mapY
+    if (intrinsics.height != 0 && intrinsics.width > SIZE_MAX / bytesPerPixel / intrinsics.height) {
+        return SIZE_MAX;
+    }
+    return intrinsics.width * intrinsics.height * bytesPerPixel;
+}
+
+UndistortionMap makeUndistortionMap(const CameraIntrinsics& intrinsics, size_t maxBytes) {
+    UndistortionMap map;
+    map.width = intrinsics.width;
+    map.height = intrinsics.height;
+    const size_t bytes = undistortionMapBytes(intrinsics);
+    if (bytes == 0 || bytes > maxBytes) {
+        return map;
+    }
+    const size_t pixelCount = intrinsics.width * intrinsics.height;
+    map.mapX.resize(pixelCount);
+    map.mapY.resize(pixelCount);
+    dispatchCameraModel(intrinsics.model, [&intrinsics, &map](auto tag) {
+        buildUndistortionMap<decltype(tag)::value>(intrinsics.params.data(), intrinsics.width, intrinsics.height,
+                                                   map.mapX.data(), map.mapY.data());
+    });
+    return map;
+}
+
+} // namespace oscp
@@ -0,0 +1,407 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/compression.h>
+#include <oscp-gpp/content_negotiation.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#ifdef OSCP_GPP_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef OSCP_GPP_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace oscp {
+
+namespace {
+
+constexpr size_t outputStep = 64 * 1024;
+
+#ifdef OSCP_GPP_HAS_ZSTD
+constexpr int zstdWindowLogMax = 23; // 8 MiB, the window of level 19 and below for bodies up to 8 MiB
+#endif
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        const char ca = (a[i] >= 'A' && a[i] <= 'Z') ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+        const char cb = (b[i] >= 'A' && b[i] <= 'Z') ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+        if (ca != cb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A q value of zero, e.g. "0" or "0.000"
+bool isZeroQuality(std::string_view value) {
+    return !value.empty() && value.front() == '0' && value.find_first_not_of("0.") == std::string_view::npos;
+}
+
+// Media types whose content is compressed already, compressing them again costs CPU for nothing
+bool isCompressedMediaType(std::string_view contentType) {
+    MediaType mediaType;
+    if (!parseMediaType(contentType, mediaType)) {
+        return false;
+    }
+    if (equalsIgnoreCase(mediaType.type, "image")) {
+        return !equalsIgnoreCase(mediaType.subtype, "svg+xml");
+    }
+    if (equalsIgnoreCase(mediaType.type, "video") || equalsIgnoreCase(mediaType.type, "audio")) {
+        return true;
+    }
+    return equalsIgnoreCase(mediaType.type, "application")
+        && (equalsIgnoreCase(mediaType.subtype, "zip") || equalsIgnoreCase(mediaType.subtype, "gzip")
+            || equalsIgnoreCase(mediaType.subtype, "zstd") || equalsIgnoreCase(mediaType.subtype, "x-xz")
+            || equalsIgnoreCase(mediaType.subtype, "x-bzip2"));
+}
+
+#ifdef OSCP_GPP_HAS_ZLIB
+std::string gzipCompress(std::string_view body, int level) {
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) { // 15 + 16: gzip header
+        throw std::runtime_error("Could not initialize gzip compression");
+    }
+    std::string compressed;
+    compressed.resize(deflateBound(&stream, static_cast<uLong>(body.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+    stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+    // Fed in pieces because avail_in and avail_out are 32-bit
+    size_t remainingIn = body.size();
+    size_t remainingOut = compressed.size();
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        const uInt in = static_cast<uInt>(std::min<size_t>(remainingIn, std::numeric_limits<uInt>::max()));
+        const uInt out = static_cast<uInt>(std::min<size_t>(remainingOut, std::numeric_limits<uInt>::max()));
+        stream.avail_in = in;
+        stream.avail_out = out;
+        ret = deflate(&stream, remainingIn == in ? Z_FINISH : Z_NO_FLUSH);
+        remainingIn -= in - stream.avail_in;
+        remainingOut -= out - stream.avail_out;
+    }
+    deflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+        throw std::runtime_error("gzip compression failed");
+    }
+    compressed.resize(compressed.size() - remainingOut);
+    return compressed;
+}
+#endif
+
+#ifdef OSCP_GPP_HAS_ZSTD
+std::string zstdCompress(std::string_view body, int level) {
+    std::string compressed;
+    compressed.resize(ZSTD_compressBound(body.size()));
+    const size_t size = ZSTD_compress(&compressed[0], compressed.size(), body.data(), body.size(), level);
+    if (ZSTD_isError(size)) {
+        throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(size));
+    }
+    compressed.resize(size);
+    return compressed;
+}
+#endif
+
+} // namespace
+
+bool isContentCodingSupported(ContentCoding coding) {
+    switch (coding) {
+    case ContentCoding::IDENTITY:
+        return true;
+    case ContentCoding::GZIP:
+#ifdef OSCP_GPP_HAS_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case ContentCoding::ZSTD:
+#ifdef OSCP_GPP_HAS_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+ContentCoding parseContentCoding(std::string_view contentEncoding) {
+    contentEncoding = trim(contentEncoding);
+    if (contentEncoding.empty() || equalsIgnoreCase(contentEncoding, "identity")) {
+        return ContentCoding::IDENTITY;
+    }
+    if (equalsIgnoreCase(contentEncoding, "gzip") || equalsIgnoreCase(contentEncoding, "x-gzip")) {
+        return ContentCoding::GZIP;
+    }
+    if (equalsIgnoreCase(contentEncoding, "zstd")) {
+        return ContentCoding::ZSTD;
+    }
+    return ContentCoding::UNKNOWN;
+}
+
+bool acceptsContentCoding(std::string_view acceptEncoding, ContentCoding coding) {
+    if (coding == ContentCoding::UNKNOWN) {
+        return false;
+    }
+    // A coding that is listed by name counts, wherever it is, over "*"
+    std::optional<bool> listed;
+    std::optional<bool> wildcard;
+    while (!acceptEncoding.empty()) {
+        std::string_view parameters = nextListElement(acceptEncoding);
+        const size_t semicolon = parameters.find(';');
+        const std::string_view name = trim(parameters.substr(0, semicolon));
+        parameters = semicolon == std::string_view::npos ? std::string_view() : parameters.substr(semicolon + 1);
+        bool accepted = true;
+        while (!parameters.empty()) {
+            const size_t next = parameters.find(';');
+            const std::string_view parameter = parameters.substr(0, next);
+            parameters = next == std::string_view::npos ? std::string_view() : parameters.substr(next + 1);
+            const size_t equals = parameter.find('=');
+            if (equals != std::string_view::npos && equalsIgnoreCase(trim(parameter.substr(0, equals)), "q")) {
+                accepted = !isZeroQuality(trim(parameter.substr(equals + 1)));
+            }
+        }
+        if (name == "*") {
+            wildcard = accepted;
+        } else if (parseContentCoding(name) == coding && !name.empty()) {
+            listed = accepted;
+        }
+    }
+    if (listed) {
+        return *listed;
+    }
+    return wildcard.value_or(coding == ContentCoding::IDENTITY);
+}
+
+ContentCoding chooseContentCoding(std::string_view body, std::string_view contentType, ContentCoding coding, const CompressionPolicy& policy) {
+    if (coding == ContentCoding::IDENTITY || !isContentCodingSupported(coding) || body.size() < policy.minBytes
+        || isCompressedMediaType(contentType)) {
+        return ContentCoding::IDENTITY;
+    }
+
+    size_t sampled = 0;
+    size_t compressed = 0;
+    const size_t sampleCount = std::max<size_t>(policy.sampleCount, 1);
+    if (body.size() <= policy.sampleBytes * sampleCount) {
+        sampled = body.size();
+        compressed = compressBody(body, coding, policy).size();
+    } else {
+        // Evenly spaced from the beginning to the end, so that e.g. an image in the middle of a JSON body is weighted by its share
+        const size_t stride = sampleCount > 1 ? (body.size() - policy.sampleBytes) / (sampleCount - 1) : 0;
+        for (size_t i = 0; i < sampleCount; i++) {
+            const std::string_view sample = body.substr(i * stride, policy.sampleBytes);
+            sampled += sample.size();
+            compressed += compressBody(sample, coding, policy).size();
+        }
+    }
+    return static_cast<double>(compressed) <= static_cast<double>(sampled) * (1.0 - policy.minSavings) ? coding : ContentCoding::IDENTITY;
+}
+
+std::string compressBody(std::string_view body, ContentCoding coding, const CompressionPolicy& policy) {
+    switch (coding) {
+    case ContentCoding::IDENTITY:
+        return std::string(body);
+#ifdef OSCP_GPP_HAS_ZLIB
+    case ContentCoding::GZIP:
+        return gzipCompress(body, policy.gzipLevel);
+#endif
+#ifdef OSCP_GPP_HAS_ZSTD
+    case ContentCoding::ZSTD:
+        return zstdCompress(body, policy.zstdLevel);
+#endif
+    default:
+        throw std::invalid_argument("Content coding not supported: " + std::string(toString(coding)));
+    }
+}
+
+struct Decompressor::State {
+    ContentCoding coding;
+    size_t maxDecompressedBytes;
+    size_t decompressedBytes = 0;
+    DecompressionStatus status = DecompressionStatus::OK;
+    bool ended = false; // at the end of a gzip member or zstd frame, where the body may end
+#ifdef OSCP_GPP_HAS_ZLIB
+    z_stream zlib{};
+    bool zlibInitialized = false;
+#endif
+#ifdef OSCP_GPP_HAS_ZSTD
+    ZSTD_DCtx* zstd = nullptr;
+#endif
+
+    State(ContentCoding coding, size_t maxDecompressedBytes) : coding(coding), maxDecompressedBytes(maxDecompressedBytes) {}
+
+    ~State() {
+#ifdef OSCP_GPP_HAS_ZLIB
+        if (zlibInitialized) {
+            inflateEnd(&zlib);
+        }
+#endif
+#ifdef OSCP_GPP_HAS_ZSTD
+        ZSTD_freeDCtx(zstd);
+#endif
+    }
+
+    DecompressionStatus fail(DecompressionStatus error) {
+        status = error;
+        return error;
+    }
+
+    // Room for the next step of output, one byte more than allowed so that exceeding the limit is noticed
+    size_t outputRoom() const {
+        const size_t remaining = maxDecompressedBytes - decompressedBytes;
+        return remaining >= outputStep ? outputStep : remaining + 1;
+    }
+};
+
+Decompressor::Decompressor(ContentCoding coding, size_t maxDecompressedBytes)
+    : state_(std::make_unique<State>(coding, maxDecompressedBytes)) {
+    if (!isContentCodingSupported(coding)) {
+        state_->fail(DecompressionStatus::UNSUPPORTED_CODING);
+        return;
+    }
+#ifdef OSCP_GPP_HAS_ZLIB
+    if (coding == ContentCoding::GZIP) {
+        if (inflateInit2(&state_->zlib, 15 + 16) != Z_OK) { // 15 + 16: gzip header
+            throw std::runtime_error("Could not initialize gzip decompression");
+        }
+        state_->zlibInitialized = true;
+    }
+#endif
+#ifdef OSCP_GPP_HAS_ZSTD
+    if (coding == ContentCoding::ZSTD) {
+        state_->zstd = ZSTD_createDCtx();
+        if (state_->zstd == nullptr) {
+            throw std::runtime_error("Could not initialize zstd decompression");
+        }
+        ZSTD_DCtx_setParameter(state_->zstd, ZSTD_d_windowLogMax, zstdWindowLogMax);
+    }
+#endif
+}
+
+Decompressor::~Decompressor() = default;
+
+DecompressionStatus Decompressor::write(const char* data, size_t size, std::string& output) {
+    State& s = *state_;
+    if (s.status != DecompressionStatus::OK) {
+        return s.status;
+    }
+
+    if (s.coding == ContentCoding::IDENTITY) {
+        if (size > s.maxDecompressedBytes - s.decompressedBytes) {
+            return s.fail(DecompressionStatus::TOO_LARGE);
+        }
+        output.append(data, size);
+        s.decompressedBytes += size;
+        return DecompressionStatus::OK;
+    }
+
+#ifdef OSCP_GPP_HAS_ZLIB
+    if (s.coding == ContentCoding::GZIP) {
+        while (size > 0) {
+            const uInt in = static_cast<uInt>(std::min<size_t>(size, std::numeric_limits<uInt>::max()));
+            s.zlib.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            s.zlib.avail_in = in;
+            for (;;) {
+                if (s.ended && s.zlib.avail_in > 0) {
+                    inflateReset(&s.zlib); // the next member of a multi-member gzip body
+                    s.ended = false;
+                }
+                const size_t before = output.size();
+                const size_t room = s.outputRoom();
+                output.resize(before + room);
+                s.zlib.next_out = reinterpret_cast<Bytef*>(&output[before]);
+                s.zlib.avail_out = static_cast<uInt>(room);
+                const int ret = inflate(&s.zlib, Z_NO_FLUSH);
+                const size_t produced = room - s.zlib.avail_out;
+                output.resize(before + produced);
+                s.decompressedBytes += produced;
+                if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                    return s.fail(DecompressionStatus::INVALID_DATA);
+                }
+                if (s.decompressedBytes > s.maxDecompressedBytes) {
+                    return s.fail(DecompressionStatus::TOO_LARGE);
+                }
+                s.ended = ret == Z_STREAM_END;
+                if (s.zlib.avail_in == 0 && (s.ended || s.zlib.avail_out > 0)) {
+                    break;
+                }
+                if (ret == Z_BUF_ERROR && produced == 0) {
+                    return s.fail(DecompressionStatus::INVALID_DATA); // no progress possible
+                }
+            }
+            data += in;
+            size -= in;
+        }
+        return DecompressionStatus::OK;
+    }
+#endif
+
+#ifdef OSCP_GPP_HAS_ZSTD
+    if (s.coding == ContentCoding::ZSTD) {
+        ZSTD_inBuffer in{data, size, 0};
+        for (;;) {
+            const size_t before = output.size();
+            const size_t room = s.outputRoom();
+            output.resize(before + room);
+            ZSTD_outBuffer out{&output[before], room, 0};
+            const size_t ret = ZSTD_decompressStream(s.zstd, &out, &in);
+            output.resize(before + out.pos);
+            s.decompressedBytes += out.pos;
+            if (ZSTD_isError(ret)) {
+                return s.fail(DecompressionStatus::INVALID_DATA);
+            }
+            if (s.decompressedBytes > s.maxDecompressedBytes) {
+                return s.fail(DecompressionStatus::TOO_LARGE);
+            }
+            s.ended = ret == 0;
+            if (in.pos == in.size && out.pos < out.size) {
+                break;
+            }
+        }
+        return DecompressionStatus::OK;
+    }
+#endif
+
+    return s.fail(DecompressionStatus::UNSUPPORTED_CODING);
+}
+
+DecompressionStatus Decompressor::finish() {
+    State& s = *state_;
+    if (s.status != DecompressionStatus::OK || s.coding == ContentCoding::IDENTITY) {
+        return s.status;
+    }
+    return s.ended ? DecompressionStatus::OK : s.fail(DecompressionStatus::INVALID_DATA);
+}
+
+size_t Decompressor::decompressedBytes() const {
+    return state_->decompressedBytes;
+}
+
+DecompressionStatus decompressBody(std::string_view body, ContentCoding coding, size_t maxDecompressedBytes, std::string& output) {
+    Decompressor decompressor(coding, maxDecompressedBytes);
+    const DecompressionStatus status = decompressor.write(body.data(), body.size(), output);
+    return status == DecompressionStatus::OK ? decompressor.finish() : status;
+}
+
+} // namespace oscp
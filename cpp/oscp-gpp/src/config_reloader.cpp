@@ -0,0 +1,112 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/config_reloader.h>
+
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace oscp {
+
+namespace {
+
+// Lock-free, so it may be updated in a signal handler and read on the thread of the reloader
+std::atomic<uint32_t> hangupCount{0};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "hangupCount must be lock-free");
+
+extern "C" void onHangup(int) {
+    hangupCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+ConfigReloader::ConfigReloader(std::string path, std::filesystem::file_time_type loadedVersion, Apply apply, const ConfigReloaderPolicy& policy)
+    : path_(std::move(path)), apply_(std::move(apply)), policy_(policy), loadedVersion_(loadedVersion),
+      thread_([this]() { run(); })
+{
+}
+
+ConfigReloader::~ConfigReloader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stop_.notify_one();
+    thread_.join();
+}
+
+ConfigReloaderStats ConfigReloader::stats() const {
+    ConfigReloaderStats stats;
+    stats.reloads = reloads_.load();
+    stats.failures = failures_.load();
+    return stats;
+}
+
+std::filesystem::file_time_type ConfigReloader::version(const std::string& path) {
+    std::error_code error;
+    const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+
+void ConfigReloader::run() {
+#ifndef _WIN32
+    struct sigaction previous = {};
+    if (policy_.reloadOnSighup) {
+        struct sigaction action = {};
+        action.sa_handler = onHangup;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGHUP, &action, &previous);
+    }
+#endif
+    uint32_t seenHangups = hangupCount.load(std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        const std::filesystem::file_time_type current = version(path_);
+        const uint32_t hangups = hangupCount.load(std::memory_order_relaxed);
+        if (hangups != seenHangups || (current != loadedVersion_ && current != std::filesystem::file_time_type::min())) {
+            seenHangups = hangups;
+            reload(current);
+        }
+        lock.lock();
+        stop_.wait_for(lock, std::chrono::milliseconds(policy_.pollIntervalMs), [this] { return stopping_; });
+    }
+
+#ifndef _WIN32
+    if (policy_.reloadOnSighup) {
+        sigaction(SIGHUP, &previous, nullptr);
+    }
+#endif
+}
+
+void ConfigReloader::reload(std::filesystem::file_time_type version) {
+    // A rejected version is not tried again until the file changes
+    loadedVersion_ = version;
+    std::ifstream file(path_, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    bool applied = false;
+    if (file.is_open()) {
+        try {
+            applied = apply_(contents);
+        } catch (...) {
+            applied = false;
+        }
+    }
+    if (applied) {
+        reloads_++;
+    } else {
+        failures_++;
+    }
+}
+
+} // namespace oscp
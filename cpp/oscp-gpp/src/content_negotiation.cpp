@@ -0,0 +1,342 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/content_negotiation.h>
+
+namespace oscp {
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && isSpace(s.front())) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && isSpace(s.back())) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// tchar of RFC 9110
+bool isTokenChar(char c) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || isDigit(c)) {
+        return true;
+    }
+    switch (c) {
+    case '!': case '#': case '$': case '%': case '&': case '\'': case '*':
+    case '+': case '-': case '.': case '^': case '_': case '`': case '|': case '~':
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isToken(std::string_view s) {
+    if (s.empty()) {
+        return false;
+    }
+    for (char c : s) {
+        if (!isTokenChar(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (toLower(a[i]) != toLower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Splits at the first separator outside a quoted string
+std::string_view nextElement(std::string_view& list, char separator) {
+    bool quoted = false;
+    size_t i = 0;
+    for (; i < list.size(); i++) {
+        const char c = list[i];
+        if (quoted) {
+            if (c == '\\') {
+                i++; // quoted-pair
+            } else if (c == '"') {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == separator) {
+            break;
+        }
+    }
+    if (i >= list.size()) {
+        const std::string_view element = list;
+        list = std::string_view();
+        return trim(element);
+    }
+    const std::string_view element = list.substr(0, i);
+    list.remove_prefix(i + 1);
+    return trim(element);
+}
+
+// Up to 4 digits, which is plenty for a protocol version
+bool parseSmallNumber(std::string_view s, int& value) {
+    if (s.empty() || s.size() > 4) {
+        return false;
+    }
+    value = 0;
+    for (char c : s) {
+        if (!isDigit(c)) {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+// "2.0" or "2", see MediaType
+bool parseVersion(std::string_view s, int& versionMajor, int& versionMinor) {
+    const size_t dot = s.find('.');
+    if (dot == std::string_view::npos) {
+        versionMinor = -1;
+        return parseSmallNumber(s, versionMajor);
+    }
+    return parseSmallNumber(s.substr(0, dot), versionMajor) && parseSmallNumber(s.substr(dot + 1), versionMinor);
+}
+
+// qvalue of RFC 9110: "0", "0.5", "1", "1.000", ...
+bool parseQuality(std::string_view s, int& quality) {
+    if (s.empty() || (s[0] != '0' && s[0] != '1')) {
+        return false;
+    }
+    quality = (s[0] - '0') * 1000;
+    if (s.size() == 1) {
+        return true;
+    }
+    if (s[1] != '.' || s.size() > 5) {
+        return false;
+    }
+    int scale = 100;
+    for (size_t i = 2; i < s.size(); i++, scale /= 10) {
+        if (!isDigit(s[i])) {
+            return false;
+        }
+        quality += (s[i] - '0') * scale;
+    }
+    return quality <= 1000;
+}
+
+bool endsWithIgnoreCase(std::string_view s, std::string_view suffix) {
+    return s.size() >= suffix.size() && equalsIgnoreCase(s.substr(s.size() - suffix.size()), suffix);
+}
+
+bool versionMatches(const MediaType& mediaType, const ProtocolVersion& version) {
+    return mediaType.versionMajor < 0
+        || (mediaType.versionMajor == version.versionMajor
+            && (mediaType.versionMinor < 0 || mediaType.versionMinor == version.versionMinor));
+}
+
+// How specific a media range matches a representation, or -1 if it does not match
+int matchSpecificity(const MediaType& range, const Representation& representation) {
+    if (!versionMatches(range, representation.version)) {
+        return -1;
+    }
+    int specificity;
+    if (range.type == "*") {
+        if (range.subtype != "*") {
+            return -1;
+        }
+        specificity = 0;
+    } else if (!equalsIgnoreCase(range.type, representation.type)) {
+        return -1;
+    } else if (range.subtype == "*") {
+        specificity = 2;
+    } else if (equalsIgnoreCase(range.subtype, representation.subtype)) {
+        specificity = 4;
+    } else {
+        return -1;
+    }
+    return range.versionMajor >= 0 ? specificity + 1 : specificity;
+}
+
+} // namespace
+
+bool parseMediaType(std::string_view text, MediaType& mediaType) {
+    mediaType = MediaType();
+    std::string_view parameters = text;
+    const std::string_view typeAndSubtype = nextElement(parameters, ';');
+    const size_t slash = typeAndSubtype.find('/');
+    if (slash == std::string_view::npos) {
+        return false;
+    }
+    mediaType.type = trim(typeAndSubtype.substr(0, slash));
+    mediaType.subtype = trim(typeAndSubtype.substr(slash + 1));
+    if (!isToken(mediaType.type) || !isToken(mediaType.subtype)) {
+        return false;
+    }
+
+    while (!parameters.empty()) {
+        const std::string_view parameter = nextElement(parameters, ';');
+        if (parameter.empty()) {
+            continue; // e.g. the trailing ';' of "application/vnd.oscp+json;version=2.0;"
+        }
+        const size_t equals = parameter.find('=');
+        if (equals == std::string_view::npos) {
+            return false;
+        }
+        const std::string_view name = trim(parameter.substr(0, equals));
+        std::string_view value = trim(parameter.substr(equals + 1));
+        if (!isToken(name)) {
+            return false;
+        }
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+        if (equalsIgnoreCase(name, "q")) {
+            if (!parseQuality(value, mediaType.quality)) {
+                return false;
+            }
+        } else if (equalsIgnoreCase(name, "version")) {
+            if (!parseVersion(value, mediaType.versionMajor, mediaType.versionMinor)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string_view nextListElement(std::string_view& list) {
+    return nextElement(list, ',');
+}
+
+WireEncoding encodingOf(const MediaType& mediaType) {
+    if (equalsIgnoreCase(mediaType.subtype, "json") || endsWithIgnoreCase(mediaType.subtype, "+json")) {
+        return WireEncoding::JSON;
+    }
+    return WireEncoding::UNKNOWN;
+}
+
+Representation makeRepresentation(std::string_view mediaType, ProtocolVersion version, WireEncoding encoding) {
+    MediaType parsed;
+    if (!parseMediaType(mediaType, parsed) || parsed.type == "*" || parsed.subtype == "*") {
+        throw std::invalid_argument("Invalid media type of a representation: " + std::string(mediaType));
+    }
+    Representation representation;
+    for (char c : parsed.type) {
+        representation.type += toLower(c);
+    }
+    for (char c : parsed.subtype) {
+        representation.subtype += toLower(c);
+    }
+    representation.version = version;
+    representation.encoding = encoding;
+    representation.contentType = representation.type + "/" + representation.subtype + "; version="
+        + std::to_string(version.versionMajor) + "." + std::to_string(version.versionMinor);
+    return representation;
+}
+
+std::optional<size_t> selectResponseRepresentation(const Representation* representations, size_t count, std::string_view accept) {
+    if (count == 0) {
+        return std::nullopt;
+    }
+    accept = trim(accept);
+    if (accept.empty()) {
+        return 0;
+    }
+    if (count > maxRepresentations) {
+        count = maxRepresentations;
+    }
+
+    int specificity[maxRepresentations];
+    int quality[maxRepresentations];
+    for (size_t i = 0; i < count; i++) {
+        specificity[i] = -1;
+        quality[i] = 0;
+    }
+    while (!accept.empty()) {
+        const std::string_view element = nextListElement(accept);
+        MediaType range;
+        if (element.empty() || !parseMediaType(element, range)) {
+            continue; // a malformed media range is ignored rather than failing the whole header
+        }
+        for (size_t i = 0; i < count; i++) {
+            const int s = matchSpecificity(range, representations[i]);
+            if (s > specificity[i]) {
+                specificity[i] = s;
+                quality[i] = range.quality;
+            }
+        }
+    }
+
+    std::optional<size_t> best;
+    for (size_t i = 0; i < count; i++) {
+        if (quality[i] == 0) {
+            continue; // not matched, or explicitly not acceptable with q=0
+        }
+        if (!best || quality[i] > quality[*best] || (quality[i] == quality[*best] && specificity[i] > specificity[*best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+std::optional<size_t> selectRequestRepresentation(const Representation* representations, size_t count, std::string_view contentType) {
+    if (count == 0) {
+        return std::nullopt;
+    }
+    if (trim(contentType).empty()) {
+        return 0;
+    }
+    MediaType mediaType;
+    if (!parseMediaType(contentType, mediaType)) {
+        return std::nullopt;
+    }
+
+    bool registeredType = false;
+    for (size_t i = 0; i < count; i++) {
+        const Representation& representation = representations[i];
+        if (equalsIgnoreCase(mediaType.type, representation.type) && equalsIgnoreCase(mediaType.subtype, representation.subtype)) {
+            registeredType = true;
+            if (versionMatches(mediaType, representation.version)) {
+                return i;
+            }
+        }
+    }
+    if (registeredType) {
+        return std::nullopt; // a version that is not supported
+    }
+
+    const WireEncoding encoding = encodingOf(mediaType);
+    if (encoding == WireEncoding::UNKNOWN) {
+        return std::nullopt;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (representations[i].encoding == encoding) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace oscp
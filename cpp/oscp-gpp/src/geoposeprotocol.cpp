@@ -0,0 +1,235 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/geoposeprotocol.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace oscp {
+
+// Calls f(privacy) for the privacy of every reading and every IMU block
+template<typename Function>
+static void forEachPrivacy(SensorReadings& t, Function&& f) {
+    auto visit = [&f](auto& readings) {
+        for (auto& reading : readings) {
+            f(reading.privacy);
+        }
+    };
+    visit(t.cameraReadings);
+    visit(t.accelerometerReadings);
+    visit(t.geolocationReadings);
+    visit(t.wifiReadings);
+    visit(t.bluetoothReadings);
+    visit(t.gyroscopeReadings);
+    visit(t.magnetometerReadings);
+    visit(t.accelerometerBlocks);
+    visit(t.gyroscopeBlocks);
+    visit(t.magnetometerBlocks);
+}
+
+void factorOutPrivacy(GeoPoseRequest& request) {
+    if (!request.privacy.has_value()) {
+        // There are usually only one or two distinct privacy settings per request
+        std::vector<std::pair<const Privacy*, size_t>> counts;
+        bool allReadingsHavePrivacy = true;
+        forEachPrivacy(request.sensorReadings, [&](const std::optional<Privacy>& privacy) {
+            if (!privacy.has_value()) {
+                allReadingsHavePrivacy = false;
+                return;
+            }
+            auto it = std::find_if(counts.begin(), counts.end(), [&](const std::pair<const Privacy*, size_t>& count) {
+                return *count.first == *privacy;
+            });
+            if (it == counts.end()) {
+                counts.emplace_back(&*privacy, 1);
+            } else {
+                it->second++;
+            }
+        });
+        if (!allReadingsHavePrivacy || counts.empty()) {
+            return;
+        }
+        auto mostCommon = std::max_element(counts.begin(), counts.end(), [](const std::pair<const Privacy*, size_t>& lhs, const std::pair<const Privacy*, size_t>& rhs) {
+            return lhs.second < rhs.second;
+        });
+        request.privacy.emplace(*mostCommon->first, request.id.get_allocator());
+    }
+
+    const Privacy& defaultPrivacy = *request.privacy;
+    forEachPrivacy(request.sensorReadings, [&](std::optional<Privacy>& privacy) {
+        if (privacy.has_value() && *privacy == defaultPrivacy) {
+            privacy.reset();
+        }
+    });
+}
+
+namespace {
+
+// Maps sensor IDs to handles. Consecutive readings usually come from the same sensor,
+// so the last hit is remembered and most lookups are a single string comparison.
+class SensorIndex {
+public:
+    explicit SensorIndex(const GeoPoseRequest& request) : request_(request) {
+    }
+
+    std::optional<ParseError> build() {
+        index_.reserve(request_.sensors.size());
+        for (size_t i = 0; i < request_.sensors.size(); i++) {
+            if (!index_.emplace(request_.sensors[i].id, static_cast<SensorHandle>(i)).second) {
+                return ParseError(ParseErrorCode::DUPLICATE_SENSOR_ID, "/sensors/" + std::to_string(i) + "/id",
+                    "Duplicate sensor id: " + std::string(request_.sensors[i].id));
+            }
+        }
+        return std::nullopt;
+    }
+
+    // The readings are at /sensorReadings/<name>
+    template<typename Reading>
+    std::optional<ParseError> resolve(std::pmr::vector<Reading>& readings, SensorType expectedType, const char* name) {
+        for (size_t i = 0; i < readings.size(); i++) {
+            Reading& reading = readings[i];
+            if (lastHandle_ == invalidSensorHandle || request_.sensors[lastHandle_].id != reading.sensorId) {
+                auto it = index_.find(reading.sensorId);
+                if (it == index_.end()) {
+                    return ParseError(ParseErrorCode::UNDECLARED_SENSOR, pathOf(name, i),
+                        "Reading references undeclared sensor: " + std::string(reading.sensorId));
+                }
+                lastHandle_ = it->second;
+            }
+            const Sensor& sensor = request_.sensors[lastHandle_];
+            if (sensor.type != expectedType) {
+                return ParseError(ParseErrorCode::SENSOR_TYPE_MISMATCH, pathOf(name, i),
+                    "Sensor " + std::string(sensor.id) + " of type " + std::string(toString(sensor.type))
+                    + " cannot provide a " + std::string(toString(expectedType)) + " reading");
+            }
+            reading.sensorHandle = lastHandle_;
+        }
+        return std::nullopt;
+    }
+
+private:
+    static std::string pathOf(const char* name, size_t i) {
+        return "/sensorReadings/" + std::string(name) + "/" + std::to_string(i) + "/sensorId";
+    }
+
+    const GeoPoseRequest& request_;
+    std::unordered_map<std::string_view, SensorHandle> index_;
+    SensorHandle lastHandle_ = invalidSensorHandle;
+};
+
+} // namespace
+
+std::optional<ParseError> tryIndexSensors(GeoPoseRequest& request) {
+    SensorIndex index(request);
+    std::optional<ParseError> error = index.build();
+    SensorReadings& t = request.sensorReadings;
+    if (!error) error = index.resolve(t.cameraReadings, SensorType::CAMERA, "cameraReadings");
+    if (!error) error = index.resolve(t.geolocationReadings, SensorType::GEOLOCATION, "geolocationReadings");
+    if (!error) error = index.resolve(t.wifiReadings, SensorType::WIFI, "wifiReadings");
+    if (!error) error = index.resolve(t.bluetoothReadings, SensorType::BLUETOOTH, "bluetoothReadings");
+    if (!error) error = index.resolve(t.accelerometerReadings, SensorType::ACCELEROMETER, "accelerometerReadings");
+    if (!error) error = index.resolve(t.gyroscopeReadings, SensorType::GYROSCOPE, "gyroscopeReadings");
+    if (!error) error = index.resolve(t.magnetometerReadings, SensorType::MAGNETOMETER, "magnetometerReadings");
+    if (!error) error = index.resolve(t.accelerometerBlocks, SensorType::ACCELEROMETER, "accelerometerBlocks");
+    if (!error) error = index.resolve(t.gyroscopeBlocks, SensorType::GYROSCOPE, "gyroscopeBlocks");
+    if (!error) error = index.resolve(t.magnetometerBlocks, SensorType::MAGNETOMETER, "magnetometerBlocks");
+    return error;
+}
+
+void indexSensors(GeoPoseRequest& request) {
+    if (std::optional<ParseError> error = tryIndexSensors(request)) {
+        throw std::runtime_error(error->message);
+    }
+}
+
+std::optional<ParseError> tryValidateSession(const GeoPoseSession& session) {
+    std::unordered_map<std::string_view, const Sensor*> sensors;
+    sensors.reserve(session.sensors.size());
+    for (size_t i = 0; i < session.sensors.size(); i++) {
+        const Sensor& sensor = session.sensors[i];
+        if (!sensors.emplace(sensor.id, &sensor).second) {
+            return ParseError(ParseErrorCode::DUPLICATE_SENSOR_ID, "/sensors/" + std::to_string(i) + "/id",
+                "Duplicate sensor id: " + std::string(sensor.id));
+        }
+    }
+    for (size_t i = 0; i < session.cameras.size(); i++) {
+        const SessionCamera& camera = session.cameras[i];
+        auto it = sensors.find(camera.sensorId);
+        if (it == sensors.end()) {
+            return ParseError(ParseErrorCode::UNDECLARED_SENSOR, "/cameras/" + std::to_string(i) + "/sensorId",
+                "Camera references undeclared sensor: " + std::string(camera.sensorId));
+        }
+        if (it->second->type != SensorType::CAMERA) {
+            return ParseError(ParseErrorCode::SENSOR_TYPE_MISMATCH, "/cameras/" + std::to_string(i) + "/sensorId",
+                "Sensor " + std::string(camera.sensorId) + " of type " + std::string(toString(it->second->type))
+                + " cannot have camera params");
+        }
+    }
+    return std::nullopt;
+}
+
+void validateSession(const GeoPoseSession& session) {
+    if (std::optional<ParseError> error = tryValidateSession(session)) {
+        throw std::runtime_error(error->message);
+    }
+}
+
+std::optional<ParseError> tryResolveSensors(GeoPoseRequest& request, const GeoPoseSession& session) {
+    request.sensors.assign(session.sensors.begin(), session.sensors.end());
+    if (!request.privacy.has_value() && session.privacy.has_value()) {
+        request.privacy.emplace(*session.privacy, request.id.get_allocator());
+    }
+    // A session has only a handful of cameras, a linear search is fine
+    for (CameraReading& reading : request.sensorReadings.cameraReadings) {
+        if (reading.params.model != CameraModel::UNKNOWN) {
+            continue;
+        }
+        for (const SessionCamera& camera : session.cameras) {
+            if (camera.sensorId == reading.sensorId) {
+                reading.params = camera.params;
+                break;
+            }
+        }
+    }
+    return tryIndexSensors(request);
+}
+
+void resolveSensors(GeoPoseRequest& request, const GeoPoseSession& session) {
+    if (std::optional<ParseError> error = tryResolveSensors(request, session)) {
+        throw std::runtime_error(error->message);
+    }
+}
+
+GeoPoseSession sessionOf(const GeoPoseRequest& request) {
+    GeoPoseSession session;
+    session.sensors.assign(request.sensors.begin(), request.sensors.end());
+    if (request.privacy.has_value()) {
+        session.privacy = *request.privacy;
+    }
+    for (const CameraReading& reading : request.sensorReadings.cameraReadings) {
+        if (reading.params.model == CameraModel::UNKNOWN) {
+            continue;
+        }
+        auto it = std::find_if(session.cameras.begin(), session.cameras.end(), [&reading](const SessionCamera& camera) {
+            return camera.sensorId == reading.sensorId;
+        });
+        if (it == session.cameras.end()) {
+            SessionCamera& camera = session.cameras.emplace_back();
+            camera.sensorId = reading.sensorId;
+            camera.params = reading.params;
+        }
+    }
+    return session;
+}
+
+} // namespace oscp
@@ -10,10 +10,309 @@
 
 #include <oscp-gpp/geoposeprotocol_json.h>
 #include <oscp-gpp/geopose_json.h>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
 
 namespace oscp {
 
+namespace {
+
+/**
+Reads the protocol structs from json without throwing. Every read returns false at the first violation,
+which is recorded in error. The JSON pointer to the offending value is assembled while the failure propagates up,
+each level prepends its key or index, so valid documents do not pay for any path bookkeeping.
+The keys are those of the schema, none of them needs the ~0 / ~1 escaping of RFC 6901.
+*/
+class JsonReader {
+public:
+    const json* defaultPrivacy = nullptr; // request-level privacy of the GeoPoseRequest being read, if any
+    std::optional<ParseError> error;
+
+    bool fail(ParseErrorCode code, std::string message) {
+        error.emplace(code, std::string(), std::move(message));
+        return false;
+    }
+
+    bool wrongType(const json& j, const char* expected) {
+        return fail(ParseErrorCode::WRONG_TYPE, std::string("Expected ") + expected + " but got " + j.type_name());
+    }
+
+    // Prepends a key or an index to the path of the error
+    bool failedIn(const char* key) {
+        error->path.insert(0, std::string("/") + key);
+        return false;
+    }
+
+    bool failedIn(size_t index) {
+        error->path.insert(0, "/" + std::to_string(index));
+        return false;
+    }
+
+    bool object(const json& j) {
+        return j.is_object() || wrongType(j, "an object");
+    }
+
+    // Reads the member key of the object j, which must be present
+    template<typename T>
+    bool member(const json& j, const char* key, T& t);
+
+    // Reads the member key of the object j if it is present, leaves t alone otherwise
+    template<typename T>
+    bool optionalMember(const json& j, const char* key, T& t);
+};
+
+} // namespace
+
+// The reads of values without associated namespace must be declared before JsonReader::member(),
+// the reads of the protocol structs are found by argument-dependent lookup.
+
+// Numbers that do not fit into t are invalid, the conversion would be undefined or wrap around.
+// Integral fields also accept floating-point numbers, which are truncated.
+template<typename Number, typename = std::enable_if_t<std::is_arithmetic_v<Number> && !std::is_same_v<Number, bool>>>
+static bool read(JsonReader& r, const json& j, Number& t) {
+    using Limits = std::numeric_limits<Number>;
+    if (!j.is_number()) {
+        return r.wrongType(j, "a number");
+    }
+    bool inRange = true;
+    if constexpr (std::is_integral_v<Number>) {
+        if (j.is_number_unsigned()) {
+            inRange = j.get_ref<const json::number_unsigned_t&>() <= static_cast<json::number_unsigned_t>(Limits::max());
+        } else if (j.is_number_integer()) {
+            const json::number_integer_t value = j.get_ref<const json::number_integer_t&>();
+            inRange = value < 0
+                ? std::is_signed_v<Number> && value >= static_cast<json::number_integer_t>(Limits::min())
+                : static_cast<json::number_unsigned_t>(value) <= static_cast<json::number_unsigned_t>(Limits::max());
+        } else {
+            const double value = std::trunc(j.get_ref<const json::number_float_t&>());
+            // max() + 1.0 is a power of two, exact in a double unlike max() itself; false for NaN
+            inRange = value >= static_cast<double>(Limits::min()) && value < static_cast<double>(Limits::max()) + 1.0;
+        }
+    } else if (j.is_number_float()) {
+        const double value = j.get_ref<const json::number_float_t&>();
+        inRange = !std::isfinite(value) || std::abs(value) <= static_cast<double>(Limits::max());
+    }
+    if (!inRange) {
+        return r.fail(ParseErrorCode::INVALID_VALUE, "Number out of range: " + j.dump());
+    }
+    t = j.get<Number>();
+    return true;
+}
+
+static bool read(JsonReader& r, const json& j, bool& t) {
+    if (!j.is_boolean()) {
+        return r.wrongType(j, "a boolean");
+    }
+    t = j.get<bool>();
+    return true;
+}
+
+static bool read(JsonReader& r, const json& j, std::pmr::string& t) {
+    if (!j.is_string()) {
+        return r.wrongType(j, "a string");
+    }
+    t = j.get_ref<const json::string_t&>();
+    return true;
+}
+
+// Fills a pmr vector in place, so that every element (and everything the element owns)
+// is allocated from the memory resource of the vector.
+// nlohmann's own array conversion would build a temporary on the default resource and copy it over.
+template<typename T>
+static bool read(JsonReader& r, const json& j, std::pmr::vector<T>& v) {
+    if (!j.is_array()) {
+        return r.wrongType(j, "an array");
+    }
+    v.clear();
+    v.reserve(j.size());
+    for (size_t i = 0; i < j.size(); i++) {
+        if (!read(r, j[i], v.emplace_back())) {
+            return r.failedIn(i);
+        }
+    }
+    return true;
+}
+
+// Width and height, further elements are ignored
+static bool read(JsonReader& r, const json& j, size_t (&t)[2]) {
+    if (!j.is_array()) {
+        return r.wrongType(j, "an array");
+    }
+    if (j.size() < 2) {
+        return r.fail(ParseErrorCode::INVALID_VALUE, "Expected width and height");
+    }
+    return (read(r, j[0], t[0]) || r.failedIn(size_t(0)))
+        && (read(r, j[1], t[1]) || r.failedIn(size_t(1)));
+}
+
+template<typename T>
+bool JsonReader::member(const json& j, const char* key, T& t) {
+    auto it = j.find(key);
+    if (it == j.end()) {
+        fail(ParseErrorCode::MISSING_FIELD, std::string("Missing field ") + key);
+        return failedIn(key);
+    }
+    return read(*this, *it, t) || failedIn(key);
+}
+
+template<typename T>
+bool JsonReader::optionalMember(const json& j, const char* key, T& t) {
+    auto it = j.find(key);
+    if (it == j.end()) {
+        return true;
+    }
+    return read(*this, *it, t) || failedIn(key);
+}
+
+// Reads into t, throws std::runtime_error naming the offending value if j is not a valid T
+template<typename T>
+static void read_or_throw(const json& j, T& t) {
+    JsonReader r;
+    if (!read(r, j, t)) {
+        const ParseError& error = *r.error;
+        throw std::runtime_error(error.path.empty() ? error.message : error.message + " at " + error.path);
+    }
+}
+
+// The string of a json value without copying it, throws json::type_error if it is not a string
+static std::string_view string_view_of(const json& j) {
+    if (!j.is_string()) {
+        // Same error as get<std::string>()
+        throw json::type_error::create(302, "type must be string, but is " + std::string(j.type_name()), &j);
+    }
+    return j.get_ref<const json::string_t&>();
+}
+
+// Names that are not known are read as UNKNOWN
+template<typename Enum>
+static void enum_from_json(const json& j, Enum& t) {
+    if (!tryParse(string_view_of(j), t)) {
+        t = Enum::UNKNOWN;
+    }
+}
+
+// Within the protocol structs, names that are not known are invalid
+template<typename Enum>
+static bool read_enum(JsonReader& r, const json& j, Enum& t, const char* what) {
+    if (!j.is_string()) {
+        return r.wrongType(j, "a string");
+    }
+    const std::string_view name = j.get_ref<const json::string_t&>();
+    return tryParse(name, t) || r.fail(ParseErrorCode::UNKNOWN_ENUM_VALUE, std::string("Unknown ") + what + ": " + std::string(name));
+}
+
+void to_json(json& j, SensorType t) {
+    j = toString(t);
+}
+
+void from_json(const json& j, SensorType& t) {
+    enum_from_json(j, t);
+}
+
+static bool read(JsonReader& r, const json& j, SensorType& t) {
+    return read_enum(r, j, t, "sensor type");
+}
+
+void to_json(json& j, ImageFormat t) {
+    j = toString(t);
+}
+
+void from_json(const json& j, ImageFormat& t) {
+    enum_from_json(j, t);
+}
+
+static bool read(JsonReader& r, const json& j, ImageFormat& t) {
+    return read_enum(r, j, t, "image format");
+}
+
+void to_json(json& j, CameraModel t) {
+    j = toString(t);
+}
+
+void from_json(const json& j, CameraModel& t) {
+    enum_from_json(j, t);
+}
+
+static bool read(JsonReader& r, const json& j, CameraModel& t) {
+    return read_enum(r, j, t, "camera model");
+}
+
+// geopose_json.h reads these with exceptions
+static bool read(JsonReader& r, const json& j, Position& t) {
+    return r.object(j)
+        && r.member(j, "lat", t.lat)
+        && r.member(j, "lon", t.lon)
+        && r.member(j, "h", t.h);
+}
+
+static bool read(JsonReader& r, const json& j, Quaternion& t) {
+    return r.object(j)
+        && r.member(j, "x", t.x)
+        && r.member(j, "y", t.y)
+        && r.member(j, "z", t.z)
+        && r.member(j, "w", t.w);
+}
+
+static bool read(JsonReader& r, const json& j, GeoPose& t) {
+    return r.object(j)
+        && r.member(j, "quaternion", t.quaternion)
+        && r.member(j, "position", t.position);
+}
+
+void to_json(json& j, const Privacy& t) {
+    j = json{
+        {"dataRetention", t.dataRetention},
+        {"dataAcceptableUse", t.dataAcceptableUse},
+        {"dataSanitizationApplied", t.dataSanitizationApplied},
+        {"dataSanitizationRequested", t.dataSanitizationRequested}
+    };
+}
+
+static bool read(JsonReader& r, const json& j, Privacy& t) {
+    return r.object(j)
+        && r.member(j, "dataRetention", t.dataRetention)
+        && r.member(j, "dataAcceptableUse", t.dataAcceptableUse)
+        && r.member(j, "dataSanitizationApplied", t.dataSanitizationApplied)
+        && r.member(j, "dataSanitizationRequested", t.dataSanitizationRequested);
+}
+
+void from_json(const json& j, Privacy& t) {
+    read_or_throw(j, t);
+}
+
+// A reading privacy that equals the request-level default is not materialized, the reading inherits it instead.
+// This way the policy strings are allocated only once per request.
+static bool read_privacy_of(JsonReader& r, const json& j, std::optional<Privacy>& privacy, const allocator_type& alloc) {
+    privacy.reset();
+    auto it = j.find("privacy");
+    if (it == j.end()) {
+        return true;
+    }
+    if (r.defaultPrivacy != nullptr && *it == *r.defaultPrivacy) {
+        return true;
+    }
+    privacy.emplace(alloc);
+    return read(r, *it, *privacy) || r.failedIn("privacy");
+}
+
+static bool read_base(JsonReader& r, const json& j, BaseSensorReading& t) {
+    return r.object(j)
+        && r.member(j, "timestamp", t.timestamp)
+        && r.member(j, "sensorId", t.sensorId)
+        && read_privacy_of(r, j, t.privacy, t.sensorId.get_allocator());
+}
+
+static void base_to_json(json& j, const BaseSensorReading& t) {
+    j["timestamp"] = t.timestamp;
+    j["sensorId"] = t.sensorId;
+    if (t.privacy.has_value()) {
+        j["privacy"] = *t.privacy;
+    }
+}
+
 void to_json(json& j, const Vector3& v) {
     j = json{
         {"x", v.x},
@@ -22,10 +321,15 @@ void to_json(json& j, const Vector3& v) {
     };
 }
 
+static bool read(JsonReader& r, const json& j, Vector3& v) {
+    return r.object(j)
+        && r.member(j, "x", v.x)
+        && r.member(j, "y", v.y)
+        && r.member(j, "z", v.z);
+}
+
 void from_json(const json& j, Vector3& v) {
-    j.at("x").get_to(v.x);
-    j.at("y").get_to(v.y);
-    j.at("z").get_to(v.z);
+    read_or_throw(j, v);
 }
 
 void to_json(json& j, const ImageOrientation& t) {
@@ -35,9 +339,14 @@ void to_json(json& j, const ImageOrientation& t) {
     };
 }
 
+static bool read(JsonReader& r, const json& j, ImageOrientation& t) {
+    return r.object(j)
+        && r.member(j, "mirrored", t.mirrored)
+        && r.member(j, "rotation", t.rotation);
+}
+
 void from_json(const json& j, ImageOrientation& t) {
-    j.at("mirrored").get_to(t.mirrored);
-    j.at("rotation").get_to(t.rotation);
+    read_or_throw(j, t);
 }
 
 void to_json(json& j, const CameraParameters& t) {
@@ -48,49 +357,30 @@ void to_json(json& j, const CameraParameters& t) {
         j["modelParams"] = t.modelParams;
     }
     if (!t.minMaxDepth.empty()) {
-        j["minMaxDepth"], t.minMaxDepth;
+        j["minMaxDepth"] = t.minMaxDepth;
     }
     if (!t.minMaxDisparity.empty()) {
-        j["minMaxDisparity"], t.minMaxDisparity;
+        j["minMaxDisparity"] = t.minMaxDisparity;
     }
 }
 
-void from_json(const json& j, CameraParameters& t) {
-    if (j.find("model") != j.end()) {
-        t.model = cameraModelFromString(j.at("model"));
-    }
-    if (j.find("modelParams") != j.end()) {
-        j.at("modelParams").get_to(t.modelParams);
+static bool read(JsonReader& r, const json& j, CameraParameters& t) {
+    if (j.is_null()) {
+        return true; // to_json of CameraParameters without any value
     }
-    if (j.find("minMaxDepth") != j.end()) {
-        j.at("minMaxDepth").get_to(t.minMaxDepth);
-    }
-    if (j.find("minMaxDisparity") != j.end()) {
-        j.at("minMaxDisparity").get_to(t.minMaxDisparity);
-    }
-}
-
-void to_json(json& j, const Privacy& t) {
-    j = json{
-        {"dataRetention", t.dataRetention},
-        {"dataAcceptableUse", t.dataAcceptableUse},
-        {"dataSanitizationApplied", t.dataSanitizationApplied},
-        {"dataSanitizationRequested", t.dataSanitizationRequested}
-    };
+    return r.object(j)
+        && r.optionalMember(j, "model", t.model)
+        && r.optionalMember(j, "modelParams", t.modelParams)
+        && r.optionalMember(j, "minMaxDepth", t.minMaxDepth)
+        && r.optionalMember(j, "minMaxDisparity", t.minMaxDisparity);
 }
 
-void from_json(const json& j, Privacy& t) {
-    j.at("dataRetention").get_to(t.dataRetention);
-    j.at("dataAcceptableUse").get_to(t.dataAcceptableUse);
-    j.at("dataSanitizationApplied").get_to(t.dataSanitizationApplied);
-    j.at("dataSanitizationRequested").get_to(t.dataSanitizationRequested);
+void from_json(const json& j, CameraParameters& t) {
+    read_or_throw(j, t);
 }
 
 void to_json(json& j, const CameraReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
-        {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
         {"sequenceNumber", t.sequenceNumber},
         {"imageFormat", t.imageFormat},
         {"size", t.size},
@@ -98,29 +388,21 @@ void to_json(json& j, const CameraReading& t) {
         {"imageOrientation", t.imageOrientation},
         {"params", t.params},
     };
+    base_to_json(j, t);
 }
 
-void from_json(const json& j, CameraReading& t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("sequenceNumber").get_to(t.sequenceNumber);
-    t.imageFormat = imageFormatFromString(j.at("imageFormat"));
-    j.at("size").get_to(t.size);
-    j.at("imageBytes").get_to(t.imageBytes);
-    if (j.find("imageOrientation") != j.end()) {
-        j.at("imageOrientation").get_to(t.imageOrientation);
-    }
-    if (j.find("params") != j.end()) {
-        j.at("params").get_to(t.params);
-    }
+static bool read(JsonReader& r, const json& j, CameraReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "sequenceNumber", t.sequenceNumber)
+        && r.member(j, "imageFormat", t.imageFormat)
+        && r.member(j, "size", t.size)
+        && r.member(j, "imageBytes", t.imageBytes)
+        && r.optionalMember(j, "imageOrientation", t.imageOrientation)
+        && r.optionalMember(j, "params", t.params);
 }
 
 void to_json(json& j, const GeolocationReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
-        {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
         {"latitude", t.latitude},
         {"longitude", t.longitude},
         {"altitude", t.altitude},
@@ -129,36 +411,22 @@ void to_json(json& j, const GeolocationReading& t) {
         {"heading", t.heading},
         {"speed", t.speed}
     };
+    base_to_json(j, t);
 }
 
-void from_json(const json& j, GeolocationReading& t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("latitude").get_to(t.latitude);
-    j.at("longitude").get_to(t.longitude);
-    if (j.find("altitude") != j.end()) {
-        j.at("altitude").get_to(t.altitude);
-    }
-    if (j.find("accuracy") != j.end()) {
-        j.at("accuracy").get_to(t.accuracy);
-    }
-    if (j.find("altitudeAccuracy") != j.end()) {
-        j.at("altitudeAccuracy").get_to(t.altitudeAccuracy);
-    }
-    if (j.find("heading") != j.end()) {
-        j.at("heading").get_to(t.heading);
-    }
-    if (j.find("speed") != j.end()) {
-        j.at("speed").get_to(t.speed);
-    }
+static bool read(JsonReader& r, const json& j, GeolocationReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "latitude", t.latitude)
+        && r.member(j, "longitude", t.longitude)
+        && r.optionalMember(j, "altitude", t.altitude)
+        && r.optionalMember(j, "accuracy", t.accuracy)
+        && r.optionalMember(j, "altitudeAccuracy", t.altitudeAccuracy)
+        && r.optionalMember(j, "heading", t.heading)
+        && r.optionalMember(j, "speed", t.speed);
 }
 
 void to_json(json& j, const WiFiReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
-        {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
         {"BSSID", t.BSSID},
         {"frequency", t.frequency},
         {"RSSI", t.RSSI},
@@ -166,98 +434,110 @@ void to_json(json& j, const WiFiReading& t) {
         {"scanTimeStart", t.scanTimeStart},
         {"scanTimeEnd", t.scanTimeEnd},
     };
+    base_to_json(j, t);
 }
 
-void from_json(const json& j, WiFiReading& t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("BSSID").get_to(t.BSSID);
-    j.at("frequency").get_to(t.frequency);
-    j.at("RSSI").get_to(t.RSSI);
-    j.at("SSID").get_to(t.SSID);
-    j.at("scanTimeStart").get_to(t.scanTimeStart);
-    j.at("scanTimeEnd").get_to(t.scanTimeEnd);
+static bool read(JsonReader& r, const json& j, WiFiReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "BSSID", t.BSSID)
+        && r.member(j, "frequency", t.frequency)
+        && r.member(j, "RSSI", t.RSSI)
+        && r.member(j, "SSID", t.SSID)
+        && r.member(j, "scanTimeStart", t.scanTimeStart)
+        && r.member(j, "scanTimeEnd", t.scanTimeEnd);
 }
 
 void to_json(json& j, const BluetoothReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
-        {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
         {"address", t.address},
         {"RSSI", t.RSSI},
         {"name", t.name},
     };
+    base_to_json(j, t);
 }
 
-void from_json(const json& j, BluetoothReading& t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("address").get_to(t.address);
-    j.at("RSSI").get_to(t.RSSI);
-    j.at("name").get_to(t.name);
+static bool read(JsonReader& r, const json& j, BluetoothReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "address", t.address)
+        && r.member(j, "RSSI", t.RSSI)
+        && r.member(j, "name", t.name);
 }
 
 void to_json(json& j, const AccelerometerReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
-        {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
         {"x", t.x},
         {"y", t.y},
         {"z", t.z}
     };
+    base_to_json(j, t);
 }
 
-void from_json(const json& j, AccelerometerReading& t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("x").get_to(t.x);
-    j.at("y").get_to(t.y);
-    j.at("z").get_to(t.z);
+static bool read(JsonReader& r, const json& j, AccelerometerReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "x", t.x)
+        && r.member(j, "y", t.y)
+        && r.member(j, "z", t.z);
 }
 
 void to_json(json& j, const GyroscopeReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
-        {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
         {"x", t.x},
         {"y", t.y},
         {"z", t.z}
     };
+    base_to_json(j, t);
 }
 
-void from_json(const json &j, GyroscopeReading &t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("x").get_to(t.x);
-    j.at("y").get_to(t.y);
-    j.at("z").get_to(t.z);
+static bool read(JsonReader& r, const json& j, GyroscopeReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "x", t.x)
+        && r.member(j, "y", t.y)
+        && r.member(j, "z", t.z);
 }
 
 void to_json(json& j, const MagnetometerReading& t) {
     j = json{
-        {"timestamp", t.timestamp},
+        {"x", t.x},
+        {"y", t.y},
+        {"z", t.z}
+    };
+    base_to_json(j, t);
+}
+
+static bool read(JsonReader& r, const json& j, MagnetometerReading& t) {
+    return read_base(r, j, t)
+        && r.member(j, "x", t.x)
+        && r.member(j, "y", t.y)
+        && r.member(j, "z", t.z);
+}
+
+void to_json(json& j, const ImuReadingBlock& t) {
+    j = json{
         {"sensorId", t.sensorId},
-        {"privacy", t.privacy},
+        {"timestamps", t.timestamps},
         {"x", t.x},
         {"y", t.y},
         {"z", t.z}
     };
+    if (t.privacy.has_value()) {
+        j["privacy"] = *t.privacy;
+    }
 }
 
-void from_json(const json& j, MagnetometerReading& t) {
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensorId").get_to(t.sensorId);
-    j.at("privacy").get_to(t.privacy);
-    j.at("x").get_to(t.x);
-    j.at("y").get_to(t.y);
-    j.at("z").get_to(t.z);
+static bool read(JsonReader& r, const json& j, ImuReadingBlock& t) {
+    if (!(r.object(j)
+        && r.member(j, "sensorId", t.sensorId)
+        && read_privacy_of(r, j, t.privacy, t.sensorId.get_allocator())
+        && r.member(j, "timestamps", t.timestamps)
+        && r.member(j, "x", t.x)
+        && r.member(j, "y", t.y)
+        && r.member(j, "z", t.z))) {
+        return false;
+    }
+    if (t.x.size() != t.size() || t.y.size() != t.size() || t.z.size() != t.size()) {
+        return r.fail(ParseErrorCode::INVALID_VALUE, "The arrays of the IMU reading block of sensor " + std::string(t.sensorId) + " differ in length");
+    }
+    return true;
 }
 
 void to_json(json& j, const Sensor& t) {
@@ -278,28 +558,23 @@ void to_json(json& j, const Sensor& t) {
     }
 }
 
+static bool read(JsonReader& r, const json& j, Sensor& t) {
+    return r.object(j)
+        && r.member(j, "type", t.type)
+        && r.member(j, "id", t.id)
+        && r.optionalMember(j, "name", t.name)
+        && r.optionalMember(j, "model", t.model)
+        && r.optionalMember(j, "rigIdentifier", t.rigIdentifier)
+        && r.optionalMember(j, "rigRotation", t.rigRotation)
+        && r.optionalMember(j, "rigTranslation", t.rigTranslation);
+}
+
 void from_json(const json& j, Sensor& t) {
-    t.type = sensorTypefromString(j.at("type"));
-    j.at("id").get_to(t.id);
-    if (j.find("name") != j.end()) {
-        j.at("name").get_to(t.name);
-    }
-    if (j.find("model") != j.end()) {
-        j.at("model").get_to(t.model);
-    }
-    if (j.find("rigIdentifier") != j.end()) {
-        j.at("rigIdentifier").get_to(t.rigIdentifier);
-    }
-    if (j.find("rigRotation") != j.end()) {
-        j.at("rigRotation").get_to(t.rigRotation);
-    }
-    if (j.find("rigTranslation") != j.end()) {
-        j.at("rigTranslation").get_to(t.rigTranslation);
-    }
+    read_or_throw(j, t);
 }
 
 void to_json(json& j, const SensorReadings& t) {
-    j = json{};
+    j = json::object(); // json{} is null, which the reader rejects when there are no readings at all
     if (!t.cameraReadings.empty())
         j["cameraReadings"] = t.cameraReadings;
     if (!t.geolocationReadings.empty())
@@ -314,30 +589,62 @@ void to_json(json& j, const SensorReadings& t) {
         j["gyroscopeReadings"] = t.gyroscopeReadings;
     if (!t.magnetometerReadings.empty())
         j["magnetometerReadings"] = t.magnetometerReadings;
+    if (!t.accelerometerBlocks.empty())
+        j["accelerometerBlocks"] = t.accelerometerBlocks;
+    if (!t.gyroscopeBlocks.empty())
+        j["gyroscopeBlocks"] = t.gyroscopeBlocks;
+    if (!t.magnetometerBlocks.empty())
+        j["magnetometerBlocks"] = t.magnetometerBlocks;
+}
+
+static bool read(JsonReader& r, const json& j, SensorReadings& t) {
+    return r.object(j)
+        && r.optionalMember(j, "cameraReadings", t.cameraReadings)
+        && r.optionalMember(j, "geolocationReadings", t.geolocationReadings)
+        && r.optionalMember(j, "wifiReadings", t.wifiReadings)
+        && r.optionalMember(j, "bluetoothReadings", t.bluetoothReadings)
+        && r.optionalMember(j, "accelerometerReadings", t.accelerometerReadings)
+        && r.optionalMember(j, "gyroscopeReadings", t.gyroscopeReadings)
+        && r.optionalMember(j, "magnetometerReadings", t.magnetometerReadings)
+        && r.optionalMember(j, "accelerometerBlocks", t.accelerometerBlocks)
+        && r.optionalMember(j, "gyroscopeBlocks", t.gyroscopeBlocks)
+        && r.optionalMember(j, "magnetometerBlocks", t.magnetometerBlocks);
+}
+
+void from_json(const json& j, CameraReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, GeolocationReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, WiFiReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, BluetoothReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, AccelerometerReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, GyroscopeReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, MagnetometerReading& t) {
+    read_or_throw(j, t);
+}
+
+void from_json(const json& j, ImuReadingBlock& t) {
+    read_or_throw(j, t);
 }
 
 void from_json(const json& j, SensorReadings& t) {
-    if (j.find("cameraReadings") != j.end()) {
-        j.at("cameraReadings").get_to(t.cameraReadings);
-    }
-    if (j.find("geolocationReadings") != j.end()) {
-        j.at("geolocationReadings").get_to(t.geolocationReadings);
-    }
-    if (j.find("wifiReadings") != j.end()) {
-        j.at("wifiReadings").get_to(t.wifiReadings);
-    }
-    if (j.find("bluetoothReadings") != j.end()) {
-        j.at("bluetoothReadings").get_to(t.bluetoothReadings);
-    }
-    if (j.find("accelerometerReadings") != j.end()) {
-        j.at("accelerometerReadings").get_to(t.accelerometerReadings);
-    }
-    if (j.find("gyroscopeReadings") != j.end()) {
-        j.at("gyroscopeReadings").get_to(t.gyroscopeReadings);
-    }
-    if (j.find("magnetometerReadings") != j.end()) {
-        j.at("magnetometerReadings").get_to(t.magnetometerReadings);
-    }
+    read_or_throw(j, t);
 }
 
 void to_json(json& j, const GeoPoseAccuracy& t) {
@@ -347,9 +654,14 @@ void to_json(json& j, const GeoPoseAccuracy& t) {
     };
 }
 
+static bool read(JsonReader& r, const json& j, GeoPoseAccuracy& t) {
+    return r.object(j)
+        && r.member(j, "position", t.position)
+        && r.member(j, "orientation", t.orientation);
+}
+
 void from_json(const json& j, GeoPoseAccuracy& t) {
-    j.at("position").get_to(t.position);
-    j.at("orientation").get_to(t.orientation);
+    read_or_throw(j, t);
 }
 
 void to_json(json& j, const GeoPoseResponse& t) {
@@ -362,12 +674,17 @@ void to_json(json& j, const GeoPoseResponse& t) {
     };
 }
 
+static bool read(JsonReader& r, const json& j, GeoPoseResponse& t) {
+    return r.object(j)
+        && r.member(j, "type", t.type)
+        && r.member(j, "id", t.id)
+        && r.member(j, "timestamp", t.timestamp)
+        && r.member(j, "accuracy", t.accuracy)
+        && r.member(j, "geopose", t.geopose);
+}
+
 void from_json(const json& j, GeoPoseResponse& t) {
-    j.at("type").get_to(t.type);
-    j.at("id").get_to(t.id);
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("accuracy").get_to(t.accuracy);
-    j.at("geopose").get_to(t.geopose);
+    read_or_throw(j, t);
 }
 
 void to_json(json& j, const GeoPoseRequest& t) {
@@ -375,23 +692,234 @@ void to_json(json& j, const GeoPoseRequest& t) {
         {"type", t.type},
         {"id", t.id},
         {"timestamp", t.timestamp},
-        {"sensors", t.sensors},
         {"sensorReadings", t.sensorReadings},
     };
+    // Servers that predate the request-level default require the privacy of every reading, so the inherited one is written out.
+    // Readers of the default parse the copies that equal it as inheriting it.
+    const json inheritedPrivacy = t.privacy.has_value() ? json(*t.privacy) : json(Privacy());
+    for (json& readings : j["sensorReadings"]) {
+        for (json& reading : readings) {
+            if (reading.find("privacy") == reading.end()) {
+                reading["privacy"] = inheritedPrivacy;
+            }
+        }
+    }
+    if (!t.sensors.empty() || t.sensorsToken.empty()) {
+        j["sensors"] = t.sensors;
+    }
+    if (!t.sensorsToken.empty()) {
+        j["sensorsToken"] = t.sensorsToken;
+    }
+    if (t.privacy.has_value()) {
+        j["privacy"] = *t.privacy;
+    }
     if (!t.priorPoses.empty()) {
         j["priorPoses"] = t.priorPoses;
     }
 }
 
+// Everything of a GeoPoseRequest except its sensors and the sensor index
+static bool read_request_body(JsonReader& r, const json& j, GeoPoseRequest& t) {
+    if (!(r.object(j)
+        && r.member(j, "type", t.type)
+        && r.member(j, "id", t.id)
+        && r.member(j, "timestamp", t.timestamp))) {
+        return false;
+    }
+    r.defaultPrivacy = nullptr;
+    t.privacy.reset();
+    auto privacy = j.find("privacy");
+    if (privacy != j.end()) {
+        t.privacy.emplace(t.id.get_allocator());
+        if (!read(r, *privacy, *t.privacy)) {
+            return r.failedIn("privacy");
+        }
+        r.defaultPrivacy = &*privacy;
+    }
+    t.sensorsToken.clear();
+    if (!(r.member(j, "sensorReadings", t.sensorReadings)
+        && r.optionalMember(j, "priorPoses", t.priorPoses)
+        && r.optionalMember(j, "sensorsToken", t.sensorsToken))) {
+        return false;
+    }
+    // An empty token would make a request without sensors that cannot be resolved, nor written back
+    if (t.sensorsToken.empty() && j.find("sensorsToken") != j.end()) {
+        r.fail(ParseErrorCode::INVALID_VALUE, "The sensorsToken is empty");
+        return r.failedIn("sensorsToken");
+    }
+    return true;
+}
+
+// A request with a sensorsToken may leave out its sensors, it is then read without them and without indexing
+static bool has_sensors(const json& j) {
+    return j.find("sensors") != j.end() || j.find("sensorsToken") == j.end();
+}
+
+static bool read(JsonReader& r, const json& j, GeoPoseRequest& t) {
+    if (!r.object(j)) {
+        return false;
+    }
+    if (!has_sensors(j)) {
+        t.sensors.clear();
+    } else if (!r.member(j, "sensors", t.sensors)) {
+        return false;
+    }
+    return read_request_body(r, j, t);
+}
+
 void from_json(const json& j, GeoPoseRequest& t) {
-    j.at("type").get_to(t.type);
-    j.at("id").get_to(t.id);
-    j.at("timestamp").get_to(t.timestamp);
-    j.at("sensors").get_to(t.sensors);
-    j.at("sensorReadings").get_to(t.sensorReadings);
-    if (j.find("priorPoses") != j.end()) {
-        j.at("priorPoses").get_to(t.priorPoses);
+    read_or_throw(j, t);
+    if (has_sensors(j)) {
+        indexSensors(t);
+    }
+}
+
+GeoPoseRequest parseGeoPoseRequest(const json& j, std::pmr::memory_resource* resource) {
+    GeoPoseRequest t{GeoPoseRequest::allocator_type(resource)};
+    from_json(j, t);
+    return t;
+}
+
+void to_json(json& j, const SessionCamera& t) {
+    j = json{
+        {"sensorId", t.sensorId},
+        {"params", t.params}
+    };
+}
+
+static bool read(JsonReader& r, const json& j, SessionCamera& t) {
+    return r.object(j)
+        && r.member(j, "sensorId", t.sensorId)
+        && r.member(j, "params", t.params);
+}
+
+void from_json(const json& j, SessionCamera& t) {
+    read_or_throw(j, t);
+}
+
+void to_json(json& j, const GeoPoseSession& t) {
+    j = json{
+        {"type", t.type},
+        {"sensors", t.sensors}
+    };
+    if (t.privacy.has_value()) {
+        j["privacy"] = *t.privacy;
+    }
+    if (!t.cameras.empty()) {
+        j["cameras"] = t.cameras;
+    }
+}
+
+static bool read(JsonReader& r, const json& j, GeoPoseSession& t) {
+    if (!(r.object(j)
+        && r.member(j, "type", t.type)
+        && r.member(j, "sensors", t.sensors))) {
+        return false;
+    }
+    t.privacy.reset();
+    auto privacy = j.find("privacy");
+    if (privacy != j.end()) {
+        t.privacy.emplace(t.type.get_allocator());
+        if (!read(r, *privacy, *t.privacy)) {
+            return r.failedIn("privacy");
+        }
+    }
+    t.cameras.clear();
+    return r.optionalMember(j, "cameras", t.cameras);
+}
+
+void from_json(const json& j, GeoPoseSession& t) {
+    read_or_throw(j, t);
+    validateSession(t);
+}
+
+GeoPoseRequest parseGeoPoseFrame(const json& j, const GeoPoseSession& session, std::pmr::memory_resource* resource) {
+    GeoPoseRequest t{GeoPoseRequest::allocator_type(resource)};
+    JsonReader r;
+    if (!read_request_body(r, j, t)) {
+        const ParseError& error = *r.error;
+        throw std::runtime_error(error.path.empty() ? error.message : error.message + " at " + error.path);
+    }
+    resolveSensors(t, session);
+    return t;
+}
+
+namespace {
+// Only remembers where and why parsing failed, for the second pass over a document json::parse() rejected
+class ParseErrorLocator : public json::json_sax_t {
+public:
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool string(string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+    bool start_object(std::size_t) override { return true; }
+    bool key(string_t&) override { return true; }
+    bool end_object() override { return true; }
+    bool start_array(std::size_t) override { return true; }
+    bool end_array() override { return true; }
+
+    bool parse_error(std::size_t position, const std::string& /*lastToken*/, const json::exception& ex) override {
+        error = ParseError(ParseErrorCode::INVALID_JSON, "", "Byte " + std::to_string(position) + ": " + ex.what());
+        return false;
+    }
+
+    std::optional<ParseError> error;
+};
+} // namespace
+
+// Valid documents are parsed once without exceptions, only invalid ones pay for the second pass that locates the error
+ParseResult<json> tryParseJson(std::string_view text) {
+    json j = json::parse(text.begin(), text.end(), nullptr, false);
+    if (!j.is_discarded()) {
+        return j;
+    }
+    ParseErrorLocator locator;
+    json::sax_parse(text.begin(), text.end(), &locator);
+    if (!locator.error.has_value()) {
+        return ParseError(ParseErrorCode::INVALID_JSON, "", "Invalid JSON");
+    }
+    return std::move(*locator.error);
+}
+
+ParseResult<GeoPoseRequest> tryParseGeoPoseRequest(const json& j, std::pmr::memory_resource* resource) {
+    GeoPoseRequest t{GeoPoseRequest::allocator_type(resource)};
+    JsonReader r;
+    if (!read(r, j, t)) {
+        return std::move(*r.error);
+    }
+    if (has_sensors(j)) {
+        if (std::optional<ParseError> error = tryIndexSensors(t)) {
+            return std::move(*error);
+        }
+    }
+    return t;
+}
+
+ParseResult<GeoPoseRequest> tryParseGeoPoseFrame(const json& j, const GeoPoseSession& session, std::pmr::memory_resource* resource) {
+    GeoPoseRequest t{GeoPoseRequest::allocator_type(resource)};
+    JsonReader r;
+    if (!read_request_body(r, j, t)) {
+        return std::move(*r.error);
+    }
+    if (std::optional<ParseError> error = tryResolveSensors(t, session)) {
+        return std::move(*error);
+    }
+    return t;
+}
+
+ParseResult<GeoPoseSession> tryParseGeoPoseSession(const json& j) {
+    GeoPoseSession t;
+    JsonReader r;
+    if (!read(r, j, t)) {
+        return std::move(*r.error);
+    }
+    if (std::optional<ParseError> error = tryValidateSession(t)) {
+        return std::move(*error);
     }
+    return t;
 }
 
 } // namespace oscp
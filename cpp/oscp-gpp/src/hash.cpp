@@ -0,0 +1,168 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/hash.h>
+
+#include <cstring>
+
+namespace oscp {
+
+static const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t prime3 = 0x165667B19E3779F9ULL;
+static const uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// Little-endian loads, independent of alignment
+static inline uint64_t read64(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline uint64_t accumulate(uint64_t accumulator, uint64_t input) {
+    accumulator += input * prime2;
+    accumulator = rotl(accumulator, 31);
+    return accumulator * prime1;
+}
+
+static inline uint64_t mergeRound(uint64_t hash, uint64_t accumulator) {
+    hash ^= accumulate(0, accumulator);
+    return hash * prime1 + prime4;
+}
+
+// Consumes the trailing bytes (fewer than 32) and mixes the final hash
+static uint64_t finalize(uint64_t hash, const unsigned char* p, size_t size) {
+    while (size >= 8) {
+        hash ^= accumulate(0, read64(p));
+        hash = rotl(hash, 27) * prime1 + prime4;
+        p += 8;
+        size -= 8;
+    }
+    if (size >= 4) {
+        hash ^= static_cast<uint64_t>(read32(p)) * prime1;
+        hash = rotl(hash, 23) * prime2 + prime3;
+        p += 4;
+        size -= 4;
+    }
+    while (size > 0) {
+        hash ^= (*p) * prime5;
+        hash = rotl(hash, 11) * prime1;
+        p++;
+        size--;
+    }
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static inline uint64_t convergeAccumulators(const uint64_t accumulators[4]) {
+    uint64_t hash = rotl(accumulators[0], 1) + rotl(accumulators[1], 7) + rotl(accumulators[2], 12) + rotl(accumulators[3], 18);
+    hash = mergeRound(hash, accumulators[0]);
+    hash = mergeRound(hash, accumulators[1]);
+    hash = mergeRound(hash, accumulators[2]);
+    hash = mergeRound(hash, accumulators[3]);
+    return hash;
+}
+
+uint64_t xxh64(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+    uint64_t hash;
+    if (size >= 32) {
+        uint64_t accumulators[4] = {seed + prime1 + prime2, seed + prime2, seed, seed - prime1};
+        const unsigned char* const limit = end - 32;
+        do {
+            accumulators[0] = accumulate(accumulators[0], read64(p));
+            accumulators[1] = accumulate(accumulators[1], read64(p + 8));
+            accumulators[2] = accumulate(accumulators[2], read64(p + 16));
+            accumulators[3] = accumulate(accumulators[3], read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        hash = convergeAccumulators(accumulators);
+    } else {
+        hash = seed + prime5;
+    }
+    hash += static_cast<uint64_t>(size);
+    return finalize(hash, p, static_cast<size_t>(end - p));
+}
+
+Xxh64::Xxh64(uint64_t seed)
+    : accumulators_{seed + prime1 + prime2, seed + prime2, seed, seed - prime1}, seed_(seed) {
+}
+
+void Xxh64::update(const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    totalSize_ += size;
+
+    if (bufferSize_ + size < 32) {
+        if (size > 0) {
+            std::memcpy(buffer_ + bufferSize_, p, size);
+        }
+        bufferSize_ += size;
+        return;
+    }
+
+    if (bufferSize_ > 0) {
+        const size_t fill = 32 - bufferSize_;
+        std::memcpy(buffer_ + bufferSize_, p, fill);
+        accumulators_[0] = accumulate(accumulators_[0], read64(buffer_));
+        accumulators_[1] = accumulate(accumulators_[1], read64(buffer_ + 8));
+        accumulators_[2] = accumulate(accumulators_[2], read64(buffer_ + 16));
+        accumulators_[3] = accumulate(accumulators_[3], read64(buffer_ + 24));
+        p += fill;
+        size -= fill;
+        bufferSize_ = 0;
+    }
+
+    while (size >= 32) {
+        accumulators_[0] = accumulate(accumulators_[0], read64(p));
+        accumulators_[1] = accumulate(accumulators_[1], read64(p + 8));
+        accumulators_[2] = accumulate(accumulators_[2], read64(p + 16));
+        accumulators_[3] = accumulate(accumulators_[3], read64(p + 24));
+        p += 32;
+        size -= 32;
+    }
+
+    if (size > 0) {
+        std::memcpy(buffer_, p, size);
+        bufferSize_ = size;
+    }
+}
+
+uint64_t Xxh64::digest() const {
+    uint64_t hash;
+    if (totalSize_ >= 32) {
+        hash = convergeAccumulators(accumulators_);
+    } else {
+        hash = seed_ + prime5;
+    }
+    hash += totalSize_;
+    return finalize(hash, buffer_, bufferSize_);
+}
+
+} // namespace oscp
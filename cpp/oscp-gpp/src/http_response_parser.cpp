@@ -0,0 +1,195 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/http_response_parser.h>
+
+#include <cstdlib>
+
+namespace oscp {
+
+namespace {
+
+constexpr size_t maxHeaderBytes = 64 * 1024;
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        const char ca = (a[i] >= 'A' && a[i] <= 'Z') ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+        const char cb = (b[i] >= 'A' && b[i] <= 'Z') ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+        if (ca != cb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool isHexDigit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+} // namespace
+
+HttpResponseParser::HttpResponseParser(size_t maxBodyBytes) : maxBodyBytes_(maxBodyBytes) {
+}
+
+void HttpResponseParser::reset(bool headRequest) {
+    buffer_.clear();
+    headerEnd_ = 0;
+    chunkOffset_ = 0;
+    framing_ = Framing::LENGTH;
+    contentLength_ = 0;
+    headRequest_ = headRequest;
+    keepAlive_ = true;
+    response_ = HttpResponse();
+}
+
+HttpParseStatus HttpResponseParser::append(const char* data, size_t size) {
+    buffer_.append(data, size);
+    if (headerEnd_ == 0) {
+        const size_t end = buffer_.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            return buffer_.size() > maxHeaderBytes ? HttpParseStatus::TOO_LARGE : HttpParseStatus::INCOMPLETE;
+        }
+        headerEnd_ = end + 4;
+        if (!parseHeaders(std::string_view(buffer_).substr(0, end))) {
+            return HttpParseStatus::INVALID;
+        }
+        if (framing_ == Framing::LENGTH && contentLength_ > maxBodyBytes_) {
+            return HttpParseStatus::TOO_LARGE;
+        }
+        chunkOffset_ = headerEnd_;
+    }
+    switch (framing_) {
+    case Framing::LENGTH:
+        if (buffer_.size() < headerEnd_ + contentLength_) {
+            return HttpParseStatus::INCOMPLETE;
+        }
+        if (buffer_.size() > headerEnd_ + contentLength_) {
+            keepAlive_ = false; // bytes nobody asked for
+        }
+        response_.body.assign(buffer_, headerEnd_, contentLength_);
+        return HttpParseStatus::COMPLETE;
+    case Framing::CHUNKED:
+        return parseChunks();
+    case Framing::UNTIL_CLOSE:
+        return buffer_.size() - headerEnd_ > maxBodyBytes_ ? HttpParseStatus::TOO_LARGE : HttpParseStatus::INCOMPLETE;
+    }
+    return HttpParseStatus::INVALID;
+}
+
+HttpParseStatus HttpResponseParser::close() {
+    if (headerEnd_ == 0 || framing_ != Framing::UNTIL_CLOSE) {
+        return HttpParseStatus::INVALID;
+    }
+    response_.body.assign(buffer_, headerEnd_, std::string::npos);
+    return HttpParseStatus::COMPLETE;
+}
+
+bool HttpResponseParser::parseHeaders(std::string_view headers) {
+    size_t lineEnd = headers.find("\r\n");
+    const std::string_view statusLine = headers.substr(0, lineEnd);
+    // "HTTP/1.1 200 OK"
+    if (statusLine.size() < 12 || statusLine.compare(0, 7, "HTTP/1.") != 0 || statusLine[8] != ' ') {
+        return false;
+    }
+    for (size_t i = 9; i < 12; i++) {
+        if (statusLine[i] < '0' || statusLine[i] > '9') {
+            return false;
+        }
+        response_.httpStatus = response_.httpStatus * 10 + (statusLine[i] - '0');
+    }
+    keepAlive_ = statusLine[7] == '1';
+
+    bool hasLength = false;
+    while (lineEnd != std::string_view::npos) {
+        const size_t lineStart = lineEnd + 2;
+        lineEnd = headers.find("\r\n", lineStart);
+        const std::string_view line = headers.substr(lineStart, lineEnd == std::string_view::npos ? std::string_view::npos : lineEnd - lineStart);
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            return false;
+        }
+        const std::string_view name = trim(line.substr(0, colon));
+        const std::string_view value = trim(line.substr(colon + 1));
+        if (equalsIgnoreCase(name, "Content-Length")) {
+            char* end = nullptr;
+            const std::string digits(value);
+            contentLength_ = std::strtoull(digits.c_str(), &end, 10);
+            if (digits.empty() || *end != '\0') {
+                return false;
+            }
+            hasLength = true;
+        } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+            framing_ = equalsIgnoreCase(value, "chunked") ? Framing::CHUNKED : Framing::UNTIL_CLOSE;
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            keepAlive_ = equalsIgnoreCase(value, "keep-alive") || (keepAlive_ && !equalsIgnoreCase(value, "close"));
+        }
+        response_.headers.emplace_back(name, value);
+    }
+
+    const bool noBody = headRequest_ || response_.httpStatus == 204 || response_.httpStatus == 304 || response_.httpStatus < 200;
+    if (noBody) {
+        framing_ = Framing::LENGTH;
+        contentLength_ = 0;
+    } else if (framing_ == Framing::LENGTH && !hasLength) {
+        framing_ = Framing::UNTIL_CLOSE;
+    }
+    return response_.httpStatus >= 200;
+}
+
+HttpParseStatus HttpResponseParser::parseChunks() {
+    for (;;) {
+        const size_t sizeEnd = buffer_.find("\r\n", chunkOffset_);
+        if (sizeEnd == std::string::npos) {
+            return HttpParseStatus::INCOMPLETE;
+        }
+        // Hex digits, then the end of the line or chunk extensions after a ';'
+        if (!isHexDigit(buffer_[chunkOffset_])) {
+            return HttpParseStatus::INVALID;
+        }
+        char* end = nullptr;
+        const unsigned long long chunkSize = std::strtoull(buffer_.c_str() + chunkOffset_, &end, 16);
+        if (*end != '\r' && *end != ';' && *end != ' ' && *end != '\t') {
+            return HttpParseStatus::INVALID;
+        }
+        if (chunkSize > maxBodyBytes_ - response_.body.size()) {
+            return HttpParseStatus::TOO_LARGE;
+        }
+        if (chunkSize == 0) {
+            // The last chunk, followed by optional trailers and an empty line
+            if (buffer_.find("\r\n\r\n", sizeEnd) == std::string::npos) {
+                return HttpParseStatus::INCOMPLETE;
+            }
+            return HttpParseStatus::COMPLETE;
+        }
+        const size_t dataStart = sizeEnd + 2;
+        const size_t dataEnd = dataStart + chunkSize;
+        if (buffer_.size() < dataEnd + 2) {
+            return HttpParseStatus::INCOMPLETE;
+        }
+        if (buffer_.compare(dataEnd, 2, "\r\n") != 0) {
+            return HttpParseStatus::INVALID; // the chunk is longer than its size
+        }
+        response_.body.append(buffer_, dataStart, chunkSize);
+        chunkOffset_ = dataEnd + 2;
+    }
+}
+
+} // namespace oscp
@@ -0,0 +1,123 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/imu_preintegration.h>
+#include <oscp-gpp/quaternion_utils.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+namespace oscp {
+
+// Linear interpolation of the samples at time t, clamped to the first and last sample.
+// cursor must not decrease between calls, so a sweep over increasing times is linear overall.
+static void interpolateAt(const ImuSamples& samples, std::time_t t, size_t& cursor, double out[3]) {
+    while (cursor + 1 < samples.count && samples.timestamps[cursor + 1] <= t) {
+        cursor++;
+    }
+    const size_t next = cursor + 1;
+    if (next >= samples.count || t <= samples.timestamps[cursor]) {
+        out[0] = samples.x[cursor];
+        out[1] = samples.y[cursor];
+        out[2] = samples.z[cursor];
+        return;
+    }
+    const double alpha = static_cast<double>(t - samples.timestamps[cursor])
+                       / static_cast<double>(samples.timestamps[next] - samples.timestamps[cursor]);
+    out[0] = samples.x[cursor] + alpha * (samples.x[next] - samples.x[cursor]);
+    out[1] = samples.y[cursor] + alpha * (samples.y[next] - samples.y[cursor]);
+    out[2] = samples.z[cursor] + alpha * (samples.z[next] - samples.z[cursor]);
+}
+
+ImuPreintegration preintegrateImu(const ImuSamples& gyroscope, const ImuSamples& accelerometer,
+                                  std::time_t begin, std::time_t end, const ImuBias& bias) {
+    ImuPreintegration result;
+    if (end <= begin) {
+        return result;
+    }
+
+    Quaternion& rotation = result.deltaRotation;
+    double* velocity = result.deltaVelocity;
+    double* position = result.deltaPosition;
+    size_t accelerometerCursor = 0;
+
+    for (size_t k = 0; k < gyroscope.count; k++) {
+        const std::time_t intervalBegin = std::max(gyroscope.timestamps[k], begin);
+        const std::time_t intervalEnd = (k + 1 < gyroscope.count) ? std::min(gyroscope.timestamps[k + 1], end) : end;
+        if (intervalEnd <= intervalBegin) {
+            if (gyroscope.timestamps[k] >= end) {
+                break;
+            }
+            continue;
+        }
+        const double dt = static_cast<double>(intervalEnd - intervalBegin) / 1000.0;
+
+        if (accelerometer.count > 0) {
+            // Velocity and position use the rotation at the beginning of the interval
+            double acceleration[3];
+            interpolateAt(accelerometer, intervalBegin, accelerometerCursor, acceleration);
+            acceleration[0] -= bias.accelerometer[0];
+            acceleration[1] -= bias.accelerometer[1];
+            acceleration[2] -= bias.accelerometer[2];
+            rotate(rotation, acceleration, acceleration);
+            for (int c = 0; c < 3; c++) {
+                position[c] += velocity[c] * dt + 0.5 * acceleration[c] * dt * dt;
+                velocity[c] += acceleration[c] * dt;
+            }
+        }
+
+        rotation = multiply(rotation, fromRotationVector((gyroscope.x[k] - bias.gyroscope[0]) * dt,
+                                                         (gyroscope.y[k] - bias.gyroscope[1]) * dt,
+                                                         (gyroscope.z[k] - bias.gyroscope[2]) * dt));
+        result.deltaTime += dt;
+    }
+
+    rotation = normalized(rotation);
+    return result;
+}
+
+// Integrates the blocks of the sensor of the first block, in their order
+static Quaternion integrateGyroscopeBlocks(const std::pmr::vector<ImuReadingBlock>& blocks, std::time_t begin, std::time_t end) {
+    Quaternion rotation;
+    if (blocks.empty()) {
+        return rotation;
+    }
+    const std::pmr::string& sensorId = blocks.front().sensorId;
+    const ImuReadingBlock* pending = nullptr;
+    for (const ImuReadingBlock& block : blocks) {
+        if (block.sensorId != sensorId || block.size() == 0) {
+            continue;
+        }
+        if (pending != nullptr) {
+            const std::time_t pendingEnd = std::min(end, block.timestamps.front());
+            rotation = multiply(rotation, preintegrateImu(ImuSamples(*pending), ImuSamples(), begin, pendingEnd).deltaRotation);
+        }
+        pending = &block;
+    }
+    if (pending != nullptr) {
+        rotation = multiply(rotation, preintegrateImu(ImuSamples(*pending), ImuSamples(), begin, end).deltaRotation);
+    }
+    return normalized(rotation);
+}
+
+Quaternion integrateGyroscope(const SensorReadings& readings, std::time_t begin, std::time_t end) {
+    if (!readings.gyroscopeBlocks.empty()) {
+        return integrateGyroscopeBlocks(readings.gyroscopeBlocks, begin, end);
+    }
+    if (readings.gyroscopeReadings.empty()) {
+        return Quaternion();
+    }
+    std::byte buffer[16 * 1024];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+    std::pmr::vector<ImuReadingBlock> blocks(&resource);
+    appendImuReadingBlocks(readings.gyroscopeReadings, blocks);
+    return integrateGyroscopeBlocks(blocks, begin, end);
+}
+
+} // namespace oscp
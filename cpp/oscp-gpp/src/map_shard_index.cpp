@@ -0,0 +1,107 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/map_shard_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace oscp {
+
+MapShardIndex::MapShardIndex(std::vector<MapShard> shards, double cellSizeDegrees)
+    : shards_(std::move(shards)), cellSizeDegrees_(cellSizeDegrees) {
+    // The cell IDs hold a column index in 32 bits
+    if (!(cellSizeDegrees_ >= minCellSizeDegrees) || cellSizeDegrees_ > 180.0) {
+        throw std::invalid_argument("The cell size of the map shard index must be in [0.000001, 180] degrees");
+    }
+    lonCellCount_ = static_cast<int64_t>(std::ceil(360.0 / cellSizeDegrees_));
+
+    // Collect the shards per cell in an ordered map first, then flatten it
+    std::map<uint64_t, std::vector<uint32_t>> shardsPerCell;
+    for (size_t s = 0; s < shards_.size(); s++) {
+        const GeoBoundingBox& b = shards_[s].bounds;
+        if (b.minLat > b.maxLat || b.minLat < -90.0 || b.maxLat > 90.0
+                || b.minLon < -180.0 || b.minLon > 180.0 || b.maxLon < -180.0 || b.maxLon > 180.0) {
+            throw std::invalid_argument("Invalid bounds of map shard " + shards_[s].id);
+        }
+        const int64_t latBegin = latCell(b.minLat);
+        const int64_t latEnd = latCell(b.maxLat);
+        const int64_t lonBegin = lonCell(b.minLon);
+        int64_t lonEnd = lonCell(b.maxLon);
+        if (b.minLon > b.maxLon) {
+            lonEnd += lonCellCount_; // crosses the antimeridian
+        }
+        if ((latEnd - latBegin + 1) * (lonEnd - lonBegin + 1) > static_cast<int64_t>(maxCellsPerShard)) {
+            largeShards_.push_back(static_cast<uint32_t>(s));
+            continue;
+        }
+        for (int64_t la = latBegin; la <= latEnd; la++) {
+            for (int64_t lo = lonBegin; lo <= lonEnd; lo++) {
+                shardsPerCell[cellId(la, lo % lonCellCount_)].push_back(static_cast<uint32_t>(s));
+            }
+        }
+    }
+
+    cells_.reserve(shardsPerCell.size());
+    for (const auto& cell : shardsPerCell) {
+        CellRange range;
+        range.begin = static_cast<uint32_t>(cellShards_.size());
+        cellShards_.insert(cellShards_.end(), cell.second.begin(), cell.second.end());
+        range.end = static_cast<uint32_t>(cellShards_.size());
+        cells_.emplace(cell.first, range);
+    }
+}
+
+int64_t MapShardIndex::latCell(double lat) const {
+    return static_cast<int64_t>(std::floor((lat + 90.0) / cellSizeDegrees_));
+}
+
+int64_t MapShardIndex::lonCell(double lon) const {
+    // 180 degrees east falls into the last column, not onto the first one, so that a box ending there stays in order
+    return std::min(static_cast<int64_t>(std::floor((lon + 180.0) / cellSizeDegrees_)), lonCellCount_ - 1);
+}
+
+uint64_t MapShardIndex::cellId(int64_t latCell, int64_t lonCell) {
+    return (static_cast<uint64_t>(latCell) << 32) | static_cast<uint64_t>(lonCell);
+}
+
+size_t MapShardIndex::find(double lat, double lon, size_t* results, size_t maxResults) const {
+    if (!(lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0)) {
+        return 0; // also rejects NaN
+    }
+    const uint32_t* cell = nullptr;
+    const uint32_t* cellEnd = nullptr;
+    auto it = cells_.find(cellId(latCell(lat), lonCell(lon)));
+    if (it != cells_.end()) {
+        cell = cellShards_.data() + it->second.begin;
+        cellEnd = cellShards_.data() + it->second.end;
+    }
+    // Both lists are in shard order, merge them to keep the results in that order
+    const uint32_t* large = largeShards_.data();
+    const uint32_t* largeEnd = large + largeShards_.size();
+    size_t count = 0;
+    while (count < maxResults && (cell != cellEnd || large != largeEnd)) {
+        const uint32_t s = large == largeEnd || (cell != cellEnd && *cell < *large) ? *cell++ : *large++;
+        if (shards_[s].bounds.contains(lat, lon)) {
+            results[count++] = s;
+        }
+    }
+    return count;
+}
+
+const MapShard* MapShardIndex::findFirst(double lat, double lon) const {
+    size_t s = 0;
+    if (find(lat, lon, &s, 1) == 0) {
+        return nullptr;
+    }
+    return &shards_[s];
+}
+
+} // namespace oscp
@@ -0,0 +1,110 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/pose_tracker.h>
+#include <oscp-gpp/imu_preintegration.h>
+#include <oscp-gpp/quaternion_utils.h>
+
+namespace oscp {
+
+// Sessions are swept for timeouts after this many updates
+static const uint64_t sweepInterval = 1024;
+
+PoseTracker::PoseTracker(const PoseTrackerPolicy& policy) : policy_(policy) {
+}
+
+bool PoseTracker::tryPropagate(const std::string& sessionKey, const GeoPoseRequest& request, GeoPoseResponse& response) {
+    // Only the pose the server remembered is propagated, request.priorPoses come from the client and are not trusted
+    bool hasPrior = false;
+    Prior prior;
+    if (!sessionKey.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(sessionKey);
+        if (it != sessions_.end()) {
+            prior = it->second;
+            hasPrior = true;
+        }
+    }
+    if (!hasPrior) {
+        missesNoPrior_++;
+        return false;
+    }
+
+    const std::time_t age = request.timestamp - prior.timestamp;
+    if (age < 0 || age > policy_.maxPriorAgeMs) {
+        missesStalePrior_++;
+        return false;
+    }
+
+    const float ageSeconds = static_cast<float>(age) / 1000.0f;
+    GeoPoseAccuracy accuracy;
+    accuracy.position = prior.accuracy.position + policy_.positionAccuracyGrowth * ageSeconds;
+    accuracy.orientation = prior.accuracy.orientation + policy_.orientationAccuracyGrowth * ageSeconds;
+    if (!(accuracy.position <= policy_.maxPositionAccuracy) || !(accuracy.orientation <= policy_.maxOrientationAccuracy)) {
+        missesInaccurate_++;
+        return false;
+    }
+
+    // The position is held, the orientation follows the gyroscope
+    const Quaternion delta = integrateGyroscope(request.sensorReadings, prior.timestamp, request.timestamp);
+    response.id = request.id;
+    response.timestamp = request.timestamp;
+    response.accuracy = accuracy;
+    response.geopose.position = prior.geopose.position;
+    response.geopose.quaternion = normalized(multiply(prior.geopose.quaternion, delta));
+
+    Prior propagated;
+    propagated.timestamp = response.timestamp;
+    propagated.accuracy = response.accuracy;
+    propagated.geopose = response.geopose;
+    remember(sessionKey, propagated);
+    hits_++;
+    return true;
+}
+
+void PoseTracker::accept(const std::string& sessionKey, const GeoPoseResponse& response) {
+    Prior prior;
+    prior.timestamp = response.timestamp;
+    prior.accuracy = response.accuracy;
+    prior.geopose = response.geopose;
+    remember(sessionKey, prior);
+}
+
+void PoseTracker::remember(const std::string& sessionKey, const Prior& prior) {
+    if (sessionKey.empty()) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Prior& session = sessions_[sessionKey];
+    session = prior;
+    session.lastSeen = now;
+
+    if (++updatesSinceSweep_ >= sweepInterval) {
+        updatesSinceSweep_ = 0;
+        const auto timeout = std::chrono::milliseconds(policy_.sessionTimeoutMs);
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            if (now - it->second.lastSeen > timeout) {
+                it = sessions_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+PoseTrackerStats PoseTracker::stats() const {
+    PoseTrackerStats stats;
+    stats.hits = hits_;
+    stats.missesNoPrior = missesNoPrior_;
+    stats.missesStalePrior = missesStalePrior_;
+    stats.missesInaccurate = missesInaccurate_;
+    return stats;
+}
+
+} // namespace oscp
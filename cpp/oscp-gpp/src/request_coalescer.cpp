@@ -0,0 +1,99 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/request_coalescer.h>
+
+namespace oscp {
+
+RequestCoalescer::RequestCoalescer(const RequestCoalescerPolicy& policy) : policy_(policy) {
+}
+
+GeoPoseResponse RequestCoalescer::run(const std::string& key, const std::function<GeoPoseResponse()>& localize) {
+    if (key.empty()) {
+        executed_++;
+        return localize();
+    }
+
+    std::promise<GeoPoseResponse> promise;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto completedIt = completed_.find(key);
+        if (completedIt != completed_.end() && std::chrono::steady_clock::now() < completedIt->second.expires) {
+            replayed_++;
+            return completedIt->second.response;
+        }
+        auto inFlightIt = inFlight_.find(key);
+        if (inFlightIt != inFlight_.end()) {
+            std::shared_future<GeoPoseResponse> future = inFlightIt->second;
+            lock.unlock();
+            coalesced_++;
+            return future.get(); // rethrows the failure of the original
+        }
+        inFlight_.emplace(key, promise.get_future().share());
+    }
+
+    executed_++;
+    try {
+        GeoPoseResponse response = localize();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            complete(key, response);
+            inFlight_.erase(key);
+        }
+        promise.set_value(response);
+        return response;
+    } catch (...) {
+        failed_++;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlight_.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+void RequestCoalescer::complete(const std::string& key, const GeoPoseResponse& response) {
+    const auto now = std::chrono::steady_clock::now();
+
+    // The TTL is the same for all entries, so the expired ones are at the front
+    while (!completedOrder_.empty()) {
+        const auto& oldest = completedOrder_.front();
+        auto it = completed_.find(oldest.first);
+        const bool current = it != completed_.end() && it->second.expires == oldest.second;
+        if (current && oldest.second > now && completed_.size() < policy_.maxCompleted) {
+            break;
+        }
+        if (current) {
+            completed_.erase(it);
+        }
+        completedOrder_.pop_front();
+    }
+    if (policy_.maxCompleted == 0) {
+        return;
+    }
+
+    Completed& completed = completed_[key];
+    completed.response = response;
+    completed.expires = now + std::chrono::milliseconds(policy_.completedTtlMs);
+    completedOrder_.emplace_back(key, completed.expires);
+}
+
+RequestCoalescerStats RequestCoalescer::stats() const {
+    RequestCoalescerStats stats;
+    stats.executed = executed_;
+    stats.coalesced = coalesced_;
+    stats.replayed = replayed_;
+    stats.failed = failed_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.inFlight = inFlight_.size();
+    stats.completed = completed_.size();
+    return stats;
+}
+
+} // namespace oscp
@@ -0,0 +1,136 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/request_trace.h>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+namespace oscp {
+
+namespace {
+
+uint32_t currentThread() {
+    static std::atomic<uint32_t> threadCount{0};
+    thread_local const uint32_t thread = ++threadCount;
+    return thread;
+}
+
+} // namespace
+
+RequestTrace::RequestTrace(std::string label) : label_(std::move(label)) {
+}
+
+int64_t RequestTrace::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+size_t RequestTrace::begin(const char* name) {
+    const size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= maxSpans) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return maxSpans;
+    }
+    Span& span = spans_[index];
+    span.name = name;
+    span.thread = currentThread();
+    span.startNs = nowNs();
+    return index;
+}
+
+void RequestTrace::end(size_t span) {
+    if (span < maxSpans) {
+        spans_[span].endNs = nowNs();
+    }
+}
+
+size_t RequestTrace::size() const {
+    const size_t count = next_.load(std::memory_order_relaxed);
+    return count < maxSpans ? count : maxSpans;
+}
+
+std::string RequestTrace::serverTiming() const {
+    std::string header;
+    const size_t count = size();
+    for (size_t i = 0; i < count; i++) {
+        const Span& span = spans_[i];
+        if (span.endNs < 0) {
+            continue;
+        }
+        char duration[32];
+        std::snprintf(duration, sizeof(duration), ";dur=%.3f", static_cast<double>(span.endNs - span.startNs) / 1e6);
+        if (!header.empty()) {
+            header += ", ";
+        }
+        header += span.name;
+        header += duration;
+    }
+    return header;
+}
+
+TraceLog::TraceLog(size_t maxTraces) : maxTraces_(maxTraces) {
+}
+
+void TraceLog::add(const RequestTrace& trace) {
+    if (maxTraces_ == 0) {
+        return;
+    }
+    Record record;
+    record.label = trace.label();
+    const size_t count = trace.size();
+    record.spans.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (trace.span(i).endNs >= 0) {
+            record.spans.push_back(trace.span(i));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (records_.size() == maxTraces_) {
+        records_.pop_front();
+    }
+    records_.push_back(std::move(record));
+}
+
+std::string TraceLog::chromeTraceJson() const {
+    nlohmann::json events = nlohmann::json::array();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Record& record : records_) {
+            for (const RequestTrace::Span& span : record.spans) {
+                events.push_back({
+                    {"name", span.name},
+                    {"cat", "oscp"},
+                    {"ph", "X"},
+                    {"ts", static_cast<double>(span.startNs) / 1e3},
+                    {"dur", static_cast<double>(span.endNs - span.startNs) / 1e3},
+                    {"pid", 1},
+                    {"tid", span.thread},
+                    {"args", {{"request", record.label}}}
+                });
+            }
+        }
+    }
+    nlohmann::json trace = {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+    return trace.dump();
+}
+
+size_t TraceLog::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.size();
+}
+
+void TraceLog::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+}
+
+} // namespace oscp
@@ -0,0 +1,131 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/response_cache.h>
+#include <oscp-gpp/hash.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace oscp {
+
+ResponseCache::ResponseCache(const ResponseCachePolicy& policy) : policy_(policy) {
+    if (policy_.shardCount == 0) {
+        throw std::invalid_argument("The response cache needs at least one shard");
+    }
+    if (!(policy_.geolocationBucketDegrees > 0.0)) {
+        throw std::invalid_argument("The geolocation bucket of the response cache must be positive");
+    }
+    maxEntriesPerShard_ = (policy_.maxEntries + policy_.shardCount - 1) / policy_.shardCount;
+    shards_.reserve(policy_.shardCount);
+    for (size_t i = 0; i < policy_.shardCount; i++) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+bool ResponseCache::key(const GeoPoseRequest& request, uint64_t& key) const {
+    if (request.sensorReadings.cameraReadings.empty()) {
+        return false;
+    }
+    Xxh64 hash;
+    for (const CameraReading& reading : request.sensorReadings.cameraReadings) {
+        hash.updateValue(reading.imageBytes.size());
+        hash.update(reading.imageBytes);
+        hash.updateValue(reading.imageFormat);
+        hash.updateValue(reading.size[0]);
+        hash.updateValue(reading.size[1]);
+        hash.updateValue(reading.imageOrientation.mirrored);
+        hash.updateValue(reading.imageOrientation.rotation);
+        hash.updateValue(reading.params.model);
+        hash.updateValue(reading.params.modelParams.size());
+        hash.update(reading.params.modelParams.data(), reading.params.modelParams.size() * sizeof(float));
+    }
+    if (!request.sensorReadings.geolocationReadings.empty()) {
+        const GeolocationReading& geolocation = request.sensorReadings.geolocationReadings.front();
+        const int64_t latBucket = static_cast<int64_t>(std::floor(geolocation.latitude / policy_.geolocationBucketDegrees));
+        const int64_t lonBucket = static_cast<int64_t>(std::floor(geolocation.longitude / policy_.geolocationBucketDegrees));
+        hash.updateValue(latBucket);
+        hash.updateValue(lonBucket);
+    }
+    key = hash.digest();
+    return true;
+}
+
+ResponseCache::Shard& ResponseCache::shardOf(uint64_t key) {
+    // The low bits pick the bucket in the shard's hash map, use the high ones for the shard
+    return *shards_[(key >> 40) % shards_.size()];
+}
+
+bool ResponseCache::find(uint64_t key, GeoPoseResponse& response) {
+    Shard& shard = shardOf(key);
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            if (now < it->second->expires) {
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                response = it->second->response;
+                hits_++;
+                return true;
+            }
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+    misses_++;
+    return false;
+}
+
+void ResponseCache::insert(uint64_t key, const GeoPoseResponse& response) {
+    if (maxEntriesPerShard_ == 0) {
+        return;
+    }
+    Shard& shard = shardOf(key);
+    const auto expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(policy_.ttlMs);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it->second->response = response;
+        it->second->expires = expires;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return;
+    }
+    Entry& entry = shard.entries.emplace_front();
+    entry.key = key;
+    entry.response = response;
+    entry.expires = expires;
+    shard.index.emplace(key, shard.entries.begin());
+    while (shard.entries.size() > maxEntriesPerShard_) {
+        shard.index.erase(shard.entries.back().key);
+        shard.entries.pop_back();
+        evictions_++;
+    }
+}
+
+void ResponseCache::clear() {
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->entries.clear();
+    }
+}
+
+ResponseCacheStats ResponseCache::stats() const {
+    ResponseCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.entries += shard->entries.size();
+    }
+    return stats;
+}
+
+} // namespace oscp
@@ -0,0 +1,181 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/sensor_registry.h>
+#include <oscp-gpp/hash.h>
+
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+namespace oscp {
+
+namespace {
+
+// Length-prefixed binary encoding of a sensor set, equal for equal sets
+class ContentEncoder {
+public:
+    template<typename T>
+    void value(const T& value) {
+        content_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void string(std::string_view str) {
+        value(str.size());
+        content_.append(str.data(), str.size());
+    }
+
+    void strings(const std::pmr::vector<std::pmr::string>& strs) {
+        value(strs.size());
+        for (const std::pmr::string& str : strs) {
+            string(str);
+        }
+    }
+
+    void floats(const std::pmr::vector<float>& values) {
+        value(values.size());
+        content_.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    }
+
+    std::string& content() {
+        return content_;
+    }
+
+private:
+    std::string content_;
+};
+
+std::string encode(const GeoPoseSession& sensors) {
+    ContentEncoder encoder;
+    encoder.value(sensors.sensors.size());
+    for (const Sensor& sensor : sensors.sensors) {
+        encoder.value(sensor.type);
+        encoder.string(sensor.id);
+        encoder.string(sensor.name);
+        encoder.string(sensor.model);
+        encoder.string(sensor.rigIdentifier);
+        encoder.value(sensor.rigRotation.x);
+        encoder.value(sensor.rigRotation.y);
+        encoder.value(sensor.rigRotation.z);
+        encoder.value(sensor.rigRotation.w);
+        encoder.value(sensor.rigTranslation.x);
+        encoder.value(sensor.rigTranslation.y);
+        encoder.value(sensor.rigTranslation.z);
+    }
+    encoder.value(sensors.privacy.has_value());
+    if (sensors.privacy.has_value()) {
+        encoder.strings(sensors.privacy->dataRetention);
+        encoder.strings(sensors.privacy->dataAcceptableUse);
+        encoder.strings(sensors.privacy->dataSanitizationApplied);
+        encoder.strings(sensors.privacy->dataSanitizationRequested);
+    }
+    encoder.value(sensors.cameras.size());
+    for (const SessionCamera& camera : sensors.cameras) {
+        encoder.string(camera.sensorId);
+        encoder.value(camera.params.model);
+        encoder.floats(camera.params.modelParams);
+        encoder.floats(camera.params.minMaxDepth);
+        encoder.floats(camera.params.minMaxDisparity);
+    }
+    return std::move(encoder.content());
+}
+
+} // namespace
+
+SensorRegistry::SensorRegistry(const SensorRegistryPolicy& policy) : policy_(policy) {
+}
+
+std::string SensorRegistry::add(GeoPoseSession sensors) {
+    std::string content = encode(sensors);
+    char token[17];
+    std::snprintf(token, sizeof(token), "%016llx", static_cast<unsigned long long>(xxh64(content)));
+
+    // Most calls register a set that is already known
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = entries_.find(token);
+        if (it != entries_.end()) {
+            if (it->second.content == content) {
+                return token;
+            }
+            collisions_++;
+            return std::string();
+        }
+    }
+
+    if (policy_.maxEntries == 0) {
+        return std::string();
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto inserted = entries_.try_emplace(token);
+    Entry& entry = inserted.first->second;
+    if (!inserted.second) {
+        // Added concurrently
+        if (entry.content == content) {
+            return token;
+        }
+        collisions_++;
+        return std::string();
+    }
+    entry.content = std::move(content);
+    entry.sensors = std::make_shared<const GeoPoseSession>(std::move(sensors));
+    order_.emplace_back(token);
+    added_++;
+    while (entries_.size() > policy_.maxEntries) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+        evictions_++;
+    }
+    return token;
+}
+
+std::shared_ptr<const GeoPoseSession> SensorRegistry::find(const std::string& token) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(token);
+    if (it == entries_.end()) {
+        misses_++;
+        return nullptr;
+    }
+    hits_++;
+    return it->second.sensors;
+}
+
+void SensorRegistry::resolve(GeoPoseRequest& request) const {
+    if (std::optional<ParseError> error = tryResolve(request)) {
+        if (error->code == ParseErrorCode::UNKNOWN_SENSORS_TOKEN) {
+            throw UnknownSensorsTokenError(error->message);
+        }
+        throw std::runtime_error(error->message);
+    }
+}
+
+std::optional<ParseError> SensorRegistry::tryResolve(GeoPoseRequest& request) const {
+    if (request.sensorsToken.empty() || !request.sensors.empty()) {
+        return std::nullopt;
+    }
+    std::shared_ptr<const GeoPoseSession> sensors = find(std::string(request.sensorsToken));
+    if (!sensors) {
+        return ParseError(ParseErrorCode::UNKNOWN_SENSORS_TOKEN, "/sensorsToken", "Unknown sensorsToken: " + std::string(request.sensorsToken));
+    }
+    return tryResolveSensors(request, *sensors);
+}
+
+SensorRegistryStats SensorRegistry::stats() const {
+    SensorRegistryStats stats;
+    stats.added = added_;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.collisions = collisions_;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    stats.entries = entries_.size();
+    return stats;
+}
+
+} // namespace oscp
@@ -0,0 +1,172 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/session_registry.h>
+
+#include <cstdio>
+#include <utility>
+
+namespace oscp {
+
+LocalizationSession::LocalizationSession(std::string id, GeoPoseSession definition, size_t maxQueuedMessages, size_t maxFramesInFlight)
+    : id_(std::move(id)), definition_(std::move(definition)), maxQueuedMessages_(maxQueuedMessages),
+      maxFramesInFlight_(maxFramesInFlight), lastActive_(std::chrono::steady_clock::now()) {
+}
+
+bool LocalizationSession::push(std::string message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+        messages_.push_back(std::move(message));
+        while (messages_.size() > maxQueuedMessages_) {
+            messages_.pop_front();
+            dropped_++;
+        }
+    }
+    available_.notify_one();
+    return true;
+}
+
+bool LocalizationSession::pop(std::string& message, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A waiting reader keeps the session alive
+    lastActive_ = std::chrono::steady_clock::now();
+    if (!available_.wait_for(lock, timeout, [this] { return !messages_.empty() || closed_; }) || messages_.empty()) {
+        return false;
+    }
+    message = std::move(messages_.front());
+    messages_.pop_front();
+    return true;
+}
+
+void LocalizationSession::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    available_.notify_all();
+}
+
+bool LocalizationSession::beginFrame() {
+    size_t inFlight = framesInFlight_.load();
+    do {
+        if (inFlight >= maxFramesInFlight_) {
+            return false;
+        }
+    } while (!framesInFlight_.compare_exchange_weak(inFlight, inFlight + 1));
+    return true;
+}
+
+void LocalizationSession::endFrame() {
+    framesInFlight_--;
+}
+
+bool LocalizationSession::closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+void LocalizationSession::touch() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lastActive_ = std::chrono::steady_clock::now();
+}
+
+std::chrono::steady_clock::time_point LocalizationSession::lastActive() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastActive_;
+}
+
+SessionRegistry::SessionRegistry(const SessionRegistryPolicy& policy) : policy_(policy) {
+}
+
+std::shared_ptr<LocalizationSession> SessionRegistry::create(GeoPoseSession definition) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sweep(std::chrono::steady_clock::now());
+    if (sessions_.size() >= policy_.maxSessions) {
+        return nullptr;
+    }
+    std::string id = newId();
+    auto session = std::make_shared<LocalizationSession>(id, std::move(definition), policy_.maxQueuedMessages, policy_.maxFramesInFlight);
+    sessions_.emplace(std::move(id), session);
+    created_++;
+    return session;
+}
+
+std::shared_ptr<LocalizationSession> SessionRegistry::find(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(id);
+    if (it == sessions_.end()) {
+        return nullptr;
+    }
+    std::shared_ptr<LocalizationSession> session = it->second;
+    if (expired(*session, std::chrono::steady_clock::now())) {
+        session->close();
+        sessions_.erase(it);
+        expired_++;
+        return nullptr;
+    }
+    session->touch();
+    return session;
+}
+
+bool SessionRegistry::close(const std::string& id) {
+    std::shared_ptr<LocalizationSession> session;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(id);
+        if (it == sessions_.end()) {
+            return false;
+        }
+        session = std::move(it->second);
+        sessions_.erase(it);
+    }
+    session->close();
+    closed_++;
+    return true;
+}
+
+bool SessionRegistry::expired(const LocalizationSession& session, std::chrono::steady_clock::time_point now) const {
+    return now - session.lastActive() > std::chrono::milliseconds(policy_.idleTimeoutMs);
+}
+
+void SessionRegistry::sweep(std::chrono::steady_clock::time_point now) {
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+        if (expired(*it->second, now)) {
+            it->second->close();
+            it = sessions_.erase(it);
+            expired_++;
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string SessionRegistry::newId() {
+    // 128 random bits, so the ID of a session cannot be guessed by other clients
+    std::string id;
+    do {
+        char buffer[33];
+        std::snprintf(buffer, sizeof(buffer), "%08x%08x%08x%08x", random_(), random_(), random_(), random_());
+        id = buffer;
+    } while (sessions_.count(id) > 0);
+    return id;
+}
+
+SessionRegistryStats SessionRegistry::stats() const {
+    SessionRegistryStats stats;
+    stats.created = created_;
+    stats.closed = closed_;
+    stats.expired = expired_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.active = sessions_.size();
+    return stats;
+}
+
+} // namespace oscp
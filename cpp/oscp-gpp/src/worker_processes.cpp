@@ -0,0 +1,323 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include <oscp-gpp/worker_processes.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#include <sys/prctl.h>
+#endif
+
+namespace oscp {
+
+std::vector<int> parseCpuList(std::string_view cpuList) {
+    std::vector<int> cpus;
+    while (!cpuList.empty() && (cpuList.back() == '\n' || cpuList.back() == ' ')) {
+        cpuList.remove_suffix(1);
+    }
+    size_t pos = 0;
+    auto parseNumber = [&](int& number) {
+        const size_t start = pos;
+        number = 0;
+        while (pos < cpuList.size() && cpuList[pos] >= '0' && cpuList[pos] <= '9' && pos - start < 6) {
+            number = number * 10 + (cpuList[pos] - '0');
+            pos++;
+        }
+        return pos > start;
+    };
+    while (pos < cpuList.size()) {
+        int first = 0;
+        int last = 0;
+        if (!parseNumber(first)) {
+            return {};
+        }
+        last = first;
+        if (pos < cpuList.size() && cpuList[pos] == '-') {
+            pos++;
+            if (!parseNumber(last) || last < first) {
+                return {};
+            }
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+        if (pos < cpuList.size()) {
+            if (cpuList[pos] != ',' || pos + 1 == cpuList.size()) {
+                return {};
+            }
+            pos++;
+        }
+    }
+    return cpus;
+}
+
+namespace {
+
+// The CPUs this process may run on, in ascending order
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+// The allowed CPUs of each NUMA node that has any
+std::vector<std::vector<int>> numaNodes(const std::vector<int>& allowed) {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0; ; node++) {
+        std::ifstream cpuListFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!cpuListFile.is_open()) {
+            break;
+        }
+        std::string cpuList;
+        std::getline(cpuListFile, cpuList);
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(cpuList)) {
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+    if (nodes.empty()) {
+        nodes.push_back(allowed);
+    }
+    return nodes;
+}
+
+} // namespace
+
+std::vector<std::vector<int>> workerCpuSets(size_t workers, CpuPinning pinning) {
+    std::vector<std::vector<int>> sets(workers);
+    const std::vector<int> allowed = pinning == CpuPinning::NONE ? std::vector<int>() : allowedCpus();
+    if (allowed.empty()) {
+        return sets;
+    }
+    if (pinning == CpuPinning::NUMA_NODE) {
+        const std::vector<std::vector<int>> nodes = numaNodes(allowed);
+        for (size_t i = 0; i < workers; i++) {
+            sets[i] = nodes[i % nodes.size()];
+        }
+    } else if (workers > allowed.size()) {
+        for (size_t i = 0; i < workers; i++) {
+            sets[i] = {allowed[i % allowed.size()]};
+        }
+    } else {
+        // Contiguous shares, neighbouring CPUs tend to share caches
+        for (size_t i = 0; i < workers; i++) {
+            sets[i].assign(allowed.begin() + i * allowed.size() / workers, allowed.begin() + (i + 1) * allowed.size() / workers);
+        }
+    }
+    return sets;
+}
+
+bool pinToCpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+bool enableReusePort(int socket) {
+#if !defined(_WIN32) && defined(SO_REUSEPORT)
+    const int yes = 1;
+    return setsockopt(socket, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) == 0;
+#else
+    (void)socket;
+    return false;
+#endif
+}
+
+WorkerSupervisor::WorkerSupervisor(const SupervisorPolicy& policy) : policy_(policy) {
+}
+
+#ifdef _WIN32
+
+std::optional<size_t> WorkerSupervisor::run() {
+    throw std::runtime_error("Worker processes are not supported on this platform");
+}
+
+#else
+
+namespace {
+
+volatile std::sig_atomic_t stopSignal = 0;
+volatile std::sig_atomic_t hangupSignal = 0;
+
+extern "C" void onStopSignal(int signal) {
+    stopSignal = signal;
+}
+
+extern "C" void onHangupSignal(int) {
+    hangupSignal = 1;
+}
+
+} // namespace
+
+std::optional<size_t> WorkerSupervisor::run() {
+    using Clock = std::chrono::steady_clock;
+    struct Worker {
+        pid_t pid = 0;
+        bool done = false;
+        Clock::time_point startedAt;
+        Clock::time_point restartAt;
+        std::chrono::milliseconds restartDelay;
+    };
+    std::vector<Worker> workers(policy_.workers);
+    for (Worker& worker : workers) {
+        worker.restartDelay = std::chrono::milliseconds(policy_.restartDelayMs);
+    }
+
+    // Without SA_RESTART, so that a stop signal interrupts the sleep below
+    stopSignal = 0;
+    hangupSignal = 0;
+    struct sigaction action = {};
+    action.sa_handler = onStopSignal;
+    sigemptyset(&action.sa_mask);
+    struct sigaction previousTerm = {};
+    struct sigaction previousInt = {};
+    struct sigaction previousHup = {};
+    sigaction(SIGTERM, &action, &previousTerm);
+    sigaction(SIGINT, &action, &previousInt);
+    action.sa_handler = onHangupSignal;
+    sigaction(SIGHUP, &action, &previousHup);
+    auto restoreSignals = [&]() {
+        sigaction(SIGTERM, &previousTerm, nullptr);
+        sigaction(SIGINT, &previousInt, nullptr);
+        sigaction(SIGHUP, &previousHup, nullptr);
+    };
+    const pid_t supervisor = getpid();
+
+    while (stopSignal == 0) {
+        const Clock::time_point now = Clock::now();
+        bool anyLeft = false;
+        for (size_t i = 0; i < workers.size(); i++) {
+            Worker& worker = workers[i];
+            if (worker.done) {
+                continue;
+            }
+            anyLeft = true;
+            if (worker.pid != 0 || now < worker.restartAt) {
+                continue;
+            }
+            const pid_t pid = fork();
+            if (pid == 0) {
+                restoreSignals();
+                signal(SIGHUP, SIG_IGN); // until the worker handles the SIGHUPs passed on to it
+#ifdef __linux__
+                prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+                if (getppid() != supervisor) {
+                    _exit(0); // the supervisor died before the death signal was set
+                }
+                return i;
+            }
+            if (pid < 0) {
+                worker.restartAt = now + worker.restartDelay; // e.g. out of processes, try again later
+                continue;
+            }
+            worker.pid = pid;
+            worker.startedAt = now;
+            stats_.started++;
+        }
+        if (!anyLeft) {
+            break;
+        }
+        if (hangupSignal != 0) {
+            hangupSignal = 0;
+            for (const Worker& worker : workers) {
+                if (worker.pid != 0) {
+                    kill(worker.pid, SIGHUP);
+                }
+            }
+        }
+
+        // Polls, so that workers waiting for their restart and stop signals are noticed within 100 ms
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, WNOHANG);
+        if (pid <= 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        for (Worker& worker : workers) {
+            if (worker.pid != pid) {
+                continue;
+            }
+            worker.pid = 0;
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+                worker.done = true;
+                break;
+            }
+            stats_.crashed++;
+            const Clock::time_point exitedAt = Clock::now();
+            if (exitedAt - worker.startedAt >= std::chrono::milliseconds(policy_.minUptimeMs)) {
+                worker.restartDelay = std::chrono::milliseconds(policy_.restartDelayMs);
+            }
+            worker.restartAt = exitedAt + worker.restartDelay;
+            worker.restartDelay = std::min(worker.restartDelay * 2, std::chrono::milliseconds(policy_.maxRestartDelayMs));
+            break;
+        }
+    }
+
+    for (const Worker& worker : workers) {
+        if (worker.pid != 0) {
+            kill(worker.pid, SIGTERM);
+        }
+    }
+    for (Worker& worker : workers) {
+        while (worker.pid != 0) {
+            if (waitpid(worker.pid, nullptr, 0) == worker.pid || errno != EINTR) {
+                worker.pid = 0;
+            }
+        }
+    }
+    restoreSignals();
+    return std::nullopt;
+}
+
+#endif // _WIN32
+
+} // namespace oscp
@@ -0,0 +1,32 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#ifndef _OSCP_TESTS_TEST_H_
+#define _OSCP_TESTS_TEST_H_
+
+#include <cstdio>
+
+// Minimal checks without a test framework: a failed check is printed and the test returns failures() from main()
+namespace oscp::tests {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+} // namespace oscp::tests
+
+#define OSCP_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            oscp::tests::failures()++; \
+        } \
+    } while (false)
+
+#endif // _OSCP_TESTS_TEST_H_
@@ -0,0 +1,152 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/admission_control.h>
+
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The X-OSCP-Timeout-Ms header is a plain number, anything else is answered with 400
+void testParseTimeoutMs() {
+    std::time_t timeoutMs = -1;
+    OSCP_CHECK(oscp::parseTimeoutMs("250", timeoutMs) && timeoutMs == 250);
+    OSCP_CHECK(oscp::parseTimeoutMs("0", timeoutMs) && timeoutMs == 0);
+    OSCP_CHECK(oscp::parseTimeoutMs("999999999", timeoutMs) && timeoutMs == 999999999);
+
+    timeoutMs = 7;
+    OSCP_CHECK(!oscp::parseTimeoutMs("", timeoutMs));
+    OSCP_CHECK(!oscp::parseTimeoutMs("1000000000", timeoutMs));
+    OSCP_CHECK(!oscp::parseTimeoutMs("-1", timeoutMs));
+    OSCP_CHECK(!oscp::parseTimeoutMs("+1", timeoutMs));
+    OSCP_CHECK(!oscp::parseTimeoutMs("1.5", timeoutMs));
+    OSCP_CHECK(!oscp::parseTimeoutMs(" 1", timeoutMs));
+    OSCP_CHECK(!oscp::parseTimeoutMs("1s", timeoutMs));
+    OSCP_CHECK(timeoutMs == 7);
+}
+
+using Clock = oscp::RequestBudget::Clock;
+
+// Waits until the given number of requests queue for a slot
+void waitQueued(const oscp::AdmissionController& admission, size_t queued) {
+    while (admission.stats().queued < queued) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// The deadline of the client is relative to the arrival, the age limit to the timestamp of the request
+void testBudgetExpiry() {
+    const Clock::time_point now = Clock::now();
+    const std::chrono::system_clock::time_point nowSystem = std::chrono::system_clock::now();
+    const std::time_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(nowSystem.time_since_epoch()).count();
+
+    oscp::RequestBudget unlimited;
+    OSCP_CHECK(!unlimited.expired(now) && unlimited.deadline() == Clock::time_point::max());
+    unlimited.setMaxAge(nowMs - 1000, 0, nowSystem, now); // 0 disables the age limit
+    unlimited.setMaxAge(0, 500, nowSystem, now); // as does a request without timestamp
+    OSCP_CHECK(!unlimited.expired(now));
+
+    oscp::RequestBudget timeout;
+    timeout.setTimeout(100, now);
+    OSCP_CHECK(!timeout.expired(now + std::chrono::milliseconds(99)));
+    OSCP_CHECK(timeout.expired(now + std::chrono::milliseconds(100)) == oscp::DropReason::DEADLINE_EXCEEDED);
+
+    oscp::RequestBudget age;
+    age.setMaxAge(nowMs - 300, 500, nowSystem, now);
+    OSCP_CHECK(!age.expired(now + std::chrono::milliseconds(199)));
+    OSCP_CHECK(age.expired(now + std::chrono::milliseconds(200)) == oscp::DropReason::TOO_OLD);
+    age.setMaxAge(nowMs + 1000, 500, nowSystem, now); // from the future, age 0
+    OSCP_CHECK(!age.expired(now + std::chrono::milliseconds(499)) && age.deadline() == now + std::chrono::milliseconds(500));
+
+    // Both passed: the deadline of the client is reported
+    age.setTimeout(100, now);
+    OSCP_CHECK(age.expired(now + std::chrono::milliseconds(500)) == oscp::DropReason::DEADLINE_EXCEEDED);
+
+    oscp::AdmissionController admission;
+    oscp::RequestBudget tooOld;
+    tooOld.setMaxAge(nowMs - 1000, 500);
+    OSCP_CHECK(admission.check(tooOld) == oscp::DropReason::TOO_OLD);
+    const oscp::AdmissionController::Slot slot = admission.acquire(tooOld);
+    OSCP_CHECK(!slot && slot.reason() == oscp::DropReason::TOO_OLD);
+    OSCP_CHECK(!admission.check(unlimited));
+    const oscp::AdmissionStats stats = admission.stats();
+    OSCP_CHECK(stats.tooOld == 2 && stats.admitted == 0 && stats.deadlineExceeded == 0);
+}
+
+// A request that waits for a slot beyond its deadline leaves the queue with DEADLINE_EXCEEDED
+void testQueueTimeout() {
+    oscp::AdmissionPolicy policy;
+    policy.maxConcurrent = 1;
+    oscp::AdmissionController admission(policy);
+    oscp::AdmissionController::Slot running = admission.acquire(oscp::RequestBudget());
+    OSCP_CHECK(running);
+
+    oscp::RequestBudget budget;
+    const Clock::time_point arrival = Clock::now();
+    budget.setTimeout(20, arrival);
+    const oscp::AdmissionController::Slot slot = admission.acquire(budget);
+    OSCP_CHECK(!slot && slot.reason() == oscp::DropReason::DEADLINE_EXCEEDED);
+    OSCP_CHECK(Clock::now() - arrival >= std::chrono::milliseconds(20));
+
+    oscp::AdmissionStats stats = admission.stats();
+    OSCP_CHECK(stats.deadlineExceeded == 1 && stats.running == 1 && stats.queued == 0);
+
+    // The slot is free again once released
+    running = oscp::AdmissionController::Slot();
+    OSCP_CHECK(admission.acquire(oscp::RequestBudget()));
+    stats = admission.stats();
+    OSCP_CHECK(stats.admitted == 2 && stats.running == 0);
+}
+
+// Three requests queue behind a running one for longer than the target. The first to leave the queue starts the
+// interval, the second leaves after the interval with the delay still above the target and is shed,
+// the last waiting request is never shed.
+void testSojournDrop() {
+    oscp::AdmissionPolicy policy;
+    policy.maxConcurrent = 1;
+    policy.targetDelayMs = 1;
+    policy.intervalMs = 10;
+    oscp::AdmissionController admission(policy);
+    oscp::AdmissionController::Slot running = admission.acquire(oscp::RequestBudget());
+
+    std::vector<std::thread> requests;
+    for (int i = 0; i < 3; ++i) {
+        requests.emplace_back([&admission]() {
+            const oscp::AdmissionController::Slot slot = admission.acquire(oscp::RequestBudget());
+            if (slot) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(30)); // longer than the interval
+            }
+        });
+    }
+    waitQueued(admission, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    running = oscp::AdmissionController::Slot();
+    for (std::thread& request : requests) {
+        request.join();
+    }
+
+    const oscp::AdmissionStats stats = admission.stats();
+    OSCP_CHECK(stats.admitted == 3);
+    OSCP_CHECK(stats.overloaded == 1);
+    OSCP_CHECK(stats.running == 0 && stats.queued == 0);
+}
+
+} // namespace
+
+int main() {
+    testParseTimeoutMs();
+    testBudgetExpiry();
+    testQueueTimeout();
+    testSojournDrop();
+    return oscp::tests::failures();
+}
@@ -0,0 +1,122 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/camera_intrinsics.h>
+#include <oscp-gpp/camera_models.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+using oscp::CameraModel;
+using oscp::CameraModelTraits;
+
+// A 640x480 camera with noticeable distortion, exactly paramCount parameters long
+template<CameraModel M, typename T>
+std::vector<T> makeParams() {
+    std::vector<T> params;
+    if constexpr (CameraModelTraits<M>::singleFocalLength) {
+        params = {T(500), T(320), T(240)};
+    } else {
+        params = {T(500), T(510), T(320), T(240)};
+    }
+    const T coefficients[] = {T(-0.1), T(0.02), T(0.002), T(-0.001), T(0.001), T(0.0005), T(0.0002), T(0.0001)};
+    for (size_t i = 0; params.size() < CameraModelTraits<M>::paramCount; i++) {
+        params.push_back(coefficients[i]);
+    }
+    if constexpr (M == CameraModel::FOV) {
+        params.back() = T(0.9); // omega
+    }
+    return params;
+}
+
+bool near(double a, double b, double tolerance) {
+    return std::abs(a - b) <= tolerance;
+}
+
+// project(unproject(pixel)) and unproject(project(point)) over the field of view, single and batch,
+// tolerance is that of the normalized coordinates
+template<CameraModel M, typename T>
+void testRoundTrip(double tolerance) {
+    const std::vector<T> params = makeParams<M, T>();
+    const T* p = params.data();
+    OSCP_CHECK(params.size() == oscp::cameraModelParamCount(M));
+
+    std::vector<T> X, Y, Z;
+    for (int i = -6; i <= 6; i++) {
+        for (int j = -4; j <= 4; j++) {
+            const T z = T(1) + T(i + 6);
+            X.push_back(T(0.1) * T(i) * z);
+            Y.push_back(T(0.1) * T(j) * z);
+            Z.push_back(z);
+        }
+    }
+    const size_t n = X.size();
+    std::vector<T> u(n), v(n), x(n), y(n), reprojectedU(n), reprojectedV(n), undistortedU(n), undistortedV(n);
+    oscp::projectPoints<M>(p, X.data(), Y.data(), Z.data(), u.data(), v.data(), n);
+    oscp::unprojectPoints<M>(p, u.data(), v.data(), x.data(), y.data(), n);
+    oscp::undistortPixels<M>(p, u.data(), v.data(), undistortedU.data(), undistortedV.data(), n);
+
+    T fx, fy, cx, cy;
+    oscp::pinholeParams<M>(p, fx, fy, cx, cy);
+    const double pixelTolerance = tolerance * 1000.0; // f = 500
+    size_t failures = 0;
+    for (size_t i = 0; i < n; i++) {
+        T singleU, singleV, singleX, singleY;
+        oscp::projectPoint<M>(p, X[i], Y[i], Z[i], singleU, singleV);
+        oscp::unprojectPoint<M>(p, u[i], v[i], singleX, singleY);
+        oscp::projectPoint<M>(p, x[i], y[i], T(1), reprojectedU[i], reprojectedV[i]);
+        // The batch unprojection multiplies by 1 / f where the single one divides by f
+        const bool ok = singleU == u[i] && singleV == v[i] && near(singleX, x[i], tolerance) && near(singleY, y[i], tolerance)
+            && near(x[i], X[i] / Z[i], tolerance) && near(y[i], Y[i] / Z[i], tolerance)
+            && near(reprojectedU[i], u[i], pixelTolerance) && near(reprojectedV[i], v[i], pixelTolerance)
+            && near(undistortedU[i], fx * X[i] / Z[i] + cx, pixelTolerance) && near(undistortedV[i], fy * Y[i] / Z[i] + cy, pixelTolerance);
+        failures += ok ? 0 : 1;
+    }
+    if (failures > 0) {
+        std::fprintf(stderr, "%s (%s): %zu of %zu points do not round-trip\n", std::string(toString(M)).c_str(),
+                     sizeof(T) == sizeof(float) ? "float" : "double", failures, n);
+    }
+    OSCP_CHECK(failures == 0);
+
+    // The principal point is the optical axis
+    T axisU, axisV;
+    oscp::projectPoint<M>(p, T(0), T(0), T(1), axisU, axisV);
+    OSCP_CHECK(axisU == cx && axisV == cy);
+}
+
+void testAllModels() {
+    for (size_t i = 0; i < static_cast<size_t>(CameraModel::UNKNOWN); i++) {
+        oscp::dispatchCameraModel(static_cast<CameraModel>(i), [](auto tag) {
+            testRoundTrip<decltype(tag)::value, double>(1e-12);
+            testRoundTrip<decltype(tag)::value, float>(1e-5);
+        });
+    }
+}
+
+void testParamLayouts() {
+    OSCP_CHECK(CameraModelTraits<CameraModel::SIMPLE_PINHOLE>::paramCount == 3);
+    OSCP_CHECK(!CameraModelTraits<CameraModel::PINHOLE>::hasDistortion);
+    OSCP_CHECK(CameraModelTraits<CameraModel::RADIAL>::singleFocalLength);
+    OSCP_CHECK(CameraModelTraits<CameraModel::THIN_PRISM_FISHEYE>::paramCount == 12);
+    OSCP_CHECK(oscp::cameraModelParamCount(CameraModel::FOV) == 5);
+    OSCP_CHECK(oscp::cameraModelParamCount(CameraModel::UNKNOWN) == 0);
+}
+
+} // namespace
+
+int main() {
+    testAllModels();
+    testParamLayouts();
+    return oscp::tests::failures();
+}
@@ -0,0 +1,110 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/content_negotiation.h>
+
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+using oscp::WireEncoding;
+
+// Two JSON versions, the newest preferred, and a binary one; the handler is the index
+oscp::ContentNegotiator<int> negotiator() {
+    oscp::ContentNegotiator<int> negotiator;
+    negotiator.add("application/vnd.oscp+json", {2, 0}, WireEncoding::JSON, 0);
+    negotiator.add("application/vnd.oscp+json", {1, 0}, WireEncoding::JSON, 1);
+    negotiator.add("application/vnd.oscp+cbor", {2, 0}, WireEncoding::BINARY, 2);
+    return negotiator;
+}
+
+// The handler of the selected response representation, -1 for 406 Not Acceptable
+int response(std::string_view accept) {
+    static const oscp::ContentNegotiator<int> instance = negotiator();
+    const oscp::ContentNegotiator<int>::Selection selection = instance.selectResponse(accept);
+    return selection ? *selection.handler : -1;
+}
+
+void testParseMediaType() {
+    oscp::MediaType mediaType;
+    OSCP_CHECK(oscp::parseMediaType("application/vnd.oscp+json; version=2.1; q=0.5; charset=utf-8", mediaType));
+    OSCP_CHECK(mediaType.type == "application" && mediaType.subtype == "vnd.oscp+json");
+    OSCP_CHECK(mediaType.versionMajor == 2 && mediaType.versionMinor == 1 && mediaType.quality == 500);
+    OSCP_CHECK(oscp::encodingOf(mediaType) == WireEncoding::JSON);
+
+    OSCP_CHECK(!oscp::parseMediaType("application", mediaType));
+    OSCP_CHECK(!oscp::parseMediaType("application/json;q=2", mediaType));
+    OSCP_CHECK(!oscp::parseMediaType("application/json;version=x", mediaType));
+
+    std::string_view list = R"(a/b;p="x,y", */* ,c/d)";
+    OSCP_CHECK(oscp::nextListElement(list) == R"(a/b;p="x,y")");
+    OSCP_CHECK(oscp::nextListElement(list) == "*/*");
+    OSCP_CHECK(oscp::nextListElement(list) == "c/d");
+    OSCP_CHECK(list.empty());
+}
+
+void testQualityValues() {
+    OSCP_CHECK(response("application/vnd.oscp+json;version=1.0;q=0.9, application/vnd.oscp+cbor") == 2);
+    OSCP_CHECK(response("application/vnd.oscp+json;version=1.0, application/vnd.oscp+json;version=2.0;q=0.5") == 1);
+    // On equal q values the more specific range wins, then the earlier registration
+    OSCP_CHECK(response("application/vnd.oscp+json, application/vnd.oscp+json;version=1") == 1);
+    OSCP_CHECK(response("application/vnd.oscp+json") == 0);
+    // q=0 excludes a representation that a wider range would accept
+    OSCP_CHECK(response("application/vnd.oscp+json;version=2.0;q=0, application/*") == 1);
+}
+
+void testWildcards() {
+    OSCP_CHECK(response("") == 0);
+    OSCP_CHECK(response("*/*") == 0);
+    OSCP_CHECK(response("application/*") == 0);
+    OSCP_CHECK(response("text/html, */*;q=0.1") == 0);
+    OSCP_CHECK(response("application/*;q=0.5, application/vnd.oscp+cbor") == 2);
+}
+
+void testNotAcceptable() {
+    OSCP_CHECK(response("text/html") == -1);
+    OSCP_CHECK(response("application/vnd.oscp+json;version=3.0") == -1);
+    OSCP_CHECK(response("*/*;q=0") == -1);
+    OSCP_CHECK(response("application/vnd.oscp+json;version=2.0;q=0, application/vnd.oscp+json;version=1.0;q=0, application/vnd.oscp+cbor;q=0") == -1);
+}
+
+void testRequestContentType() {
+    const oscp::ContentNegotiator<int> instance = negotiator();
+    auto request = [&](std::string_view contentType) {
+        const oscp::ContentNegotiator<int>::Selection selection = instance.selectRequest(contentType);
+        return selection ? *selection.handler : -1;
+    };
+    OSCP_CHECK(request("") == 0);
+    OSCP_CHECK(request("application/vnd.oscp+json; version=1.0") == 1);
+    OSCP_CHECK(request("application/json") == 0);
+    OSCP_CHECK(request("application/vnd.oscp+json; version=3.0") == -1);
+    OSCP_CHECK(request("text/plain") == -1);
+
+    oscp::ContentNegotiator<int> invalid;
+    bool threw = false;
+    try {
+        invalid.add("application/*", {1, 0}, WireEncoding::JSON, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    OSCP_CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    testParseMediaType();
+    testQualityValues();
+    testWildcards();
+    testNotAcceptable();
+    testRequestContentType();
+    return oscp::tests::failures();
+}
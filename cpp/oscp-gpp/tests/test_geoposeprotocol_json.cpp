@@ -0,0 +1,141 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/geoposeprotocol_json.h>
+
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using oscp::ParseErrorCode;
+
+// A minimal GeoPoseRequest with the given timestamp, sequenceNumber and latitude
+std::string requestText(const std::string& timestamp, const std::string& sequenceNumber, const std::string& latitude = "47.0") {
+    return R"({"type": "geopose", "id": "1", "timestamp": )" + timestamp + R"(,
+        "sensors": [{"type": "camera", "id": "camera"}, {"type": "geolocation", "id": "gps"}],
+        "sensorReadings": {
+            "cameraReadings": [{"timestamp": 0, "sensorId": "camera", "sequenceNumber": )" + sequenceNumber + R"(,
+                "imageFormat": "JPG", "size": [640, 480], "imageBytes": "",
+                "params": {"model": "PINHOLE", "modelParams": [500, 500, 320, 240]}}],
+            "geolocationReadings": [{"timestamp": 0, "sensorId": "gps", "latitude": )" + latitude + R"(, "longitude": 8.0,
+                "altitude": 0, "accuracy": 5, "altitudeAccuracy": 5, "heading": 0, "speed": 0}]}})";
+}
+
+oscp::ParseResult<oscp::GeoPoseRequest> parseRequest(const std::string& timestamp, const std::string& sequenceNumber,
+                                                     const std::string& latitude = "47.0") {
+    oscp::ParseResult<nlohmann::json> j = oscp::tryParseJson(requestText(timestamp, sequenceNumber, latitude));
+    if (!j) {
+        return j.error();
+    }
+    return oscp::tryParseGeoPoseRequest(*j, std::pmr::get_default_resource());
+}
+
+bool outOfRange(const oscp::ParseResult<oscp::GeoPoseRequest>& result, const std::string& path) {
+    return !result && result.error().code == ParseErrorCode::INVALID_VALUE && result.error().path == path;
+}
+
+void testNumberRanges() {
+    const std::string sequenceNumber = "/sensorReadings/cameraReadings/0/sequenceNumber";
+    oscp::ParseResult<oscp::GeoPoseRequest> valid = parseRequest("1700000000000", "18446744073709551615");
+    OSCP_CHECK(valid && valid->timestamp == 1700000000000 && valid->sensorReadings.cameraReadings[0].sequenceNumber == 18446744073709551615ULL);
+    OSCP_CHECK(outOfRange(parseRequest("1e300", "0"), "/timestamp"));
+    OSCP_CHECK(outOfRange(parseRequest("9223372036854775808", "0"), "/timestamp"));
+    OSCP_CHECK(outOfRange(parseRequest("0", "-1"), sequenceNumber));
+    OSCP_CHECK(outOfRange(parseRequest("0", "1e300"), sequenceNumber));
+    OSCP_CHECK(outOfRange(parseRequest("0", "18446744073709551616"), sequenceNumber));
+    OSCP_CHECK(outOfRange(parseRequest("0", "0", "1e300"), "/sensorReadings/geolocationReadings/0/latitude"));
+
+    // Floating-point numbers in integral fields are truncated
+    oscp::ParseResult<oscp::GeoPoseRequest> truncated = parseRequest("1.5e12", "3.7");
+    OSCP_CHECK(truncated && truncated->timestamp == 1500000000000 && truncated->sensorReadings.cameraReadings[0].sequenceNumber == 3);
+}
+
+void testInvalidJson() {
+    oscp::ParseResult<nlohmann::json> j = oscp::tryParseJson(R"({"id": [1, 2})");
+    OSCP_CHECK(!j && j.error().code == ParseErrorCode::INVALID_JSON && j.error().message.rfind("Byte 13:", 0) == 0);
+    OSCP_CHECK(!oscp::tryParseJson(""));
+    OSCP_CHECK(oscp::tryParseJson(R"({"id": [1, 2]})"));
+}
+
+// The UNKNOWN sentinel of the enums is written for unknown values but never read as a name
+void testUnknownEnumNames() {
+    auto throws = [](auto fromString) {
+        try {
+            fromString("UNKNOWN");
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    OSCP_CHECK(throws(oscp::sensorTypefromString));
+    OSCP_CHECK(throws(oscp::imageFormatFromString));
+    OSCP_CHECK(throws(oscp::cameraModelFromString));
+    oscp::CameraModel model = oscp::CameraModel::PINHOLE;
+    OSCP_CHECK(!oscp::tryParse("UNKNOWN", model) && model == oscp::CameraModel::PINHOLE);
+    OSCP_CHECK(oscp::tryParse("OPENCV", model) && model == oscp::CameraModel::OPENCV);
+    OSCP_CHECK(oscp::toString(oscp::ImageFormat::UNKNOWN) == "UNKNOWN");
+
+    auto parseWith = [](const std::string& pointer, const std::string& name) {
+        nlohmann::json j = nlohmann::json::parse(requestText("0", "0"));
+        j[nlohmann::json::json_pointer(pointer)] = name;
+        return oscp::tryParseGeoPoseRequest(j, std::pmr::get_default_resource());
+    };
+    for (const char* pointer : {"/sensorReadings/cameraReadings/0/imageFormat", "/sensorReadings/cameraReadings/0/params/model", "/sensors/0/type"}) {
+        oscp::ParseResult<oscp::GeoPoseRequest> result = parseWith(pointer, "UNKNOWN");
+        OSCP_CHECK(!result && result.error().code == ParseErrorCode::UNKNOWN_ENUM_VALUE && result.error().path == pointer);
+    }
+}
+
+// Readings that inherit the request-level privacy are written with it, servers without the default require it there
+void testInheritedPrivacyRoundTrip() {
+    const std::string privacy = R"({"dataRetention": ["oscp:retention:none"], "dataAcceptableUse": ["oscp:use:localization"],
+        "dataSanitizationApplied": [], "dataSanitizationRequested": []})";
+    const std::string ownPrivacy = R"({"dataRetention": [], "dataAcceptableUse": [], "dataSanitizationApplied": ["oscp:sanitization:faces"],
+        "dataSanitizationRequested": []})";
+    auto requestJson = [&](bool withDefault) {
+        return nlohmann::json::parse(R"({"type": "geopose", "id": "1", "timestamp": 0,)" + (withDefault ? R"("privacy": )" + privacy + "," : "") + R"(
+            "sensors": [{"type": "camera", "id": "camera"}, {"type": "geolocation", "id": "gps"}],
+            "sensorReadings": {
+                "cameraReadings": [{"timestamp": 0, "sensorId": "camera", "sequenceNumber": 0, "imageFormat": "JPG", "size": [640, 480],
+                    "imageBytes": "", "params": {"model": "PINHOLE", "modelParams": [500, 500, 320, 240]}}],
+                "geolocationReadings": [{"timestamp": 0, "sensorId": "gps", "privacy": )" + ownPrivacy + R"(, "latitude": 47.0,
+                    "longitude": 8.0, "altitude": 0, "accuracy": 5, "altitudeAccuracy": 5, "heading": 0, "speed": 0}]}})");
+    };
+
+    const oscp::GeoPoseRequest request = oscp::tryParseGeoPoseRequest(requestJson(true), std::pmr::get_default_resource()).value();
+    OSCP_CHECK(!request.sensorReadings.cameraReadings[0].privacy.has_value());
+    const nlohmann::json written = request;
+    OSCP_CHECK(written["sensorReadings"]["cameraReadings"][0]["privacy"] == nlohmann::json::parse(privacy));
+    OSCP_CHECK(written["sensorReadings"]["geolocationReadings"][0]["privacy"] == nlohmann::json::parse(ownPrivacy));
+
+    // The copy of the default is read as inheriting it again
+    const oscp::GeoPoseRequest reread = oscp::tryParseGeoPoseRequest(written, std::pmr::get_default_resource()).value();
+    OSCP_CHECK(!reread.sensorReadings.cameraReadings[0].privacy.has_value());
+    OSCP_CHECK(reread.sensorReadings.geolocationReadings[0].privacy.has_value());
+    OSCP_CHECK(oscp::effectivePrivacy(reread.sensorReadings.cameraReadings[0], reread) == oscp::effectivePrivacy(request.sensorReadings.cameraReadings[0], request));
+    OSCP_CHECK(oscp::effectivePrivacy(reread.sensorReadings.geolocationReadings[0], reread) == oscp::effectivePrivacy(request.sensorReadings.geolocationReadings[0], request));
+    OSCP_CHECK(nlohmann::json(reread) == written);
+
+    // Without a default, a reading without privacy is written with an empty one, as before the default existed
+    const oscp::GeoPoseRequest noDefault = oscp::tryParseGeoPoseRequest(requestJson(false), std::pmr::get_default_resource()).value();
+    OSCP_CHECK(nlohmann::json(noDefault)["sensorReadings"]["cameraReadings"][0]["privacy"] == nlohmann::json(oscp::Privacy()));
+}
+
+} // namespace
+
+int main() {
+    testNumberRanges();
+    testInvalidJson();
+    testUnknownEnumNames();
+    testInheritedPrivacyRoundTrip();
+    return oscp::tests::failures();
+}
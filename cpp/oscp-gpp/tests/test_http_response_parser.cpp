@@ -0,0 +1,110 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/http_response_parser.h>
+
+#include <string>
+#include <string_view>
+
+namespace {
+
+using oscp::HttpParseStatus;
+
+// Feeds the response byte by byte, every prefix but the whole response is INCOMPLETE
+HttpParseStatus parseBytewise(oscp::HttpResponseParser& parser, std::string_view response) {
+    HttpParseStatus status = HttpParseStatus::INCOMPLETE;
+    for (size_t i = 0; i < response.size() && status == HttpParseStatus::INCOMPLETE; i++) {
+        status = parser.append(&response[i], 1);
+    }
+    return status;
+}
+
+HttpParseStatus parse(oscp::HttpResponseParser& parser, std::string_view response) {
+    parser.reset(false);
+    return parser.append(response.data(), response.size());
+}
+
+void testContentLength() {
+    oscp::HttpResponseParser parser(1024);
+    parser.reset(false);
+    const std::string_view response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 5\r\n\r\nhello";
+    OSCP_CHECK(parseBytewise(parser, response.substr(0, response.size() - 1)) == HttpParseStatus::INCOMPLETE);
+    OSCP_CHECK(parser.append("o", 1) == HttpParseStatus::COMPLETE);
+    OSCP_CHECK(parser.response().httpStatus == 200 && parser.response().body == "hello");
+    OSCP_CHECK(parser.response().header("content-type") == "application/json");
+    OSCP_CHECK(parser.keepAlive());
+
+    OSCP_CHECK(parse(parser, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n") == HttpParseStatus::COMPLETE);
+    OSCP_CHECK(parser.response().httpStatus == 404 && parser.response().body.empty() && !parser.keepAlive());
+
+    // No body after a HEAD request or a 204, whatever the headers say
+    parser.reset(true);
+    const std::string_view head = "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\n";
+    OSCP_CHECK(parser.append(head.data(), head.size()) == HttpParseStatus::COMPLETE && parser.response().body.empty());
+    OSCP_CHECK(parse(parser, "HTTP/1.1 204 No Content\r\nContent-Length: 5\r\n\r\n") == HttpParseStatus::COMPLETE);
+
+    // Delimited by the end of the connection
+    OSCP_CHECK(parse(parser, "HTTP/1.0 200 OK\r\n\r\nuntil") == HttpParseStatus::INCOMPLETE);
+    OSCP_CHECK(parser.append(" close", 6) == HttpParseStatus::INCOMPLETE && !parser.keepAlive());
+    OSCP_CHECK(parser.close() == HttpParseStatus::COMPLETE && parser.response().body == "until close");
+
+    OSCP_CHECK(parse(parser, "HTTP/1.1 200 OK\r\nContent-Length: 1025\r\n\r\n") == HttpParseStatus::TOO_LARGE);
+}
+
+void testChunked() {
+    oscp::HttpResponseParser parser(1024);
+    parser.reset(false);
+    const std::string_view response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "5\r\nhello\r\n7;ext=1\r\n, world\r\nA\r\n0123456789\r\n0\r\nTrailer: x\r\n\r\n";
+    OSCP_CHECK(parseBytewise(parser, response) == HttpParseStatus::COMPLETE);
+    OSCP_CHECK(parser.response().body == "hello, world0123456789");
+    OSCP_CHECK(parser.keepAlive());
+
+    OSCP_CHECK(parse(parser, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n") == HttpParseStatus::COMPLETE);
+    OSCP_CHECK(parser.response().body.empty());
+
+    // The chunks add up beyond the limit
+    oscp::HttpResponseParser small(8);
+    OSCP_CHECK(parse(small, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n5\r\n") == HttpParseStatus::TOO_LARGE);
+}
+
+void testMalformed() {
+    oscp::HttpResponseParser parser(1024);
+    OSCP_CHECK(parse(parser, "SSH-2.0-OpenSSH_9.6\r\n\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, "HTTP/1.1 2x0 OK\r\n\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, "HTTP/1.1 100 Continue\r\n\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, "HTTP/1.1 200 OK\r\nno colon\r\n\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, "HTTP/1.1 200 OK\r\nContent-Length: 5x\r\n\r\nhello") == HttpParseStatus::INVALID);
+
+    // Chunk data without its CRLF, or longer than the chunk size
+    const std::string_view chunked = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+    OSCP_CHECK(parse(parser, std::string(chunked) + "5\r\nhelloXY0\r\n\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, std::string(chunked) + "3\r\nhello\r\n0\r\n\r\n") == HttpParseStatus::INVALID);
+    // Chunk sizes that are not hex digits
+    OSCP_CHECK(parse(parser, std::string(chunked) + "zz\r\nhello\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, std::string(chunked) + "-5\r\nhello\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, std::string(chunked) + "5g\r\nhello\r\n") == HttpParseStatus::INVALID);
+    OSCP_CHECK(parse(parser, std::string(chunked) + " 5\r\nhello\r\n") == HttpParseStatus::INVALID);
+
+    // Only a response delimited by the connection is complete when it closes
+    OSCP_CHECK(parse(parser, "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhel") == HttpParseStatus::INCOMPLETE);
+    OSCP_CHECK(parser.close() == HttpParseStatus::INVALID);
+    parser.reset(false);
+    OSCP_CHECK(!parser.receivedAny() && parser.close() == HttpParseStatus::INVALID);
+}
+
+} // namespace
+
+int main() {
+    testContentLength();
+    testChunked();
+    testMalformed();
+    return oscp::tests::failures();
+}
@@ -0,0 +1,105 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/imu_preintegration.h>
+
+#include <cmath>
+#include <ctime>
+
+namespace {
+
+using oscp::ImuReadingBlock;
+using oscp::ImuSamples;
+using oscp::Quaternion;
+using oscp::SensorReadings;
+
+bool near(const Quaternion& a, const Quaternion& b) {
+    const double tolerance = 1e-6;
+    return std::abs(a.x - b.x) < tolerance && std::abs(a.y - b.y) < tolerance
+        && std::abs(a.z - b.z) < tolerance && std::abs(a.w - b.w) < tolerance;
+}
+
+// Rotation by angle (radians) around the z axis
+Quaternion aroundZ(double angle) {
+    Quaternion q;
+    q.z = std::sin(angle / 2.0);
+    q.w = std::cos(angle / 2.0);
+    return q;
+}
+
+// rate (rad/s) around z, one sample every 10 ms in [begin, end)
+void appendConstantRate(ImuReadingBlock& block, std::time_t begin, std::time_t end, float rate = 1.0f) {
+    for (std::time_t t = begin; t < end; t += 10) {
+        block.push_back(t, 0.0f, 0.0f, rate);
+    }
+}
+
+void testConstantRate() {
+    ImuReadingBlock block;
+    appendConstantRate(block, 0, 1000);
+    const oscp::ImuPreintegration result = oscp::preintegrateImu(ImuSamples(block), ImuSamples(), 0, 1000);
+    OSCP_CHECK(std::abs(result.deltaTime - 1.0) < 1e-9);
+    OSCP_CHECK(near(result.deltaRotation, aroundZ(1.0)));
+
+    // Only the requested interval is integrated
+    OSCP_CHECK(near(oscp::preintegrateImu(ImuSamples(block), ImuSamples(), 250, 750).deltaRotation, aroundZ(0.5)));
+
+    SensorReadings readings;
+    readings.gyroscopeBlocks.push_back(block);
+    OSCP_CHECK(near(oscp::integrateGyroscope(readings, 0, 1000), aroundZ(1.0)));
+}
+
+void testEmptyInput() {
+    const oscp::ImuPreintegration result = oscp::preintegrateImu(ImuSamples(), ImuSamples(), 0, 1000);
+    OSCP_CHECK(result.deltaTime == 0.0);
+    OSCP_CHECK(near(result.deltaRotation, Quaternion()));
+
+    ImuReadingBlock block;
+    appendConstantRate(block, 0, 1000);
+    OSCP_CHECK(oscp::preintegrateImu(ImuSamples(block), ImuSamples(), 1000, 1000).deltaTime == 0.0);
+
+    SensorReadings readings;
+    OSCP_CHECK(near(oscp::integrateGyroscope(readings, 0, 1000), Quaternion()));
+    readings.gyroscopeBlocks.emplace_back();
+    OSCP_CHECK(near(oscp::integrateGyroscope(readings, 0, 1000), Quaternion()));
+}
+
+// A recording split into blocks is integrated as a whole, blocks of another gyroscope are left out
+void testBlockSplit() {
+    SensorReadings readings;
+    ImuReadingBlock& first = readings.gyroscopeBlocks.emplace_back();
+    first.sensorId = "gyro";
+    appendConstantRate(first, 0, 400);
+    ImuReadingBlock& other = readings.gyroscopeBlocks.emplace_back();
+    other.sensorId = "other-gyro";
+    other.push_back(0, 5.0f, 0.0f, 0.0f);
+    ImuReadingBlock& second = readings.gyroscopeBlocks.emplace_back();
+    second.sensorId = "gyro";
+    second.privacy.emplace();
+    appendConstantRate(second, 400, 1000, 2.0f);
+    OSCP_CHECK(near(oscp::integrateGyroscope(readings, 0, 1000), aroundZ(0.4 + 1.2)));
+    OSCP_CHECK(near(oscp::integrateGyroscope(readings, 200, 600), aroundZ(0.2 + 0.4)));
+    OSCP_CHECK(near(oscp::integrateGyroscope(readings, 0, 300), aroundZ(0.3)));
+
+    // The same as per-sample readings, split where the privacy changes
+    SensorReadings samples;
+    oscp::appendImuReadings(readings.gyroscopeBlocks[0], samples.gyroscopeReadings);
+    oscp::appendImuReadings(readings.gyroscopeBlocks[2], samples.gyroscopeReadings);
+    OSCP_CHECK(near(oscp::integrateGyroscope(samples, 0, 1000), aroundZ(0.4 + 1.2)));
+}
+
+} // namespace
+
+int main() {
+    testConstantRate();
+    testEmptyInput();
+    testBlockSplit();
+    return oscp::tests::failures();
+}
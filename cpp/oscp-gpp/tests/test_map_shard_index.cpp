@@ -0,0 +1,90 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/map_shard_index.h>
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using oscp::MapShard;
+using oscp::MapShardIndex;
+
+// The indices of all shards containing the location
+std::vector<size_t> find(const MapShardIndex& index, double lat, double lon) {
+    std::vector<size_t> results(index.shards().size());
+    results.resize(index.find(lat, lon, results.data(), results.size()));
+    return results;
+}
+
+void testAntimeridianEdges() {
+    const MapShardIndex index({
+        {"globe", {-10.0, -180.0, 10.0, 180.0}},
+        {"east-edge", {-10.0, 179.0, 10.0, 180.0}},
+        {"west-edge", {-10.0, -180.0, 10.0, -179.0}},
+        {"crossing", {-10.0, 179.5, 10.0, -179.5}},
+    }, 1.0);
+    OSCP_CHECK(find(index, 0.0, 50.0) == std::vector<size_t>({0}));
+    OSCP_CHECK(find(index, 0.0, 179.2) == std::vector<size_t>({0, 1}));
+    OSCP_CHECK(find(index, 0.0, 179.7) == std::vector<size_t>({0, 1, 3}));
+    OSCP_CHECK(find(index, 0.0, 180.0) == std::vector<size_t>({0, 1, 3}));
+    OSCP_CHECK(find(index, 0.0, -180.0) == std::vector<size_t>({0, 2, 3}));
+    OSCP_CHECK(find(index, 0.0, -179.7) == std::vector<size_t>({0, 2, 3}));
+    OSCP_CHECK(find(index, 0.0, -179.2) == std::vector<size_t>({0, 2}));
+    OSCP_CHECK(find(index, 20.0, 180.0).empty());
+}
+
+// The same at the default cell size, where the whole globe is a large shard that is not registered per cell
+void testLargeShards() {
+    const MapShardIndex index({
+        {"east-edge", {-10.0, 179.0, 10.0, 180.0}},
+        {"globe", {-90.0, -180.0, 90.0, 180.0}},
+        {"crossing", {-10.0, 170.0, 10.0, -170.0}},
+        {"city", {47.0, 8.0, 47.5, 8.5}},
+    });
+    OSCP_CHECK(find(index, 0.0, 50.0) == std::vector<size_t>({1}));
+    OSCP_CHECK(find(index, 0.0, 179.5) == std::vector<size_t>({0, 1, 2}));
+    OSCP_CHECK(find(index, 0.0, 180.0) == std::vector<size_t>({0, 1, 2}));
+    OSCP_CHECK(find(index, 0.0, -175.0) == std::vector<size_t>({1, 2}));
+    OSCP_CHECK(find(index, 47.2, 8.2) == std::vector<size_t>({1, 3}));
+    OSCP_CHECK(find(index, 90.0, 180.0) == std::vector<size_t>({1}));
+    OSCP_CHECK(find(index, -90.0, -180.0) == std::vector<size_t>({1}));
+
+    size_t first = 0;
+    OSCP_CHECK(index.find(0.0, 179.5, &first, 1) == 1 && first == 0);
+    OSCP_CHECK(index.findFirst(47.2, 8.2) == &index.shards()[1]);
+}
+
+void testInvalidInput() {
+    const MapShardIndex index({{"globe", {-90.0, -180.0, 90.0, 180.0}}}, 1.0);
+    OSCP_CHECK(find(index, 0.0, 180.1).empty());
+    OSCP_CHECK(find(index, 90.1, 0.0).empty());
+    OSCP_CHECK(find(index, std::numeric_limits<double>::quiet_NaN(), 0.0).empty());
+
+    bool threw = false;
+    try {
+        MapShardIndex({}, 1e-9);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    OSCP_CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    testAntimeridianEdges();
+    testLargeShards();
+    testInvalidInput();
+    return oscp::tests::failures();
+}
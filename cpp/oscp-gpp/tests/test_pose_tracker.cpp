@@ -0,0 +1,93 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/pose_tracker.h>
+
+#include <ctime>
+
+namespace {
+
+using oscp::GeoPoseRequest;
+using oscp::GeoPoseResponse;
+using oscp::PoseTracker;
+
+GeoPoseResponse pose(std::time_t timestamp, double lat) {
+    GeoPoseResponse response;
+    response.id = "prior";
+    response.timestamp = timestamp;
+    response.accuracy.position = 0.1f;
+    response.accuracy.orientation = 1.0f;
+    response.geopose.position.lat = lat;
+    response.geopose.position.lon = 8.0;
+    return response;
+}
+
+GeoPoseRequest request(std::time_t timestamp) {
+    GeoPoseRequest request;
+    request.id = "request";
+    request.timestamp = timestamp;
+    return request;
+}
+
+void testPropagatesServerPose() {
+    PoseTracker tracker;
+    tracker.accept("session", pose(1000, 47.0));
+    GeoPoseResponse response;
+    OSCP_CHECK(tracker.tryPropagate("session", request(1100), response));
+    OSCP_CHECK(response.id == "request");
+    OSCP_CHECK(response.timestamp == 1100);
+    OSCP_CHECK(response.geopose.position.lat == 47.0);
+    OSCP_CHECK(response.accuracy.position > 0.1f);
+    OSCP_CHECK(tracker.stats().hits == 1);
+
+    // Too old
+    OSCP_CHECK(!tracker.tryPropagate("session", request(5000), response));
+    OSCP_CHECK(tracker.stats().missesStalePrior == 1);
+}
+
+// A client cannot make the server answer with a pose of its choice
+void testForgedPriorIsIgnored() {
+    PoseTracker tracker;
+    GeoPoseRequest forged = request(1100);
+    forged.priorPoses.push_back(pose(1050, 10.0));
+    GeoPoseResponse response;
+    OSCP_CHECK(!tracker.tryPropagate("session", forged, response));
+    OSCP_CHECK(!tracker.tryPropagate("", forged, response));
+    OSCP_CHECK(tracker.stats().missesNoPrior == 2);
+
+    // Not even when it is newer than the pose of the session
+    tracker.accept("session", pose(1000, 47.0));
+    OSCP_CHECK(tracker.tryPropagate("session", forged, response));
+    OSCP_CHECK(response.geopose.position.lat == 47.0);
+}
+
+// The pose of a session is not propagated for another session or without a session
+void testForeignSessionIsIgnored() {
+    PoseTracker tracker;
+    tracker.accept("session-a", pose(1000, 47.0));
+    GeoPoseResponse response;
+    OSCP_CHECK(!tracker.tryPropagate("session-b", request(1100), response));
+    OSCP_CHECK(!tracker.tryPropagate("", request(1100), response));
+    OSCP_CHECK(tracker.stats().hits == 0);
+    OSCP_CHECK(tracker.stats().missesNoPrior == 2);
+
+    // Nothing is remembered without a session
+    tracker.accept("", pose(1000, 10.0));
+    OSCP_CHECK(!tracker.tryPropagate("", request(1100), response));
+}
+
+} // namespace
+
+int main() {
+    testPropagatesServerPose();
+    testForgedPriorIsIgnored();
+    testForeignSessionIsIgnored();
+    return oscp::tests::failures();
+}
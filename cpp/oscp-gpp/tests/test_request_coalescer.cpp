@@ -0,0 +1,116 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/request_coalescer.h>
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+using oscp::GeoPoseResponse;
+using oscp::RequestCoalescer;
+using oscp::RequestCoalescerPolicy;
+
+GeoPoseResponse response(const char* id) {
+    GeoPoseResponse response;
+    response.id = id;
+    response.timestamp = 1000;
+    return response;
+}
+
+// A duplicate arriving while the original is in flight waits for its result
+void testSameKeyJoins() {
+    RequestCoalescer coalescer;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    int calls = 0;
+    auto localize = [&]() {
+        calls++;
+        released.wait();
+        return response("original");
+    };
+
+    std::future<GeoPoseResponse> original = std::async(std::launch::async, [&]() { return coalescer.run("client/1", localize); });
+    while (coalescer.stats().inFlight == 0) {
+        std::this_thread::yield();
+    }
+    std::future<GeoPoseResponse> duplicate = std::async(std::launch::async, [&]() { return coalescer.run("client/1", localize); });
+    while (coalescer.stats().coalesced == 0) {
+        std::this_thread::yield();
+    }
+    release.set_value();
+    OSCP_CHECK(original.get().id == "original");
+    OSCP_CHECK(duplicate.get().id == "original");
+    OSCP_CHECK(calls == 1);
+
+    // A later duplicate is replayed
+    OSCP_CHECK(coalescer.run("client/1", localize).id == "original");
+    OSCP_CHECK(calls == 1);
+    OSCP_CHECK(coalescer.stats().executed == 1);
+    OSCP_CHECK(coalescer.stats().replayed == 1);
+    OSCP_CHECK(coalescer.stats().inFlight == 0);
+}
+
+void testDistinctKeys() {
+    RequestCoalescer coalescer;
+    OSCP_CHECK(coalescer.run("client-a/1", []() { return response("a"); }).id == "a");
+    OSCP_CHECK(coalescer.run("client-b/1", []() { return response("b"); }).id == "b");
+    OSCP_CHECK(coalescer.run("client-a/2", []() { return response("a2"); }).id == "a2");
+    OSCP_CHECK(coalescer.stats().executed == 3);
+    OSCP_CHECK(coalescer.stats().completed == 3);
+
+    // An empty key is never deduplicated
+    OSCP_CHECK(coalescer.run("", []() { return response("x"); }).id == "x");
+    OSCP_CHECK(coalescer.run("", []() { return response("y"); }).id == "y");
+    OSCP_CHECK(coalescer.stats().replayed == 0);
+
+    // Failures are not stored
+    bool threw = false;
+    try {
+        coalescer.run("client-a/3", []() -> GeoPoseResponse { throw std::runtime_error("failed"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    OSCP_CHECK(threw);
+    OSCP_CHECK(coalescer.run("client-a/3", []() { return response("retried"); }).id == "retried");
+    OSCP_CHECK(coalescer.stats().failed == 1);
+}
+
+void testExpiry() {
+    RequestCoalescerPolicy policy;
+    policy.completedTtlMs = 50;
+    policy.maxCompleted = 2;
+    RequestCoalescer coalescer(policy);
+    coalescer.run("client/1", []() { return response("first"); });
+    OSCP_CHECK(coalescer.run("client/1", []() { return response("second"); }).id == "first");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    OSCP_CHECK(coalescer.run("client/1", []() { return response("second"); }).id == "second");
+
+    // At most maxCompleted responses are kept, the oldest go first
+    coalescer.run("client/2", []() { return response("2"); });
+    coalescer.run("client/3", []() { return response("3"); });
+    OSCP_CHECK(coalescer.stats().completed == 2);
+    OSCP_CHECK(coalescer.run("client/1", []() { return response("third"); }).id == "third");
+    OSCP_CHECK(coalescer.run("client/3", []() { return response("not run"); }).id == "3");
+}
+
+} // namespace
+
+int main() {
+    testSameKeyJoins();
+    testDistinctKeys();
+    testExpiry();
+    return oscp::tests::failures();
+}
@@ -0,0 +1,115 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/response_cache.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+using oscp::GeoPoseRequest;
+using oscp::GeoPoseResponse;
+using oscp::ResponseCache;
+using oscp::ResponseCachePolicy;
+
+GeoPoseResponse response(const char* id) {
+    GeoPoseResponse response;
+    response.id = id;
+    response.timestamp = 1000;
+    return response;
+}
+
+GeoPoseRequest request(const char* id, const char* imageBytes, double latitude) {
+    GeoPoseRequest request;
+    request.id = id;
+    request.sensorReadings.cameraReadings.emplace_back().imageBytes = imageBytes;
+    request.sensorReadings.geolocationReadings.emplace_back().latitude = latitude;
+    return request;
+}
+
+void testKey() {
+    ResponseCache cache;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    // Retries with a new id and a geolocation in the same bucket share the key
+    OSCP_CHECK(cache.key(request("1", "frame", 47.00001), a));
+    OSCP_CHECK(cache.key(request("2", "frame", 47.00002), b));
+    OSCP_CHECK(a == b);
+    OSCP_CHECK(cache.key(request("1", "other frame", 47.00001), b));
+    OSCP_CHECK(a != b);
+    OSCP_CHECK(cache.key(request("1", "frame", 47.1), b));
+    OSCP_CHECK(a != b);
+
+    GeoPoseRequest withoutCamera = request("1", "frame", 47.0);
+    withoutCamera.sensorReadings.cameraReadings.clear();
+    OSCP_CHECK(!cache.key(withoutCamera, b));
+}
+
+void testTtl() {
+    ResponseCachePolicy policy;
+    policy.ttlMs = 50;
+    ResponseCache cache(policy);
+    cache.insert(1, response("first"));
+    GeoPoseResponse found;
+    OSCP_CHECK(cache.find(1, found));
+    OSCP_CHECK(found.id == "first");
+    OSCP_CHECK(!cache.find(2, found));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    OSCP_CHECK(!cache.find(1, found));
+    OSCP_CHECK(cache.stats().entries == 0); // dropped on lookup, not counted as an eviction
+    OSCP_CHECK(cache.stats().evictions == 0);
+    OSCP_CHECK(cache.stats().hits == 1);
+    OSCP_CHECK(cache.stats().misses == 2);
+
+    // Inserting again renews the entry
+    cache.insert(1, response("second"));
+    OSCP_CHECK(cache.find(1, found));
+    OSCP_CHECK(found.id == "second");
+}
+
+// The least recently used entry is evicted over maxEntries
+void testEviction() {
+    ResponseCachePolicy policy;
+    policy.maxEntries = 2;
+    policy.shardCount = 1;
+    ResponseCache cache(policy);
+    cache.insert(1, response("1"));
+    cache.insert(2, response("2"));
+    GeoPoseResponse found;
+    OSCP_CHECK(cache.find(1, found));
+    cache.insert(3, response("3"));
+    OSCP_CHECK(cache.stats().entries == 2);
+    OSCP_CHECK(cache.stats().evictions == 1);
+    OSCP_CHECK(cache.find(1, found));
+    OSCP_CHECK(!cache.find(2, found));
+    OSCP_CHECK(cache.find(3, found));
+
+    cache.clear();
+    OSCP_CHECK(cache.stats().entries == 0);
+    OSCP_CHECK(!cache.find(1, found));
+
+    // Nothing is cached without entries
+    policy.maxEntries = 0;
+    ResponseCache disabled(policy);
+    disabled.insert(1, response("1"));
+    OSCP_CHECK(!disabled.find(1, found));
+}
+
+} // namespace
+
+int main() {
+    testKey();
+    testTtl();
+    testEviction();
+    return oscp::tests::failures();
+}
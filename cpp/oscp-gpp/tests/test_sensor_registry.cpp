@@ -0,0 +1,119 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/sensor_registry.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace {
+
+using oscp::GeoPoseRequest;
+using oscp::GeoPoseSession;
+using oscp::SensorRegistry;
+using oscp::SensorRegistryPolicy;
+
+GeoPoseSession sensors(const char* cameraId) {
+    GeoPoseSession session;
+    oscp::Sensor& camera = session.sensors.emplace_back();
+    camera.type = oscp::SensorType::CAMERA;
+    camera.id = cameraId;
+    oscp::Sensor& geolocation = session.sensors.emplace_back();
+    geolocation.type = oscp::SensorType::GEOLOCATION;
+    geolocation.id = "gps";
+    oscp::SessionCamera& params = session.cameras.emplace_back();
+    params.sensorId = cameraId;
+    params.params.model = oscp::CameraModel::SIMPLE_PINHOLE;
+    params.params.modelParams = {500.0f, 320.0f, 240.0f};
+    return session;
+}
+
+void testRegisterAndLookup() {
+    SensorRegistry registry;
+    const std::string token = registry.add(sensors("camera"));
+    OSCP_CHECK(token.size() == 16);
+    // The token depends only on the content
+    OSCP_CHECK(registry.add(sensors("camera")) == token);
+    const std::string other = registry.add(sensors("other camera"));
+    OSCP_CHECK(!other.empty() && other != token);
+    OSCP_CHECK(registry.stats().added == 2);
+    OSCP_CHECK(registry.stats().entries == 2);
+
+    std::shared_ptr<const GeoPoseSession> found = registry.find(token);
+    OSCP_CHECK(found != nullptr && found->sensors.size() == 2 && found->sensors[0].id == "camera");
+    OSCP_CHECK(registry.find("0123456789abcdef") == nullptr);
+    OSCP_CHECK(registry.stats().hits == 1);
+    OSCP_CHECK(registry.stats().misses == 1);
+}
+
+void testResolve() {
+    SensorRegistry registry;
+    const std::string token = registry.add(sensors("camera"));
+
+    GeoPoseRequest request;
+    request.sensorsToken = token;
+    request.sensorReadings.cameraReadings.emplace_back().sensorId = "camera";
+    request.sensorReadings.geolocationReadings.emplace_back().sensorId = "gps";
+    OSCP_CHECK(!registry.tryResolve(request).has_value());
+    OSCP_CHECK(request.sensors.size() == 2);
+    OSCP_CHECK(request.sensorReadings.cameraReadings[0].params.model == oscp::CameraModel::SIMPLE_PINHOLE);
+    OSCP_CHECK(request.sensorReadings.cameraReadings[0].sensorHandle == 0);
+    OSCP_CHECK(request.sensorReadings.geolocationReadings[0].sensorHandle == 1);
+
+    // A reading of a sensor the set does not declare
+    GeoPoseRequest undeclared;
+    undeclared.sensorsToken = token;
+    undeclared.sensorReadings.cameraReadings.emplace_back().sensorId = "other camera";
+    std::optional<oscp::ParseError> error = registry.tryResolve(undeclared);
+    OSCP_CHECK(error.has_value() && error->code == oscp::ParseErrorCode::UNDECLARED_SENSOR);
+
+    GeoPoseRequest unknown;
+    unknown.sensorsToken = "0123456789abcdef";
+    error = registry.tryResolve(unknown);
+    OSCP_CHECK(error.has_value() && error->code == oscp::ParseErrorCode::UNKNOWN_SENSORS_TOKEN && error->path == "/sensorsToken");
+    bool threw = false;
+    try {
+        registry.resolve(unknown);
+    } catch (const oscp::UnknownSensorsTokenError&) {
+        threw = true;
+    }
+    OSCP_CHECK(threw);
+
+    // Requests without a token are left alone
+    GeoPoseRequest withoutToken;
+    OSCP_CHECK(!registry.tryResolve(withoutToken).has_value());
+    OSCP_CHECK(withoutToken.sensors.empty());
+}
+
+// The oldest sets are forgotten above maxEntries
+void testEviction() {
+    SensorRegistryPolicy policy;
+    policy.maxEntries = 1;
+    SensorRegistry registry(policy);
+    const std::string first = registry.add(sensors("camera"));
+    const std::string second = registry.add(sensors("other camera"));
+    OSCP_CHECK(registry.find(first) == nullptr);
+    OSCP_CHECK(registry.find(second) != nullptr);
+    OSCP_CHECK(registry.stats().evictions == 1);
+
+    policy.maxEntries = 0;
+    SensorRegistry disabled(policy);
+    OSCP_CHECK(disabled.add(sensors("camera")).empty());
+}
+
+} // namespace
+
+int main() {
+    testRegisterAndLookup();
+    testResolve();
+    testEviction();
+    return oscp::tests::failures();
+}
@@ -0,0 +1,41 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/session_registry.h>
+
+#include <memory>
+
+namespace {
+
+// A session refuses frames over maxFramesInFlight until one of them is done
+void testFramesInFlight() {
+    oscp::SessionRegistryPolicy policy;
+    policy.maxFramesInFlight = 2;
+    oscp::SessionRegistry registry(policy);
+    std::shared_ptr<oscp::LocalizationSession> session = registry.create(oscp::GeoPoseSession());
+    OSCP_CHECK(session != nullptr);
+    OSCP_CHECK(session->beginFrame());
+    OSCP_CHECK(session->beginFrame());
+    OSCP_CHECK(!session->beginFrame());
+    OSCP_CHECK(session->framesInFlight() == 2);
+    session->endFrame();
+    OSCP_CHECK(session->beginFrame());
+
+    // The cap is per session
+    std::shared_ptr<oscp::LocalizationSession> other = registry.create(oscp::GeoPoseSession());
+    OSCP_CHECK(other->beginFrame());
+}
+
+} // namespace
+
+int main() {
+    testFramesInFlight();
+    return oscp::tests::failures();
+}
@@ -0,0 +1,48 @@
+// Open AR Cloud GeoPoseProtocol C++ implementation
+// Created based on the protocol definition:
+// https://github.com/OpenArCloud/oscp-geopose-protocol
+
+// Licensed under the MIT License
+// SPDX-License-Identifier: MIT
+
+
+#include "test.h"
+
+#include <oscp-gpp/worker_pool.h>
+
+#include <atomic>
+#include <future>
+
+namespace {
+
+// With the only thread blocked, tasks queue up to the cap and the next one is refused
+void testQueueCap() {
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> done{0};
+    {
+        oscp::WorkerPool pool(1);
+        std::promise<void> started;
+        pool.submit([&]() {
+            started.set_value();
+            released.wait();
+            done++;
+        });
+        started.get_future().wait();
+        OSCP_CHECK(pool.trySubmit([&]() { done++; }, 2));
+        OSCP_CHECK(pool.trySubmit([&]() { done++; }, 2));
+        OSCP_CHECK(pool.queued() == 2);
+        OSCP_CHECK(!pool.trySubmit([&]() { done++; }, 2));
+        OSCP_CHECK(pool.queued() == 2);
+        release.set_value();
+    }
+    // The destructor runs the queued tasks
+    OSCP_CHECK(done == 3);
+}
+
+} // namespace
+
+int main() {
+    testQueueCap();
+    return oscp::tests::failures();
+}